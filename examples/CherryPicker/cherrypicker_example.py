@@ -19,8 +19,6 @@ AutomaticAthenaeum.
 import indigox as ix
 from pathlib import Path
 import time
-import fnmatch
-import os
 
 # You always need a forcefield
 ff = ix.GenerateGROMOS54A7()
@@ -44,28 +42,10 @@ def LoadAndSaveAthenaeums():
     # Need to set a larger than default limit as some of the amino acid molecules are large
     auto_ath.SetInt(settings.MoleculeSizeLimit, 60)
 
-    mol_path = "SourceMolecules"
-    mol_extn = "*.frag"
-
-    index = 1
-    mol_count = len(fnmatch.filter(os.listdir(mol_path), mol_extn))
-
+    # Read the molecules and fragment them, in parallel over all cores
     print("Loading molecules into Athenaeums...")
-
-    # Load all the molecules
-    for aa in Path(mol_path).glob(mol_extn):
-        print("\tLoading Amino acid #{} of {}".format(index, mol_count))
-        index += 1
-
-        mol, fragments = ix.LoadFragmentFile(aa, ff)
-        mol.SetName(aa.stem)
-
-        # add the fragments to the manual Athenaeum
-        for frag in fragments:
-            man_ath.AddFragment(frag)
-
-        # add the molecule to the automatic Athenaeum
-        auto_ath.AddAllFragments(mol)
+    count = ix.BuildAthenaeums("SourceMolecules", man_ath, auto_ath)
+    print("\tLoaded {} molecules".format(count))
 
     # Save the athenaeums
     ix.SaveAthenaeum(man_ath, manualAthPath)
@@ -1,5 +1,6 @@
 #include "../classes/athenaeum.hpp"
 #include "../classes/forcefield.hpp"
+#include "../io/athenaeum_snapshot.hpp"
 #include "../utils/enum_class_bitwise.hpp"
 #include "../utils/fwd_declares.hpp"
 
@@ -219,6 +220,14 @@ namespace indigox::algorithm {
       /*! When performing subgraph isomorphism testing, use the RI algorithm
          instead of the VF2 algorithm. The RI algorithm is more efficient. */
       UseRISubgraphMatching,
+      /*! Determine the automorphism group of the target molecule's CMG once,
+         and only match each \link Fragment fragment\endlink up to this
+         symmetry. The parameters found from each match are then applied to
+         every symmetry equivalent match, giving the same results as matching
+         all of them individually. If the group is trivial or larger than
+         \link Settings::SymmetryGroupLimit SymmetryGroupLimit\endlink,
+         normal matching is used. */
+      UseSymmetryReduction,
       /*! Before parameterising with CherryPicker, calculate electron positions
        * to determine formal charges and bond orders. */
       CalculateElectrons,
@@ -253,6 +262,10 @@ namespace indigox::algorithm {
        * 2 = FPT (Fixed Parameter Tractable)
        */
       ElectronMethod,
+      /*! The largest automorphism group of the target molecule which will be
+         enumerated when \link Settings::UseSymmetryReduction
+         UseSymmetryReduction\endlink is set. */
+      SymmetryGroupLimit,
       /*! Marks the end of the integer settings. As there is no external use for
          this value, it is not exposed to Python. */
       IntCount
@@ -306,12 +319,14 @@ namespace indigox::algorithm {
      EdgeBondOrder\endlink, \link Settings::EdgeDegree EdgeDegree\endlink, \link
      Settings::AllowDanglingBonds AllowDanglingBonds\endlink, \link
      Settings::AllowDanglingAngles AllowDanglingAngles\endlink, \link
-     Settings::AllowDanglingDihedrals AllowDanglingDihedrals\endlink, and \link
-     Settings::UseRISubgraphMatching UseRISubgraphMatching\endlink. All other
+     Settings::AllowDanglingDihedrals AllowDanglingDihedrals\endlink, \link
+     Settings::UseRISubgraphMatching UseRISubgraphMatching\endlink, and \link
+     Settings::UseSymmetryReduction UseSymmetryReduction\endlink. All other
      boolean values default to false. The default \link
-     Settings::MinimumFragmentSize MinimumFragmentSize\endlink is \f$4\f$ and
+     Settings::MinimumFragmentSize MinimumFragmentSize\endlink is \f$4\f$,
      the default \link Settings::MaximumFragmentSize MaximumFragmentSize\endlink
-     is \f$-1\f$.
+     is \f$-1\f$ and the default \link Settings::SymmetryGroupLimit
+     SymmetryGroupLimit\endlink is \f$5000\f$.
      */
     void DefaultSettings();
 
@@ -326,13 +341,26 @@ namespace indigox::algorithm {
      Adds an Athenaeum in a FIFO manner. No check is performed to see if \p
      library has previously been added, so multiple instances of the same
      Athenaeum is possible. Only check performed is that the Athenaeum's
-     forcefield matches the CherryPicker forcefield.
+     forcefield matches the CherryPicker forcefield. Once added, the Athenaeum
+     is only read from, so separate CherryPicker instances sharing it may
+     parameterise different molecules concurrently.
 
      \param library the Athenaeum to add.
      \returns if \p library was successfully added.
      */
     bool AddAthenaeum(Athenaeum &library);
 
+    /*! \brief Add an Athenaeum snapshot for parameterisation purposes.
+
+     Snapshots are used in turn with the Athenaeums, in the order added. Their
+     fragments are screened through the mapped snapshot, and a source molecule
+     is only loaded once one of its fragments may match.
+
+     \param library the snapshot to add.
+     \returns if \p library was successfully added.
+     */
+    bool AddAthenaeum(io::AthenaeumSnapshot &library);
+
     /*! \brief Remove an Athenaeum from the list.
 
      \param library the Athenaeum to remove.
@@ -340,6 +368,13 @@ namespace indigox::algorithm {
      */
     bool RemoveAthenaeum(Athenaeum &library);
 
+    /*! \brief Remove an Athenaeum snapshot from the list.
+
+     \param library the snapshot to remove.
+     \returns if \p library was successfully removed.
+     */
+    bool RemoveAthenaeum(io::AthenaeumSnapshot &library);
+
     /*! \brief The number of Athenaeums in the list.
 
      \returns the number of Athenaeums.
@@ -369,8 +404,14 @@ namespace indigox::algorithm {
     //! \endcond
 
   private:
+    //! \brief An Athenaeum, either loaded or mapped from a snapshot.
+    struct Library {
+      Athenaeum athenaeum;
+      io::AthenaeumSnapshot snapshot;
+    };
+
     Forcefield _ff;
-    std::list<Athenaeum> _libs;
+    std::list<Library> _libs;
     std::bitset<(uint8_t)Settings::BoolCount> bool_parameters;
     std::array<int32_t,
                (uint8_t)Settings::IntCount - (uint8_t)Settings::BoolCount - 1>
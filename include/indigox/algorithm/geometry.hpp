@@ -0,0 +1,69 @@
+/*! \file geometry.hpp */
+#ifndef INDIGOX_ALGORITHM_GEOMETRY_HPP
+#define INDIGOX_ALGORITHM_GEOMETRY_HPP
+
+#include "../utils/atomic_coordinates.hpp"
+#include "../utils/fwd_declares.hpp"
+
+#include <vector>
+
+namespace indigox::algorithm {
+
+  /*! \brief Measurements of all terms of one kind in a molecule.
+   *  \details Each vector is indexed the same as the terms of the molecule,
+   *  eg. Molecule::GetBonds(). Ideal values and energies come from the types
+   *  assigned to the terms, and are NaN for untyped terms or functional forms
+   *  which are not supported. */
+  struct TermGeometry {
+    //! \brief Measured values. Lengths in nm, angles in degrees.
+    std::vector<double> values;
+    //! \brief Ideal values of the assigned types, in the same units.
+    std::vector<double> ideals;
+    //! \brief Energies in kJ/mol from the assigned types.
+    std::vector<double> energies;
+  };
+
+  /*! \brief Measure all bond lengths of a molecule.
+   *  \details Harmonic bonds have energy \f$\frac{k}{2}(b - b_0)^2\f$ and
+   *  quartic bonds, following GROMOS, \f$\frac{k}{4}(b^2 - b_0^2)^2\f$.
+   *  \param mol the molecule to measure.
+   *  \return the bond measurements. */
+  TermGeometry MeasureBonds(Molecule &mol);
+
+  /*! \brief Measure all bond lengths of a molecule in given coordinates.
+   *  \details As MeasureBonds(Molecule&), but using the coordinates of
+   *  \p frame, such as a frame of a ConformerSet.
+   *  \throws std::runtime_error if the number of coordinates does not match
+   *  the number of atoms. */
+  TermGeometry MeasureBonds(Molecule &mol, const CoordinateFrame &frame);
+
+  /*! \brief Measure all angles of a molecule.
+   *  \details Angles are perceived if they have not been already. Harmonic
+   *  angles have energy \f$\frac{k}{2}(\theta - \theta_0)^2\f$, with angles
+   *  in radians, and cosine harmonic angles
+   *  \f$\frac{k}{2}(\cos\theta - \cos\theta_0)^2\f$.
+   *  \param mol the molecule to measure.
+   *  \return the angle measurements. */
+  TermGeometry MeasureAngles(Molecule &mol);
+
+  //! \brief Measure all angles of a molecule in given coordinates.
+  TermGeometry MeasureAngles(Molecule &mol, const CoordinateFrame &frame);
+
+  /*! \brief Measure all dihedrals of a molecule.
+   *  \details Dihedrals are perceived if they have not been already. Values
+   *  are signed torsion angles in the range (-180, 180]. Proper dihedrals
+   *  have energy \f$k(1 + \cos(m\phi - \phi_s))\f$ and the ideal value is the
+   *  phase shift. Improper dihedrals have energy
+   *  \f$\frac{k}{2}(\xi - \xi_0)^2\f$, with angles in degrees as in GROMOS.
+   *  Where a dihedral has multiple types, the energy is the sum over them and
+   *  the ideal value is that of the first.
+   *  \param mol the molecule to measure.
+   *  \return the dihedral measurements. */
+  TermGeometry MeasureDihedrals(Molecule &mol);
+
+  //! \brief Measure all dihedrals of a molecule in given coordinates.
+  TermGeometry MeasureDihedrals(Molecule &mol, const CoordinateFrame &frame);
+
+} // namespace indigox::algorithm
+
+#endif /* INDIGOX_ALGORITHM_GEOMETRY_HPP */
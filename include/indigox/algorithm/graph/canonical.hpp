@@ -0,0 +1,106 @@
+#ifndef INDIGOX_ALGORITHM_GRAPH_CANONICAL_HPP
+#define INDIGOX_ALGORITHM_GRAPH_CANONICAL_HPP
+
+#include "../../utils/fwd_declares.hpp"
+
+#include <EASTL/bitset.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace indigox::graph {
+  //! \brief type used to store the isomorphism testing mask for IXCMGVertex.
+  using VertexIsoMask = eastl::bitset<37, uint64_t>;
+  //! \brief type used to store the isomorphism testing mask for IXCMGEdge.
+  using EdgeIsoMask = eastl::bitset<14, uint16_t>;
+} // namespace indigox::graph
+
+namespace indigox::algorithm {
+
+  /*! \brief 128-bit hash of the canonical form of a labelled graph.
+   *  \details Two graphs labelled with the same masks have equal hashes if
+   *  they are isomorphic. The converse holds up to hash collisions, so the
+   *  hash is suitable for deduplication and caching keys. */
+  struct GraphHash {
+    uint64_t high = 0;
+    uint64_t low = 0;
+
+    bool operator==(const GraphHash &h) const {
+      return high == h.high && low == h.low;
+    }
+    bool operator!=(const GraphHash &h) const { return !(*this == h); }
+    bool operator<(const GraphHash &h) const {
+      return high < h.high || (high == h.high && low < h.low);
+    }
+  };
+
+  std::ostream &operator<<(std::ostream &os, const GraphHash &h);
+
+  /*! \brief Canonical labelling of a graph.
+   *  \details The vertex at position i of ordering is assigned canonical
+   *  label i. Isomorphic graphs have identical hashes and their orderings
+   *  give an isomorphism between them. */
+  template <class V> struct CanonicalLabelling {
+    std::vector<V> ordering;
+    GraphHash hash;
+  };
+
+  using CMGCanonicalForm = CanonicalLabelling<graph::CMGVertex>;
+  using MGCanonicalForm = CanonicalLabelling<graph::MGVertex>;
+
+  /*! \brief Determine the canonical form of a condensed molecular graph.
+   *  \details Vertices and edges are labelled by their isomorphism masks
+   *  after applying the given masks. A Weisfeiler-Lehman colour refinement is
+   *  used to obtain an equitable partition, which is then made discrete by
+   *  individualisation and refinement with automorphism pruning.
+   *  \param G the graph to label.
+   *  \param vmask mask applied to the vertex isomorphism masks.
+   *  \param emask mask applied to the edge isomorphism masks.
+   *  \return the canonical ordering and hash. */
+  CMGCanonicalForm CanonicalForm(graph::CondensedMolecularGraph &G,
+                                 graph::VertexIsoMask vmask,
+                                 graph::EdgeIsoMask emask);
+
+  //! \brief Canonical form of G using the full isomorphism masks.
+  CMGCanonicalForm CanonicalForm(graph::CondensedMolecularGraph &G);
+
+  /*! \brief Determine the canonical form of a molecular graph.
+   *  \details Vertices are labelled by element and formal charge, and edges
+   *  by bond order.
+   *  \param G the graph to label.
+   *  \return the canonical ordering and hash. */
+  MGCanonicalForm CanonicalForm(graph::MolecularGraph &G);
+
+  //! \brief Canonical hash of G under the given masks.
+  GraphHash CanonicalHash(graph::CondensedMolecularGraph &G,
+                          graph::VertexIsoMask vmask, graph::EdgeIsoMask emask);
+
+  //! \brief Canonical hash of G using the full isomorphism masks.
+  GraphHash CanonicalHash(graph::CondensedMolecularGraph &G);
+
+  //! \brief Canonical hash of G.
+  GraphHash CanonicalHash(graph::MolecularGraph &G);
+
+  //! \brief Permutation of the vertex indices of a graph.
+  using Permutation = std::vector<uint32_t>;
+
+  /*! \brief Enumerate the automorphism group of a condensed molecular graph.
+   *  \details Automorphisms preserve the masked vertex and edge isomorphism
+   *  masks. Each is given as a permutation of indices into G.GetVertices().
+   *  The group is enumerated as the closure of the generators found while
+   *  determining the canonical form.
+   *  \param G the graph to find the automorphisms of.
+   *  \param vmask mask applied to the vertex isomorphism masks.
+   *  \param emask mask applied to the edge isomorphism masks.
+   *  \param limit the maximum size of group to enumerate.
+   *  \return all automorphisms of G, including the identity, or an empty
+   *  vector if the group has more than \p limit elements. */
+  std::vector<Permutation> AutomorphismGroup(graph::CondensedMolecularGraph &G,
+                                             graph::VertexIsoMask vmask,
+                                             graph::EdgeIsoMask emask,
+                                             size_t limit);
+
+} // namespace indigox::algorithm
+
+#endif /* INDIGOX_ALGORITHM_GRAPH_CANONICAL_HPP */
@@ -1,4 +1,5 @@
 #include "../../utils/fwd_declares.hpp"
+#include "canonical.hpp"
 
 #include <EASTL/vector_map.h>
 #include <EASTL/bitset.h>
@@ -56,16 +57,56 @@ namespace indigox::algorithm {
 
   void SubgraphIsomorphisms(graph::MolecularGraph &G1,
                             graph::MolecularGraph &G2, MGCallback &callback);
+
+  /*! \brief Find subgraph isomorphisms up to the symmetry of the larger graph.
+   *  \details Finds induced subgraph isomorphisms of G1 in G2, with vertices
+   *  and edges matched on their masked isomorphism masks. Of each orbit of
+   *  isomorphisms under \p group, only the lexicographically smallest is
+   *  passed to the callback. All others are obtained by composing it with the
+   *  elements of \p group.
+   *  \param G1 the graph to find in G2.
+   *  \param G2 the graph to search.
+   *  \param vmask,emask masks applied to the isomorphism masks.
+   *  \param group automorphism group of G2, as from AutomorphismGroup(). An
+   *  empty group is treated as the trivial group.
+   *  \param callback called with each orbit representative. */
+  void SubgraphIsomorphisms(graph::CondensedMolecularGraph &G1,
+                            graph::CondensedMolecularGraph &G2,
+                            graph::VertexIsoMask vmask,
+                            graph::EdgeIsoMask emask,
+                            const std::vector<Permutation> &group,
+                            CMGCallback &callback);
   
+  /*! \brief Determine the largest common subgraphs of two graphs.
+   *  \details For each vertex of \p source_g, finds the largest connected
+   *  induced subgraph containing it which is also an induced subgraph of
+   *  \p target_g. Vertices and edges are matched on their full isomorphism
+   *  masks. Uses a McSplit style branch and bound search over label classes,
+   *  with the vertices of each class held as bitsets.
+   *  If the search is stopped by the budget, the results found so far are
+   *  still stored, but may not be maximal.
+   *  \param source_g the graph to find subgraphs of.
+   *  \param target_g the graph to match subgraphs onto.
+   *  \param smallest_size minimum size of common subgraph to report.
+   *  \param[out] per_vertex_largest_subgraphs for each vertex of source_g, the
+   *  largest common subgraph containing it as (source, target) vertex pairs.
+   *  \param node_limit maximum number of search nodes, or 0 for no limit.
+   *  \param time_limit maximum search time in seconds, or 0 for no limit.
+   *  \return 0 if the search completed, 1 if the budget was exhausted. */
   int LargestCommonSubgraph(graph::CondensedMolecularGraph& source_g,
                             graph::CondensedMolecularGraph& target_g,
                             size_t smallest_size,
-                            eastl::vector_map<graph::CMGVertex, eastl::vector<std::pair<graph::CMGVertex, graph::CMGVertex>>>& per_vertex_largest_subgraphs);
+                            eastl::vector_map<graph::CMGVertex, eastl::vector<std::pair<graph::CMGVertex, graph::CMGVertex>>>& per_vertex_largest_subgraphs,
+                            uint64_t node_limit = 0, double time_limit = 0.0);
   
+  /*! \brief Determine the largest common subgraphs of two graphs.
+   *  \details As for the condensed graph version, with vertices matched on
+   *  element and edges on bond order. */
   int LargestCommonSubgraph(graph::MolecularGraph& source_g,
                             graph::MolecularGraph& target_g,
                             size_t smallest_size,
-                            eastl::vector_map<graph::MGVertex, eastl::vector<std::pair<graph::MGVertex, graph::MGVertex>>>& per_vertex_largest_subgraphs);
+                            eastl::vector_map<graph::MGVertex, eastl::vector<std::pair<graph::MGVertex, graph::MGVertex>>>& per_vertex_largest_subgraphs,
+                            uint64_t node_limit = 0, double time_limit = 0.0);
   
   struct Uint64AttrComparator : public rilib::AttributeComparator {
     Uint64AttrComparator(){};
@@ -3,10 +3,13 @@
 #include <indigox/classes/periodictable.hpp>
 #include <indigox/classes/molecule.hpp>
 #include <indigox/utils/common.hpp>
-#include <indigox/utils/vec_avx.hpp>
+#include <indigox/utils/simd.hpp>
 #include <indigox/utils/triple.hpp>
 #include <indigox/utils/quad.hpp>
 
+#include <algorithm>
+#include <array>
+#include <stdexcept>
 #include <vector>
 
 #include <cmath>
@@ -24,6 +27,9 @@ namespace indigox::algorithm {
       IntCount,
       MinimumDistance,
       RadiusTolerance,
+      PeriodicBoxX,
+      PeriodicBoxY,
+      PeriodicBoxZ,
       RealCount
     };
     
@@ -43,61 +49,181 @@ namespace indigox::algorithm {
       DefaultSettings();
     }
     
+    /*! \brief Find bonds from interatomic distances.
+     *  \details Two atoms are bonded when their distance is less than the
+     *  sum of their covalent radii plus the RadiusTolerance setting. Atoms are
+     *  binned into a cell list with cells at least as large as the longest
+     *  possible bond, so only atoms in neighbouring cells are compared and
+     *  time and memory scale linearly with the number of atoms. If all of
+     *  PeriodicBoxX, PeriodicBoxY and PeriodicBoxZ are positive, the molecule
+     *  is treated as being in an orthorhombic periodic box of those lengths
+     *  and bonds are found using the minimum image convention.
+     *  \param mol the molecule to perceive bonds of.
+     *  \return the bonded atom pairs, ordered by atom index.
+     *  \throws std::runtime_error if two atoms are closer than the
+     *  MinimumDistance setting. */
     std::vector<bond_t> PerceiveBonds(Molecule& mol) {
-      std::vector<double> radii, distance_check, max_distance;
-      AtomicCoordinates& coords = mol.GetAtomicCoordinates();
-      int64_t sz = mol.NumAtoms();
-      radii.resize(sz + 4, 0.);
-      distance_check.resize(sz * sz + 4, 0.);
-      max_distance.resize(sz * sz + 4, 0.);
-      for (Atom atm : mol.GetAtoms()) radii[atm.GetIndex()] = atm.GetElement().GetCovalentRadius();
-      
-      // Calculate all distances between atoms and compare with radii sum + tolerance
-      Vec4d tol(GetReal(Settings::RadiusTolerance));
-      Vec4d zero = Vec4d::ZeroVector();
-      for (uint32_t i = 0, k = 0; i < mol.NumAtoms(); ++i) {
-        Vec4d xa(coords[i].x);
-        Vec4d ya(coords[i].y);
-        Vec4d za(coords[i].z);
-        Vec4d ra(radii[i]);
-        for (uint32_t j = 0; j < mol.NumAtoms(); j += 4) {
-          if (j + 3 < i) {
-            zero.save(&distance_check[k]);
-            zero.save(&max_distance[k]);
-          } else {
-            Vec4d x(&coords.x_vals()[j]);
-            Vec4d y(&coords.y_vals()[j]);
-            Vec4d z(&coords.z_vals()[j]);
-            Vec4d r(&radii[j]);
-            x -= xa;
-            y -= ya;
-            z -= za;
-            r += ra + tol;
-            x *= x;
-            r *= r;
-            x += y * y;
-            x += z * z;
-            x.save(&distance_check[k]);
-            r.save(&max_distance[k]);
-          }
-          k += (j + 4 < mol.NumAtoms()) ? 4 : mol.NumAtoms() - j;
+      return PerceiveBonds(mol, mol.GetAtomicCoordinates().Frame());
+    }
+
+    /*! \brief Find bonds from interatomic distances in given coordinates.
+     *  \details As for PerceiveBonds(Molecule&), but using the coordinates
+     *  of \p frame, such as a frame of a ConformerSet, in place of those of
+     *  the molecule.
+     *  \param mol the molecule to perceive bonds of.
+     *  \param frame coordinates of the atoms, in order of atom index.
+     *  \return the bonded atom pairs, ordered by atom index.
+     *  \throws std::runtime_error if the number of coordinates does not match
+     *  the number of atoms, or if two atoms are closer than the
+     *  MinimumDistance setting. */
+    std::vector<bond_t> PerceiveBonds(Molecule& mol,
+                                      const CoordinateFrame& frame) {
+      std::vector<bond_t> bonds;
+      uint32_t sz = uint32_t(mol.NumAtoms());
+      if (frame.size != sz)
+        throw std::runtime_error("Frame has wrong number of atoms");
+      if (!sz) return bonds;
+      const double* xs = frame.x;
+      const double* ys = frame.y;
+      const double* zs = frame.z;
+
+      std::vector<double> radii(sz, 0.);
+      double max_radius = 0.;
+      for (Atom atm : mol.GetAtoms()) {
+        radii[atm.GetIndex()] = atm.GetElement().GetCovalentRadius();
+        max_radius = std::max(max_radius, radii[atm.GetIndex()]);
+      }
+      double tolerance = GetReal(Settings::RadiusTolerance);
+      double cutoff = std::max(2. * max_radius + tolerance, 1e-3);
+
+      // Box lengths, zero when not periodic
+      std::array<double, 3> box = {GetReal(Settings::PeriodicBoxX),
+                                   GetReal(Settings::PeriodicBoxY),
+                                   GetReal(Settings::PeriodicBoxZ)};
+      bool periodic = box[0] > 0. && box[1] > 0. && box[2] > 0.;
+      if (!periodic) box.fill(0.);
+      if (periodic && 2. * cutoff > *std::min_element(box.begin(), box.end()))
+        throw std::runtime_error("Periodic box too small for bond cutoff");
+
+      // Extent of the region to bin
+      std::array<double, 3> lower = {0., 0., 0.}, extent = box;
+      if (!periodic) {
+        std::array<double, 3> upper;
+        lower = {xs[0], ys[0], zs[0]};
+        upper = lower;
+        for (uint32_t i = 1; i < sz; ++i) {
+          lower = {std::min(lower[0], xs[i]), std::min(lower[1], ys[i]),
+                   std::min(lower[2], zs[i])};
+          upper = {std::max(upper[0], xs[i]), std::max(upper[1], ys[i]),
+                   std::max(upper[2], zs[i])};
         }
+        for (size_t d = 0; d < 3; ++d) extent[d] = upper[d] - lower[d];
       }
-      
-      std::vector<bond_t> bonds;
+
+      // Cells are no smaller than the cutoff. Sparse systems get larger cells
+      // so the number of cells stays proportional to the number of atoms.
+      double cell_size = cutoff;
+      std::array<int64_t, 3> num_cells;
+      const double cell_limit = 2. * sz + 27.;
+      while (true) {
+        for (size_t d = 0; d < 3; ++d) {
+          num_cells[d] = int64_t(extent[d] / cell_size);
+          if (!periodic) ++num_cells[d];
+          num_cells[d] = std::max<int64_t>(num_cells[d], 1);
+        }
+        double total = double(num_cells[0]) * num_cells[1] * num_cells[2];
+        if (total <= cell_limit) break;
+        cell_size *= std::cbrt(total / cell_limit) * 1.01;
+      }
+      std::array<double, 3> cell_length;
+      for (size_t d = 0; d < 3; ++d)
+        cell_length[d] = periodic ? box[d] / num_cells[d] : cell_size;
+
+      auto cell_of = [&](uint32_t i) {
+        std::array<double, 3> pos = {xs[i] - lower[0], ys[i] - lower[1],
+                                     zs[i] - lower[2]};
+        int64_t idx = 0;
+        for (size_t d = 0; d < 3; ++d) {
+          if (periodic) pos[d] -= box[d] * std::floor(pos[d] / box[d]);
+          int64_t c = int64_t(pos[d] / cell_length[d]);
+          c = std::min(std::max<int64_t>(c, 0), num_cells[d] - 1);
+          idx = idx * num_cells[d] + c;
+        }
+        return idx;
+      };
+
+      // Counting sort atoms into cells, gathering the sorted coordinates so
+      // each cell is contiguous.
+      size_t total_cells = num_cells[0] * num_cells[1] * num_cells[2];
+      std::vector<uint32_t> atom_cell(sz), cell_start(total_cells + 1, 0);
+      for (uint32_t i = 0; i < sz; ++i) {
+        atom_cell[i] = uint32_t(cell_of(i));
+        ++cell_start[atom_cell[i] + 1];
+      }
+      for (size_t c = 0; c < total_cells; ++c)
+        cell_start[c + 1] += cell_start[c];
+      std::vector<uint32_t> cell_fill(cell_start.begin(), cell_start.end() - 1);
+      std::vector<uint32_t> sorted_idx(sz);
+      std::vector<double> px(sz), py(sz), pz(sz), pr(sz);
+      for (uint32_t i = 0; i < sz; ++i) {
+        uint32_t pos = cell_fill[atom_cell[i]]++;
+        sorted_idx[pos] = i;
+        px[pos] = xs[i];
+        py[pos] = ys[i];
+        pz[pos] = zs[i];
+        pr[pos] = radii[i];
+      }
+
+      // Neighbouring cell indices along one dimension, without duplicates
+      auto neighbours = [&](int64_t c, size_t d) {
+        std::vector<int64_t> n;
+        for (int64_t o = -1; o <= 1; ++o) {
+          int64_t v = c + o;
+          if (periodic) v = (v + num_cells[d]) % num_cells[d];
+          else if (v < 0 || v >= num_cells[d]) continue;
+          if (std::find(n.begin(), n.end(), v) == n.end()) n.push_back(v);
+        }
+        return n;
+      };
+
+      const double* box_ptr = periodic ? box.data() : nullptr;
       double min_dist = GetReal(Settings::MinimumDistance);
       min_dist *= min_dist;
-      // A bond is found if distance_check is negative
-      for (uint32_t i = 0; i < mol.NumAtoms(); ++i) {
-        for (uint32_t j = i + 1; j < mol.NumAtoms(); ++j) {
-          uint32_t k = i * mol.NumAtoms() + j;
-          if (distance_check[k] < max_distance[k])
-            bonds.emplace_back(mol.GetAtoms()[i], mol.GetAtoms()[j]);
-          if (distance_check[k] <= min_dist)
-            throw std::runtime_error("Atoms too close together");
+      std::vector<double> dist(sz), max_dist(sz);
+      std::vector<std::pair<uint32_t, uint32_t>> pairs;
+
+      for (uint32_t i = 0; i < sz; ++i) {
+        double pos[3] = {xs[i], ys[i], zs[i]};
+        int64_t ci = atom_cell[i];
+        int64_t cz = ci % num_cells[2];
+        int64_t cy = (ci / num_cells[2]) % num_cells[1];
+        int64_t cx = ci / (num_cells[2] * num_cells[1]);
+        for (int64_t nx : neighbours(cx, 0)) {
+          for (int64_t ny : neighbours(cy, 1)) {
+            for (int64_t nz : neighbours(cz, 2)) {
+              size_t c = (nx * num_cells[1] + ny) * num_cells[2] + nz;
+              uint32_t begin = cell_start[c], count = cell_start[c + 1] - begin;
+              // Compare distances with radii sum + tolerance
+              simd::DistanceCheck(&px[begin], &py[begin], &pz[begin],
+                                  &pr[begin], count, pos, radii[i] + tolerance,
+                                  box_ptr, dist.data(), max_dist.data());
+              for (uint32_t l = 0; l < count; ++l) {
+                uint32_t j = sorted_idx[begin + l];
+                if (j <= i) continue;
+                if (dist[l] <= min_dist)
+                  throw std::runtime_error("Atoms too close together");
+                if (dist[l] < max_dist[l]) pairs.emplace_back(i, j);
+              }
+            }
+          }
         }
       }
-      
+
+      std::sort(pairs.begin(), pairs.end());
+      bonds.reserve(pairs.size());
+      const Molecule::MoleculeAtoms& atoms = mol.GetAtoms();
+      for (auto& ij : pairs) bonds.emplace_back(atoms[ij.first], atoms[ij.second]);
+
       if (GetBool(Settings::CreateMissing)) {
         for (bond_t bnd : bonds) {
           if (!mol.HasBond(bnd.first, bnd.second)) mol.NewBond(bnd.first, bnd.second);
@@ -135,6 +135,18 @@ namespace indigox {
      *  \returns the number of fragments added. */
     size_t AddAllFragments(const Molecule &mol);
 
+    /*! \brief Determines all the fragments of many molecules and adds them.
+     *  \details Molecules are fragmented in parallel, each worker thread
+     *  using its own athenaeum with the same settings. Their fragments are
+     *  added once all workers have finished.
+     *  \param mols the molecules to fragment.
+     *  \param num_threads number of worker threads, or 0 for one per core.
+     *  \returns the number of fragments added.
+     *  \throws std::runtime_error as for AddAllFragments(const Molecule&),
+     *  after the fragments of other workers have been added. */
+    size_t AddAllFragments(const std::vector<Molecule> &mols,
+                           uint32_t num_threads = 0);
+
   private:
     void SortAndMask(const Molecule &mol);
 
@@ -13,6 +13,8 @@ namespace indigox {
   class Atom {
     //! \brief Friendship allows IXMolecule to create new atoms.
     friend class indigox::Molecule;
+    //! \brief Friendship allows ColumnarMolecule to restore residue data.
+    friend class indigox::ColumnarMolecule;
     //! \brief Friendship allows IXAtom to be serialised.
     friend class cereal::access;
 
@@ -0,0 +1,241 @@
+/*! \file columnar.hpp */
+#ifndef INDIGOX_CLASSES_COLUMNAR_HPP
+#define INDIGOX_CLASSES_COLUMNAR_HPP
+
+#include "../utils/atomic_coordinates.hpp"
+#include "../utils/fwd_declares.hpp"
+#include "bond.hpp"
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace indigox {
+  /*! \brief Molecule stored as parallel arrays.
+   *  \details Intended for large systems, such as solvated proteins, where a
+   *  Molecule with a separately allocated Atom and Bond for every atom and
+   *  bond has a large per atom overhead and poor locality. Per atom data is
+   *  held in one array per property, strings and parameter types are
+   *  interned, and bond connectivity is held in compressed sparse row form.
+   *  Angles, dihedrals and other perceived data are not stored. The columns
+   *  are exposed directly for whole molecule sweeps, while ColumnarAtom and
+   *  ColumnarBond provide per item access matching the Atom and Bond API.
+   *  Conversion to and from Molecule is provided for algorithms that require
+   *  the full representation. */
+  class ColumnarMolecule {
+    friend class ColumnarAtom;
+    friend class ColumnarBond;
+    //! \brief Friendship allows archives to fill columns directly.
+    friend class io::MoleculeArchive;
+
+  public:
+    //! \brief Index of an interned string or parameter type.
+    using PoolIndex = uint32_t;
+
+  public:
+    INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(ColumnarMolecule);
+
+    //! \brief Construct an empty molecule with the given name.
+    ColumnarMolecule(const std::string &name);
+
+    /*! \brief Construct from a Molecule.
+     *  \details Copies atoms, bonds, coordinates and assigned atom and bond
+     *  types. Atom and bond indices are preserved. */
+    explicit ColumnarMolecule(const Molecule &mol);
+
+    //! \brief Expand to a full Molecule.
+    Molecule ToMolecule() const;
+
+    bool operator==(const ColumnarMolecule &mol) const {
+      return m_data == mol.m_data;
+    }
+    bool operator!=(const ColumnarMolecule &mol) const {
+      return m_data != mol.m_data;
+    }
+    operator bool() const { return bool(m_data); }
+
+    const std::string &GetName() const;
+    void SetName(const std::string &name);
+    int32_t GetMolecularCharge() const;
+    void SetMolecularCharge(int32_t q);
+    const Forcefield &GetForcefield() const;
+    void SetForcefield(const Forcefield &ff);
+
+    int64_t NumAtoms() const;
+    int64_t NumBonds() const;
+
+    //! \brief Reserve space for a number of atoms.
+    void ReserveAtoms(int64_t num);
+    //! \brief Reserve space for a number of bonds.
+    void ReserveBonds(int64_t num);
+
+    //! \brief Add a new atom.
+    ColumnarAtom NewAtom(const Element &element, double x, double y, double z);
+    /*! \brief Add a bond between two atoms.
+     *  \details If the atoms are already bonded the existing bond is
+     *  returned. Invalid or identical atoms give an empty handle. */
+    ColumnarBond NewBond(const ColumnarAtom &a, const ColumnarAtom &b);
+
+    //! \brief Atom at index, empty if out of range.
+    ColumnarAtom GetAtom(uint32_t pos) const;
+    //! \brief Bond at index, empty if out of range.
+    ColumnarBond GetBond(uint32_t pos) const;
+    //! \brief Bond between two atoms, empty if not bonded.
+    ColumnarBond GetBond(const ColumnarAtom &a, const ColumnarAtom &b) const;
+
+    // Atom columns, all indexed by atom index
+    const std::vector<uint8_t> &GetAtomicNumbers() const;
+    const std::vector<int8_t> &GetFormalCharges() const;
+    const std::vector<double> &GetPartialCharges() const;
+    const std::vector<int32_t> &GetResidueIDs() const;
+    const std::vector<int32_t> &GetChargeGroupIDs() const;
+    const std::vector<PoolIndex> &GetNameIndices() const;
+    const std::vector<PoolIndex> &GetResidueNameIndices() const;
+    const std::vector<PoolIndex> &GetAtomTypeIndices() const;
+    AtomicCoordinates &GetAtomicCoordinates();
+
+    // Bond columns, all indexed by bond index
+    const std::vector<std::array<uint32_t, 2>> &GetBondAtoms() const;
+    const std::vector<BondOrder> &GetBondOrders() const;
+    const std::vector<PoolIndex> &GetBondTypeIndices() const;
+
+    //! \brief Interned atom and residue names.
+    const std::vector<std::string> &GetStringPool() const;
+    //! \brief Interned atom types. Index 0 is the empty type.
+    const std::vector<FFAtom> &GetAtomTypePool() const;
+    //! \brief Interned bond types. Index 0 is the empty type.
+    const std::vector<FFBond> &GetBondTypePool() const;
+
+    /*! \brief Offsets into the adjacency arrays.
+     *  \details The neighbours of atom i are at positions
+     *  [offsets[i], offsets[i + 1]) of GetAdjacentAtoms() and
+     *  GetAdjacentBonds(). The arrays are rebuilt on access after bonds have
+     *  been added. Concurrent const access from many threads is safe, but
+     *  adding atoms or bonds requires exclusive access. */
+    const std::vector<uint32_t> &GetAdjacencyOffsets() const;
+    const std::vector<uint32_t> &GetAdjacentAtoms() const;
+    const std::vector<uint32_t> &GetAdjacentBonds() const;
+
+    /*! \brief Approximate heap memory used by the molecule data.
+     *  \return the number of bytes. */
+    size_t MemoryUsage() const;
+
+  private:
+    struct Impl;
+    std::shared_ptr<Impl> m_data;
+  };
+
+  /*! \brief Index based handle to an atom of a ColumnarMolecule.
+   *  \details Handles are a pointer to the molecule data and an index, so
+   *  are cheap to create and copy. They mirror the data access API of Atom.
+   *  A handle is only valid while the molecule it was obtained from is alive.
+   */
+  class ColumnarAtom {
+    friend class ColumnarMolecule;
+    friend class ColumnarBond;
+
+  public:
+    ColumnarAtom() = default;
+
+  private:
+    ColumnarAtom(ColumnarMolecule::Impl *data, uint32_t idx)
+        : m_data(data), m_idx(idx) {}
+
+  public:
+    bool operator==(const ColumnarAtom &atm) const {
+      return m_data == atm.m_data && m_idx == atm.m_idx;
+    }
+    bool operator!=(const ColumnarAtom &atm) const { return !(*this == atm); }
+    bool operator<(const ColumnarAtom &atm) const {
+      return m_data < atm.m_data || (m_data == atm.m_data && m_idx < atm.m_idx);
+    }
+    operator bool() const { return m_data != nullptr; }
+
+    //! \brief Index of the atom in its molecule.
+    uint32_t GetIndex() const { return m_idx; }
+
+    //! \brief Number of bonds this atom is part of.
+    int64_t NumBonds() const;
+    bool HasType() const;
+    Element GetElement() const;
+    int32_t GetFormalCharge() const;
+    double GetPartialCharge() const;
+    int32_t GetResidueID() const;
+    const std::string &GetResidueName() const;
+    int32_t GetChargeGroupID() const;
+    const std::string &GetName() const;
+    double GetX() const;
+    double GetY() const;
+    double GetZ() const;
+    Coordinates GetPosition() const;
+    //! \brief Atom type, empty if not assigned.
+    const FFAtom &GetType() const;
+
+    //! \brief Atoms bonded to this atom.
+    std::vector<ColumnarAtom> GetNeighbours() const;
+    //! \brief Bonds this atom is part of.
+    std::vector<ColumnarBond> GetBonds() const;
+
+    void SetElement(const Element &e);
+    /*! \brief Set the formal charge of this atom.
+     *  \throws std::runtime_error if the charge is outside the range
+     *  storable by the columnar layout, [-128, 127]. */
+    void SetFormalCharge(int32_t q);
+    void SetPartialCharge(double q);
+    void SetResidueID(int32_t id);
+    void SetResidueName(const std::string &name);
+    void SetChargeGroupID(int32_t id);
+    void SetName(const std::string &name);
+    void SetPosition(double x, double y, double z);
+    void SetType(const FFAtom &type);
+
+  private:
+    ColumnarMolecule::Impl *m_data = nullptr;
+    uint32_t m_idx = 0;
+  };
+
+  //! \brief Index based handle to a bond of a ColumnarMolecule.
+  class ColumnarBond {
+    friend class ColumnarMolecule;
+    friend class ColumnarAtom;
+
+  public:
+    ColumnarBond() = default;
+
+  private:
+    ColumnarBond(ColumnarMolecule::Impl *data, uint32_t idx)
+        : m_data(data), m_idx(idx) {}
+
+  public:
+    bool operator==(const ColumnarBond &bnd) const {
+      return m_data == bnd.m_data && m_idx == bnd.m_idx;
+    }
+    bool operator!=(const ColumnarBond &bnd) const { return !(*this == bnd); }
+    bool operator<(const ColumnarBond &bnd) const {
+      return m_data < bnd.m_data || (m_data == bnd.m_data && m_idx < bnd.m_idx);
+    }
+    operator bool() const { return m_data != nullptr; }
+
+    //! \brief Index of the bond in its molecule.
+    uint32_t GetIndex() const { return m_idx; }
+
+    std::array<ColumnarAtom, 2> GetAtoms() const;
+    BondOrder GetOrder() const;
+    bool HasType() const;
+    //! \brief Bond type, empty if not assigned.
+    const FFBond &GetType() const;
+    //! \brief Distance between the two atoms of the bond.
+    double Length() const;
+
+    void SetOrder(BondOrder order);
+    void SetType(const FFBond &type);
+
+  private:
+    ColumnarMolecule::Impl *m_data = nullptr;
+    uint32_t m_idx = 0;
+  };
+
+} // namespace indigox
+
+#endif /* INDIGOX_CLASSES_COLUMNAR_HPP */
@@ -0,0 +1,173 @@
+#ifndef INDIGOX_CLASSES_COLUMNAR_IMPL_HPP
+#define INDIGOX_CLASSES_COLUMNAR_IMPL_HPP
+
+#include "../utils/atomic_coordinates.hpp"
+#include "../utils/fwd_declares.hpp"
+#include "bond.hpp"
+#include "columnar.hpp"
+#include "forcefield.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace indigox {
+
+  // =======================================================================
+  // == COLUMNAR MOLECULE IMPLEMENTATION ===================================
+  // =======================================================================
+
+  struct ColumnarMolecule::Impl {
+    std::string name;
+    int32_t molecular_charge;
+    Forcefield forcefield;
+
+    // Atom columns
+    std::vector<uint8_t> atomic_numbers;
+    std::vector<int8_t> formal_charges;
+    std::vector<double> partial_charges;
+    std::vector<int32_t> residue_ids;
+    std::vector<int32_t> charge_group_ids;
+    std::vector<PoolIndex> names;
+    std::vector<PoolIndex> residue_names;
+    std::vector<PoolIndex> atom_types;
+    AtomicCoordinates coordinates;
+
+    // Bond columns
+    std::vector<std::array<uint32_t, 2>> bond_atoms;
+    std::vector<BondOrder> bond_orders;
+    std::vector<PoolIndex> bond_types;
+
+    // Interning pools
+    std::vector<std::string> strings;
+    std::unordered_map<std::string, PoolIndex> string_lookup;
+    std::vector<FFAtom> atom_type_pool;
+    std::unordered_map<int32_t, PoolIndex> atom_type_lookup;
+    std::vector<FFBond> bond_type_pool;
+    std::unordered_map<int64_t, PoolIndex> bond_type_lookup;
+
+    // Bond lookup keyed on the sorted atom index pair. The first
+    // bond_lookup_sorted entries are sorted by key and the rest are recent
+    // additions, which are merged in once there are enough of them.
+    std::vector<std::pair<uint64_t, uint32_t>> bond_lookup;
+    size_t bond_lookup_sorted;
+
+    // CSR adjacency, rebuilt after bonds are added. Const accessors build it
+    // on first use, so building is guarded for concurrent readers.
+    std::vector<uint32_t> adjacency_offsets;
+    std::vector<uint32_t> adjacent_atoms;
+    std::vector<uint32_t> adjacent_bonds;
+    std::atomic<bool> adjacency_valid;
+    std::mutex adjacency_mutex;
+
+    Impl(std::string n)
+        : name(n), molecular_charge(0), atom_type_pool(1), bond_type_pool(1),
+          bond_lookup_sorted(0), adjacency_valid(false) {
+      Intern(std::string());
+    }
+
+    static uint64_t BondKey(uint32_t a, uint32_t b) {
+      if (a > b) std::swap(a, b);
+      return (uint64_t(a) << 32) | b;
+    }
+
+    // Index of the bond with the given key, or -1 if there is none
+    int64_t FindBond(uint64_t key) const {
+      auto end = bond_lookup.begin() + bond_lookup_sorted;
+      auto found = std::lower_bound(
+          bond_lookup.begin(), end, key,
+          [](const std::pair<uint64_t, uint32_t> &e, uint64_t k) {
+            return e.first < k;
+          });
+      if (found != end && found->first == key) return found->second;
+      for (auto it = end; it != bond_lookup.end(); ++it)
+        if (it->first == key) return it->second;
+      return -1;
+    }
+
+    void AddBondKey(uint64_t key, uint32_t idx) {
+      bond_lookup.emplace_back(key, idx);
+      if (bond_lookup.size() - bond_lookup_sorted < 32) return;
+      auto mid = bond_lookup.begin() + bond_lookup_sorted;
+      std::sort(mid, bond_lookup.end());
+      std::inplace_merge(bond_lookup.begin(), mid, bond_lookup.end());
+      bond_lookup_sorted = bond_lookup.size();
+    }
+
+    PoolIndex Intern(const std::string &s) {
+      auto found = string_lookup.find(s);
+      if (found != string_lookup.end()) return found->second;
+      PoolIndex idx = static_cast<PoolIndex>(strings.size());
+      strings.emplace_back(s);
+      string_lookup.emplace(s, idx);
+      return idx;
+    }
+
+    PoolIndex Intern(const FFAtom &type) {
+      if (!type) return 0;
+      auto found = atom_type_lookup.find(type.GetID());
+      if (found != atom_type_lookup.end()) return found->second;
+      PoolIndex idx = static_cast<PoolIndex>(atom_type_pool.size());
+      atom_type_pool.emplace_back(type);
+      atom_type_lookup.emplace(type.GetID(), idx);
+      return idx;
+    }
+
+    PoolIndex Intern(const FFBond &type) {
+      if (!type) return 0;
+      int64_t key = (int64_t(type.GetType()) << 32) | uint32_t(type.GetID());
+      auto found = bond_type_lookup.find(key);
+      if (found != bond_type_lookup.end()) return found->second;
+      PoolIndex idx = static_cast<PoolIndex>(bond_type_pool.size());
+      bond_type_pool.emplace_back(type);
+      bond_type_lookup.emplace(key, idx);
+      return idx;
+    }
+
+    uint32_t AddAtom(int32_t element, double x, double y, double z) {
+      atomic_numbers.push_back(static_cast<uint8_t>(element));
+      formal_charges.push_back(0);
+      partial_charges.push_back(0.0);
+      residue_ids.push_back(0);
+      charge_group_ids.push_back(-1);
+      names.push_back(0);
+      residue_names.push_back(0);
+      atom_types.push_back(0);
+      adjacency_valid = false;
+      return coordinates.Append(x, y, z);
+    }
+
+    void BuildAdjacency() {
+      if (adjacency_valid.load(std::memory_order_acquire)) return;
+      std::lock_guard<std::mutex> lock(adjacency_mutex);
+      if (adjacency_valid.load(std::memory_order_relaxed)) return;
+      size_t n = atomic_numbers.size();
+      adjacency_offsets.assign(n + 1, 0);
+      for (auto &atms : bond_atoms) {
+        ++adjacency_offsets[atms[0] + 1];
+        ++adjacency_offsets[atms[1] + 1];
+      }
+      for (size_t i = 0; i < n; ++i)
+        adjacency_offsets[i + 1] += adjacency_offsets[i];
+      adjacent_atoms.resize(adjacency_offsets.back());
+      adjacent_bonds.resize(adjacency_offsets.back());
+      std::vector<uint32_t> fill(adjacency_offsets.begin(),
+                                 adjacency_offsets.end() - 1);
+      for (uint32_t b = 0; b < bond_atoms.size(); ++b) {
+        uint32_t u = bond_atoms[b][0], v = bond_atoms[b][1];
+        adjacent_atoms[fill[u]] = v;
+        adjacent_bonds[fill[u]++] = b;
+        adjacent_atoms[fill[v]] = u;
+        adjacent_bonds[fill[v]++] = b;
+      }
+      adjacency_valid.store(true, std::memory_order_release);
+    }
+  };
+
+} // namespace indigox
+
+#endif /* INDIGOX_CLASSES_COLUMNAR_IMPL_HPP */
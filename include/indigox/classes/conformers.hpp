@@ -0,0 +1,102 @@
+/*! \file conformers.hpp */
+#ifndef INDIGOX_CLASSES_CONFORMERS_HPP
+#define INDIGOX_CLASSES_CONFORMERS_HPP
+
+#include "../utils/atomic_coordinates.hpp"
+#include "../utils/fwd_declares.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace indigox {
+  /*! \brief Multiple sets of coordinates for the atoms of one molecule.
+   *  \details Frames are held in a single block with a [frame][axis][atom]
+   *  layout. Each axis is padded to a multiple of 8 atoms, so every axis of
+   *  every frame starts on a 64 byte boundary. Frames are accessed through
+   *  CoordinateFrame views, which algorithms such as bond perception and
+   *  geometry measurement accept directly, so iterating conformers requires
+   *  no copies.
+   *
+   *  A set can be saved to a file and opened again with the frames mapped
+   *  rather than loaded, so trajectories larger than memory can be iterated.
+   *  A mapped set is read only. The file holds a 64 byte header followed by
+   *  the frames exactly as laid out in memory, in native byte order. */
+  class ConformerSet {
+  public:
+    INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(ConformerSet);
+
+    //! \brief Construct an empty set for molecules of \p num_atoms atoms.
+    explicit ConformerSet(uint32_t num_atoms);
+
+    /*! \brief Open a saved set, mapping its frames.
+     *  \param path the file to open.
+     *  \return the read only set.
+     *  \throws std::runtime_error if the file is not a valid conformer file
+     *  of this platform. */
+    static ConformerSet Open(const std::string &path);
+
+    /*! \brief Save all frames to a file.
+     *  \param path the file to write. */
+    void Save(const std::string &path) const;
+
+    bool operator==(const ConformerSet &set) const {
+      return m_data == set.m_data;
+    }
+    bool operator!=(const ConformerSet &set) const {
+      return m_data != set.m_data;
+    }
+    operator bool() const { return bool(m_data); }
+
+    uint32_t NumAtoms() const;
+    uint32_t NumFrames() const;
+
+    //! \brief Number of doubles between the starts of consecutive axes.
+    uint32_t GetStride() const;
+
+    //! \brief If the frames are mapped from a file, and so read only.
+    bool IsMapped() const;
+
+    //! \brief Reserve space for at least \p count frames.
+    void Reserve(uint32_t count);
+
+    /*! \brief Append a frame.
+     *  \param frame coordinates of the atoms.
+     *  \return the index of the new frame.
+     *  \throws std::runtime_error if the set is mapped or the frame has the
+     *  wrong number of atoms. */
+    uint32_t AddFrame(const CoordinateFrame &frame);
+
+    /*! \brief Append the current coordinates of a molecule.
+     *  \details Coordinates are taken in order of atom index. */
+    uint32_t AddFrame(Molecule &mol);
+
+    /*! \brief Overwrite an existing frame.
+     *  \throws std::runtime_error if the set is mapped, the index is out of
+     *  range or the frame has the wrong number of atoms. */
+    void SetFrame(uint32_t index, const CoordinateFrame &frame);
+
+    /*! \brief View of a frame.
+     *  \details Remains valid until the set is destroyed or more frames are
+     *  added, or while the owner from GetFrameStorage() is held.
+     *  \throws std::out_of_range if the index is out of range. */
+    CoordinateFrame GetFrame(uint32_t index) const;
+
+    /*! \brief Owner of the memory the frames are held in.
+     *  \details Holding it keeps views of the current frames readable after
+     *  the set is destroyed or more frames are added, though they then no
+     *  longer reflect changes to the set. */
+    std::shared_ptr<const void> GetFrameStorage() const;
+
+    /*! \brief Copy a frame into the coordinates of a molecule.
+     *  \throws std::runtime_error if the number of atoms does not match. */
+    void ApplyFrame(uint32_t index, Molecule &mol) const;
+
+  private:
+    struct Impl;
+    std::shared_ptr<Impl> m_data;
+  };
+
+} // namespace indigox
+
+#endif /* INDIGOX_CLASSES_CONFORMERS_HPP */
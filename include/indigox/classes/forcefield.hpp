@@ -47,6 +47,10 @@ namespace indigox {
      *  \return the name of this atom type. */
     std::string GetName() const;
 
+    /*! \brief Get the forcefield this type belongs to.
+     *  \details Types do not keep their forcefield alive, so this is empty
+     *  once every handle to the forcefield is gone.
+     *  \return the forcefield of this type. */
     Forcefield GetForcefield() const;
     Element GetElement() const;
 
@@ -140,6 +144,10 @@ namespace indigox {
      *  \return the linked type. */
     FFBond GetLinkedType() const;
 
+    /*! \brief Get the forcefield this type belongs to.
+     *  \details Types do not keep their forcefield alive, so this is empty
+     *  once every handle to the forcefield is gone.
+     *  \return the forcefield of this type. */
     Forcefield GetForcefield() const;
 
   private:
@@ -223,6 +231,10 @@ namespace indigox {
      *  \return the linked type. */
     FFAngle GetLinkedType() const;
 
+    /*! \brief Get the forcefield this type belongs to.
+     *  \details Types do not keep their forcefield alive, so this is empty
+     *  once every handle to the forcefield is gone.
+     *  \return the forcefield of this type. */
     Forcefield GetForcefield() const;
 
   private:
@@ -322,6 +334,10 @@ namespace indigox {
      *  \return the ID of this dihedral type. */
     int32_t GetID() const;
 
+    /*! \brief Get the forcefield this type belongs to.
+     *  \details Types do not keep their forcefield alive, so this is empty
+     *  once every handle to the forcefield is gone.
+     *  \return the forcefield of this type. */
     Forcefield GetForcefield() const;
 
   private:
@@ -333,6 +349,13 @@ namespace indigox {
   class Forcefield {
     //! \brief Friendship allows serialisation
     friend class cereal::access;
+    //! \brief Friendship allows types to find their shared forcefield.
+    friend class FFAtom;
+    friend class FFBond;
+    friend class FFAngle;
+    friend class FFDihedral;
+    //! \brief Friendship allows built in forcefields to be marked as such.
+    friend Forcefield GenerateGROMOS54A7();
 
   public:
     /*! \brief Enum for the different families of forcefields.
@@ -364,10 +387,28 @@ namespace indigox {
      *  \param name the name of the forcefield. */
     Forcefield(Family family, std::string name);
 
+    /*! \brief Open a forcefield saved in the compact binary format.
+     *  \param path the file to open.
+     *  \return the shared forcefield with the saved contents.
+     *  \throws std::runtime_error if the file is not a valid forcefield file
+     *  of this platform. */
+    static Forcefield Open(const std::string &path);
+
+    /*! \brief Save the forcefield in the compact binary format.
+     *  \details The file holds a 64 byte header, fixed size records for each
+     *  type and a table of the strings, in native byte order. Open maps the
+     *  file and builds the types from the records, which avoids the text
+     *  parsing of other forcefield formats.
+     *  \param path the file to write. */
+    void Save(const std::string &path) const;
+
   private:
     template <typename Archive>
     void serialise(Archive &archive, const uint32_t version);
 
+    //! \brief The shared forcefield this one was loaded as, if any.
+    Forcefield GetShared() const;
+
   private:
     /*! \brief Adds a new bond type to the forcefield.
      *  \param type the type of the bond.
@@ -581,12 +622,38 @@ namespace indigox {
      *  \return the name of the forcefield. */
     std::string GetName() const;
 
+    /*! \brief Hash of the contents of the forcefield.
+     *  \details Covers the family, the name and the parameters of every type,
+     *  so forcefields built the same way have the same hash. It is
+     *  calculated once for shared forcefields.
+     *  \return the content hash. */
+    uint64_t GetHash() const;
+
+    /*! \brief If the forcefield is shared, and so cannot be modified.
+     *  \return if the forcefield is shared. */
+    bool IsShared() const;
+
+    /*! \brief Get the shared equivalent of this forcefield.
+     *  \details Shared forcefields are immutable and held in a process wide
+     *  registry keyed by family, name and content hash. If an equal
+     *  forcefield is already shared, it is returned. Otherwise this
+     *  forcefield is made immutable, registered and returned. Archives store
+     *  built in shared forcefields only as a reference, and loading any
+     *  archived forcefield returns the shared equivalent, so all users of a
+     *  forcefield share one copy.
+     *  \return the shared forcefield. */
+    Forcefield Share() const;
+
   private:
     struct Impl;
     std::shared_ptr<Impl> m_data;
   };
   using FFFamily = Forcefield::Family;
 
+  /*! \brief Get the GROMOS 54A7 forcefield.
+   *  \details The forcefield is built on the first call and shared, so all
+   *  calls return the same immutable instance.
+   *  \return the shared GROMOS 54A7 forcefield. */
   Forcefield GenerateGROMOS54A7();
 
   std::ostream &operator<<(std::ostream &os, BondType type);
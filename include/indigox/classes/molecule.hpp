@@ -5,6 +5,7 @@
 
 #include <bitset>
 #include <cstdint>
+#include <iosfwd>
 #include <map>
 #include <unordered_map>
 #include <vector>
@@ -18,6 +19,10 @@ namespace indigox {
   class Molecule {
     //! \brief Friendship allows serialisation
     friend class cereal::access;
+    //! \brief Friendship allows terms to invalidate the lookup indices.
+    friend class indigox::Atom;
+    friend class indigox::Bond;
+    friend class indigox::Dihedral;
 
   public:
     /*! \brief Container for storing IXAtom instances.
@@ -288,6 +293,35 @@ namespace indigox {
      *  \return the new bond. */
     Bond NewBond(const Atom &a, const Atom &b);
 
+    /*! \brief Create many atoms from contiguous arrays.
+     *  \details Equivalent to calling NewAtom for each atom, but the
+     *  molecule's storage is reserved once and cached data is reset once.
+     *  \param count the number of atoms to create.
+     *  \param atomic_numbers count atomic numbers.
+     *  \param coordinates count x, y, z triples, or null to place all atoms at
+     *  the origin.
+     *  \return the new atoms, in order. Unknown atomic numbers give atoms of
+     *  the undefined element. */
+    MoleculeAtoms NewAtoms(size_t count, const int32_t *atomic_numbers,
+                           const double *coordinates);
+
+    //! \brief Create many atoms from vectors. \see NewAtoms
+    MoleculeAtoms NewAtoms(const std::vector<int32_t> &atomic_numbers,
+                           const std::vector<double> &coordinates);
+
+    /*! \brief Create many bonds from contiguous pairs of atom indices.
+     *  \details Equivalent to calling NewBond for each pair of atoms. Pairs
+     *  which are already bonded give the existing bond, and pairs of the same
+     *  atom give an empty bond.
+     *  \param count the number of bonds to create.
+     *  \param index_pairs count pairs of indices into GetAtoms().
+     *  \return the bonds, in order.
+     *  \throws std::runtime_error if an index is out of range. */
+    MoleculeBonds NewBonds(size_t count, const uint32_t *index_pairs);
+
+    //! \brief Create many bonds from a vector of index pairs. \see NewBonds
+    MoleculeBonds NewBonds(const std::vector<uint32_t> &index_pairs);
+
   private:
     /*! \brief Create an angle between three atoms.
      *  \param a,b,c the atoms to create the angle between.
@@ -297,6 +331,12 @@ namespace indigox {
     Dihedral NewDihedral(const Atom &a, const Atom &b, const Atom &c,
                          const Atom &d, bool manual);
 
+    //! \brief Add any missing angles centred on an atom.
+    int64_t PerceiveAngles(const Atom &centre);
+
+    //! \brief Add any missing dihedrals about a bond and set priorities.
+    int64_t PerceiveDihedrals(const Bond &central);
+
   public:
     /*! \brief Create a dihedral between four atoms.
      *  \param a,b,c,d the atoms to create the dihedral between.
@@ -330,7 +370,9 @@ namespace indigox {
      *  \details An angle is defined for each group of three connected atoms
      *  within a molecule. Subsequent calls to this method will only generate
      *  angles which have not been previously generated. Additionally, angles
-     *  can only be removed by removing an atom or a bond.
+     *  can only be removed by removing an atom or a bond. After edits to a
+     *  molecule whose angles have been perceived, only the atoms whose bonds
+     *  changed are examined.
      *  \return the number of angles added. */
     int64_t PerceiveAngles();
 
@@ -338,7 +380,9 @@ namespace indigox {
      *  \details A dihedral is defined for each group of four connected atoms
      *  within a molecule. Subsequent calls to this method will only generate
      *  dihedrals which have not been previously generated. Additionally,
-     *  dihedrals can only be removed by removing an atom or bond.
+     *  dihedrals can only be removed by removing an atom or bond. After edits
+     *  to a molecule whose dihedrals have been perceived, only the bonds of
+     *  atoms whose bonds changed are examined.
      *  \return the number of dihedrals added. */
     int64_t PerceiveDihedrals();
 
@@ -393,8 +437,19 @@ namespace indigox {
 
     void ReorderAtoms(MoleculeAtoms &new_order);
 
+    /*! \brief Mark all calculated data as out of date.
+     *  \details Angles, dihedrals, the condensed graph and all other data
+     *  derived from the molecule are recalculated in full when next
+     *  required. */
     void ModificationMade();
 
+    /*! \brief Mark data derived from a single atom as out of date.
+     *  \details For changes to the properties of one atom, such as its
+     *  element. Angles, dihedrals and the condensed graph are updated only
+     *  around the atom when next required. Other calculated data is
+     *  recalculated in full. */
+    void ModificationMade(const Atom &atom);
+
     AtomicCoordinates &GetAtomicCoordinates();
     
     void UniquifyAtomNames();
@@ -432,6 +487,14 @@ namespace indigox {
   void SaveMolecule(const Molecule &mol, std::string path);
   Molecule LoadMolecule(std::string path);
 
+  /*! \brief Write a molecule in binary format to a stream.
+   *  \details The same format as SaveMolecule writes to a file. */
+  void SaveMolecule(const Molecule &mol, std::ostream &os);
+
+  /*! \brief Read a molecule in binary format from a stream.
+   *  \throws std::runtime_error if the stream does not hold a molecule. */
+  Molecule LoadMolecule(std::istream &is);
+
 } // namespace indigox
 
 #endif /* INDIGOX_CLASSES_MOLECULE_HPP */
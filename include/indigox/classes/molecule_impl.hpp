@@ -14,7 +14,10 @@
 #include "periodictable.hpp"
 #include "residue.hpp"
 
+#include <array>
 #include <bitset>
+#include <unordered_map>
+#include <vector>
 
 namespace indigox {
 
@@ -143,6 +146,176 @@ namespace indigox {
     Number
   };
 
+  /*! \brief Hash index of the terms of a molecule by ID and by tag.
+   *  \details Unique IDs are fixed when a term is created, so the ID index is
+   *  kept up to date as terms are added and removed. Tags can be changed
+   *  through the term itself, and lookups by tag return the first matching
+   *  term in molecule order, so the tag index is invalidated by any such
+   *  change and rebuilt on the next lookup. */
+  template <class T> struct TermIndex {
+    std::unordered_map<int64_t, T> ids;
+    std::unordered_map<int64_t, T> tags;
+    bool tags_valid = false;
+
+    void Add(const T &term) {
+      ids.emplace(term.GetID(), term);
+      // Appended terms come last in order so cannot shadow an existing tag
+      if (tags_valid) tags.emplace(term.GetTag(), term);
+    }
+
+    // Must be called before the term is reset
+    void Remove(const T &term) {
+      ids.erase(term.GetID());
+      tags_valid = false;
+    }
+
+    void InvalidateTags() { tags_valid = false; }
+
+    template <class Container> void Rebuild(const Container &terms) {
+      ids.clear();
+      ids.reserve(terms.size());
+      for (const T &term : terms) ids.emplace(term.GetID(), term);
+      tags_valid = false;
+    }
+
+    T FindID(int64_t id) const {
+      auto found = ids.find(id);
+      return found == ids.end() ? T() : found->second;
+    }
+
+    template <class Container>
+    T FindTag(int64_t tag, const Container &terms) {
+      if (!tags_valid) {
+        tags.clear();
+        tags.reserve(terms.size());
+        for (const T &term : terms) tags.emplace(term.GetTag(), term);
+        tags_valid = true;
+      }
+      auto found = tags.find(tag);
+      return found == tags.end() ? T() : found->second;
+    }
+  };
+
+  /*! \brief Open-addressing hash table of terms keyed by their atoms.
+   *  \details Keys are tuples of atom unique IDs, canonicalised by the
+   *  molecule so that a term and its reverse share a key. Unique IDs do not
+   *  change when atoms are removed or reordered, so keys never need
+   *  remapping. Linear probing over a power of two capacity keeps a lookup
+   *  to a few contiguous probes, and removed slots are left as tombstones
+   *  until the next rehash. */
+  template <class T, size_t N> class TermTable {
+  public:
+    using Key = std::array<int64_t, N>;
+
+  private:
+    enum class Slot : uint8_t { Empty, Full, Deleted };
+    std::vector<Key> keys;
+    std::vector<T> values;
+    std::vector<Slot> slots;
+    size_t count = 0; // number of full slots
+    size_t used = 0;  // number of full or deleted slots
+
+    static size_t Hash(const Key &key) {
+      uint64_t h = 0x9E3779B97F4A7C15ULL;
+      for (int64_t k : key) {
+        h ^= static_cast<uint64_t>(k) + 0x9E3779B97F4A7C15ULL + (h << 6) +
+             (h >> 2);
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+      }
+      return static_cast<size_t>(h);
+    }
+
+    // Position of key if present, otherwise of the slot to insert it into
+    size_t Probe(const Key &key, bool &found) const {
+      size_t mask = slots.size() - 1;
+      size_t pos = Hash(key) & mask;
+      size_t insert = slots.size();
+      found = false;
+      while (slots[pos] != Slot::Empty) {
+        if (slots[pos] == Slot::Full && keys[pos] == key) {
+          found = true;
+          return pos;
+        }
+        if (slots[pos] == Slot::Deleted && insert == slots.size()) insert = pos;
+        pos = (pos + 1) & mask;
+      }
+      return insert == slots.size() ? pos : insert;
+    }
+
+    void Rehash(size_t capacity) {
+      std::vector<Key> old_keys(capacity);
+      std::vector<T> old_values(capacity);
+      std::vector<Slot> old_slots(capacity, Slot::Empty);
+      old_keys.swap(keys);
+      old_values.swap(values);
+      old_slots.swap(slots);
+      used = count;
+      for (size_t i = 0; i < old_slots.size(); ++i) {
+        if (old_slots[i] != Slot::Full) continue;
+        bool found;
+        size_t pos = Probe(old_keys[i], found);
+        keys[pos] = old_keys[i];
+        values[pos] = std::move(old_values[i]);
+        slots[pos] = Slot::Full;
+      }
+    }
+
+  public:
+    //! \brief Ensure space for n terms without rehashing.
+    void Reserve(size_t n) {
+      size_t capacity = 16;
+      while (capacity < 2 * n) capacity <<= 1;
+      if (capacity > slots.size()) Rehash(capacity);
+    }
+
+    //! \brief Term with the given key, or an empty handle if not present.
+    T Find(const Key &key) const {
+      if (!count) return T();
+      bool found;
+      size_t pos = Probe(key, found);
+      return found ? values[pos] : T();
+    }
+
+    //! \brief Add a term, replacing any existing term with the same key.
+    void Insert(const Key &key, const T &term) {
+      if (2 * (used + 1) > slots.size()) {
+        // Grow if genuinely full, otherwise just clear out tombstones
+        if (4 * (count + 1) > slots.size()) Reserve(2 * (count + 1));
+        else Rehash(slots.size());
+      }
+      bool found;
+      size_t pos = Probe(key, found);
+      if (!found) {
+        ++count;
+        if (slots[pos] == Slot::Empty) ++used;
+      }
+      keys[pos] = key;
+      values[pos] = term;
+      slots[pos] = Slot::Full;
+    }
+
+    //! \brief Remove the term with the given key, if present.
+    void Erase(const Key &key) {
+      if (!count) return;
+      bool found;
+      size_t pos = Probe(key, found);
+      if (!found) return;
+      values[pos] = T();
+      slots[pos] = Slot::Deleted;
+      --count;
+    }
+
+    void Clear() {
+      keys.clear();
+      values.clear();
+      slots.clear();
+      count = used = 0;
+    }
+
+    size_t Size() const { return count; }
+  };
+
   struct Molecule::Impl {
     std::string name;
     int64_t next_unique_id;
@@ -159,22 +332,57 @@ namespace indigox {
 
     std::bitset<static_cast<uint8_t>(CalculatedData::Number)> calculated_data;
 
+    // Atoms whose bonding has changed since the angles, dihedrals and
+    // condensed graph were calculated. These are updated around only these
+    // atoms, rather than recalculated. Not serialised.
+    std::vector<Atom> angle_changes;
+    std::vector<Atom> dihedral_changes;
+    std::vector<Atom> condensed_changes;
+
     // Cached variables
     std::string cached_formula;
 
+    // Lookup indices, not serialised
+    TermIndex<Atom> atom_index;
+    TermIndex<Bond> bond_index;
+    TermIndex<Angle> angle_index;
+    TermIndex<Dihedral> dihedral_index;
+    TermTable<Bond, 2> bond_table;
+    TermTable<Angle, 3> angle_table;
+    TermTable<Dihedral, 4> dihedral_table;
+
     template <typename Archive>
     void serialise(Archive &archive, const uint32_t);
 
     Impl() = default;
     Impl(std::string n);
 
-    // Return the index in a's bonds if found, -1 if not found
-    int64_t FindBond(const Atom &a, const Atom &b) const;
-    // Return the index in b's angles if found, -1 if not found
-    int64_t FindAngle(const Atom &a, const Atom &b, const Atom &c) const;
-    // Return the index in a's dihedrals if found, -1 if not found
-    int64_t FindDihedral(const Atom &a, const Atom &b, const Atom &c,
-                         const Atom &d) const;
+    // Canonical term table keys from the unique IDs of the atoms
+    static TermTable<Bond, 2>::Key BondKey(const Atom &a, const Atom &b);
+    static TermTable<Angle, 3>::Key AngleKey(const Atom &a, const Atom &b,
+                                             const Atom &c);
+    static TermTable<Dihedral, 4>::Key
+    DihedralKey(const Atom &a, const Atom &b, const Atom &c, const Atom &d);
+
+    // Return the bond between a and b, empty if not found
+    Bond FindBond(const Atom &a, const Atom &b) const;
+    // Return the angle a-b-c or c-b-a, empty if not found
+    Angle FindAngle(const Atom &a, const Atom &b, const Atom &c) const;
+    // Return the dihedral a-b-c-d or d-c-b-a, empty if not found
+    Dihedral FindDihedral(const Atom &a, const Atom &b, const Atom &c,
+                          const Atom &d) const;
+
+    // Add or remove a term from the lookup indices. Removal must happen
+    // before the term is reset.
+    void IndexTerm(const Bond &bnd);
+    void IndexTerm(const Angle &ang);
+    void IndexTerm(const Dihedral &dhd);
+    void UnindexTerm(const Bond &bnd);
+    void UnindexTerm(const Angle &ang);
+    void UnindexTerm(const Dihedral &dhd);
+
+    // Rebuild all lookup indices from the term containers
+    void RebuildIndices();
 
     inline bool Test(CalculatedData dat) const {
       return calculated_data.test(static_cast<uint8_t>(dat));
@@ -185,7 +393,22 @@ namespace indigox {
     inline void ResetCalculatedData(CalculatedData dat) {
       calculated_data.reset(static_cast<uint8_t>(dat));
     }
-    inline void ResetCalculatedData() { calculated_data.reset(); }
+    inline void ResetCalculatedData() {
+      calculated_data.reset();
+      angle_changes.clear();
+      dihedral_changes.clear();
+      condensed_changes.clear();
+    }
+
+    /*! \brief Record an edit changing the bonds of some atoms.
+     *  \details Data which can be updated locally is kept and the atoms are
+     *  recorded against it, unless so many atoms have changed that a full
+     *  recalculation is cheaper. All other data is reset. */
+    void BondingChanged(const std::vector<Atom> &changed);
+
+    // Calculated data with the pending changes discarded, for serialising
+    std::bitset<static_cast<uint8_t>(CalculatedData::Number)>
+    UpToDateData() const;
   };
 } // namespace indigox
 
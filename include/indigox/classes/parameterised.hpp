@@ -19,6 +19,11 @@ namespace indigox {
     //! \brief Type giving all mapped charges
     using MappedCharge = std::vector<double>;
     friend class ParamMolecule;
+    friend class cereal::access;
+
+  private:
+    template <typename Archive>
+    void serialise(Archive &archive, const uint32_t version);
 
   public:
     INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(ParamAtom);
@@ -43,8 +48,11 @@ namespace indigox {
      *  if there arises a situation where this requirement is not met, an
      *  exception will be thrown.
      *  \param self_consistent if the parameterisation needs to be self
-     *  consistent. */
-    bool ApplyParameterisation(bool self_consistent);
+     *  consistent.
+     *  \param charge_rounding if positive, the mean charge is rounded to the
+     *  nearest multiple of its inverse. */
+    bool ApplyParameterisation(bool self_consistent,
+                               int64_t charge_rounding = 0);
     
     void AddRedistributedCharge(double amount);
 
@@ -92,6 +100,11 @@ namespace indigox {
     //! \brief Type giving the atoms this parameterised bond is between
     using BondAtoms = std::pair<Atom, Atom>;
     friend class ParamMolecule;
+    friend class cereal::access;
+
+  private:
+    template <typename Archive>
+    void serialise(Archive &archive, const uint32_t version);
 
   public:
     INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(ParamBond);
@@ -149,6 +162,11 @@ namespace indigox {
     //! \brief Type giving the atoms this parameterised angle is between
     using AngleAtoms = stdx::triple<Atom>;
     friend class ParamMolecule;
+    friend class cereal::access;
+
+  private:
+    template <typename Archive>
+    void serialise(Archive &archive, const uint32_t version);
 
   public:
     INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(ParamAngle);
@@ -208,6 +226,11 @@ namespace indigox {
     using DihedralAtoms = stdx::quad<Atom>;
 
     friend class ParamMolecule;
+    friend class cereal::access;
+
+  private:
+    template <typename Archive>
+    void serialise(Archive &archive, const uint32_t version);
 
   public:
     INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(ParamDihedral);
@@ -275,6 +298,12 @@ namespace indigox {
     //! \brief Container type to hold parameterised dihedrals
     using ParamDihedrals = eastl::vector_map<PDihedral, uint32_t>;
 
+    friend class cereal::access;
+
+  private:
+    template <typename Archive>
+    void serialise(Archive &archive, const uint32_t version);
+
   public:
     INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(ParamMolecule);
     INDIGOX_GENERIC_PIMPL_CLASS_OPERATORS(ParamMolecule, mol);
@@ -282,7 +311,13 @@ namespace indigox {
     /*! \brief Normal constructor
      *  \param mol the molecule to parameterise. */
     explicit ParamMolecule(const Molecule &mol);
-    static int64_t charge_rounding;
+
+    /*! \brief Charge rounding factor used when applying parameterisation.
+     *  \details Mean atom charges are rounded to the nearest multiple of the
+     *  inverse of this value. Zero or negative disables rounding. Held per
+     *  molecule so independent parameterisations can run concurrently. */
+    int64_t GetChargeRounding() const;
+    void SetChargeRounding(int64_t rounding);
     
   public:
     /*! \brief Applies the current parameterisation state.
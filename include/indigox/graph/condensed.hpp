@@ -135,6 +135,9 @@ namespace indigox::graph {
     friend class cereal::access;
     //! \brief Friendship allows for generating from a source
     friend CondensedMolecularGraph Condense(const MolecularGraph &);
+    friend CondensedMolecularGraph
+    Recondense(const MolecularGraph &, const CondensedMolecularGraph &,
+               const std::vector<Atom> &);
     friend class MolecularGraph;
 
     //! \brief Type of the underlying IXGraphBase
@@ -183,6 +186,22 @@ namespace indigox::graph {
      *  \return shared_ptr to the newly added vertex. */
     CMGVertex AddVertex(const MGVertex &v);
 
+    /*! \brief Add an edge to the graph, reusing the data of an existing one.
+     *  \details The new edge has the same isomorphism mask as the previous
+     *  edge, which must have the same source.
+     *  \param e the source MGEdge.
+     *  \param previous the edge of an older snapshot to copy.
+     *  \return the newly added edge. */
+    CMGEdge AddEdge(const MGEdge &e, const CMGEdge &previous);
+
+    /*! \brief Add a vertex to the graph, reusing the data of an existing one.
+     *  \details The new vertex has the same condensed vertices and isomorphism
+     *  mask as the previous vertex, which must have the same source.
+     *  \param v the source MGVertex.
+     *  \param previous the vertex of an older snapshot to copy.
+     *  \return the newly added vertex. */
+    CMGVertex AddVertex(const MGVertex &v, const CMGVertex &previous);
+
     //    void Clear();
 
   public:
@@ -275,6 +294,20 @@ namespace indigox::graph {
 
   CondensedMolecularGraph Condense(const MolecularGraph &G);
 
+  /*! \brief Update a condensed graph after changes to its molecular graph.
+   *  \details Only vertices and edges near the changed atoms are evaluated
+   *  again. The rest have their data copied from the previous graph, so the
+   *  result is the same as condensing from scratch as long as every atom
+   *  whose bonding or properties have changed is given. The previous graph
+   *  is left unchanged.
+   *  \param G the molecular graph to condense.
+   *  \param previous a condensed graph of an earlier state of \p G.
+   *  \param changed the atoms changed since \p previous was made.
+   *  \return a new condensed graph. */
+  CondensedMolecularGraph Recondense(const MolecularGraph &G,
+                                     const CondensedMolecularGraph &previous,
+                                     const std::vector<Atom> &changed);
+
 } // namespace indigox::graph
 
 #endif /* INDIGOX_GRAPH_CONDENSED_HPP */
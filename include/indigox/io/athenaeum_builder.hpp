@@ -0,0 +1,32 @@
+/*! \file athenaeum_builder.hpp */
+#ifndef INDIGOX_IO_ATHENAEUM_BUILDER_HPP
+#define INDIGOX_IO_ATHENAEUM_BUILDER_HPP
+
+#include "../utils/fwd_declares.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace indigox::io {
+
+  /*! \brief Build athenaeums from a directory of fragment files.
+   *  \details Every .frag file in the directory is read with
+   *  ReadFragmentFile, spread over worker threads. The fragments given in
+   *  the files are added to \p manual, and all fragments of every molecule
+   *  are found in parallel and added to \p automatic. Files are added in name
+   *  order. Either athenaeum may be empty, in which case it is not built. The
+   *  settings of each athenaeum are used as given.
+   *  \param directory the directory of fragment files.
+   *  \param manual athenaeum for the fragments given in the files.
+   *  \param automatic athenaeum for all fragments of the molecules.
+   *  \param num_threads number of worker threads, or 0 for one per core.
+   *  \return the number of molecules read.
+   *  \throws std::runtime_error naming the file, if a file cannot be read.
+   *  \throws std::runtime_error if the athenaeums have different forcefields,
+   *  or a molecule cannot be fragmented. */
+  size_t BuildAthenaeums(const std::string &directory, Athenaeum &manual,
+                         Athenaeum &automatic, uint32_t num_threads = 0);
+
+} // namespace indigox::io
+
+#endif /* INDIGOX_IO_ATHENAEUM_BUILDER_HPP */
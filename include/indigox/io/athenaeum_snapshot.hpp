@@ -0,0 +1,113 @@
+/*! \file athenaeum_snapshot.hpp */
+#ifndef INDIGOX_IO_ATHENAEUM_SNAPSHOT_HPP
+#define INDIGOX_IO_ATHENAEUM_SNAPSHOT_HPP
+
+#include "../classes/athenaeum.hpp"
+#include "../utils/fwd_declares.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace indigox::io {
+  /*! \brief Read only Athenaeum mapped from a snapshot file.
+   *  \details A snapshot holds, for every fragment, the data CherryPicker
+   *  screens fragments with: its size, the numbers of vertices and edges of
+   *  its graph, the isomorphism masks of its vertices and its supersets. These
+   *  are in flat tables addressed by file offsets, so the file is mapped read
+   *  only and used in place. Processes mapping the same snapshot share one
+   *  physical copy of it through the page cache. Placing the snapshot in
+   *  /dev/shm holds it in POSIX shared memory.
+   *
+   *  Each source molecule and its fragments are also stored serialised, and
+   *  are only loaded by a process when one of its fragments passes screening.
+   *  So the memory of a process grows with the source molecules it matches,
+   *  rather than with the whole Athenaeum. Loaded molecules are kept, and
+   *  loading is safe from many threads.
+   *
+   *  Snapshots are in native byte order. */
+  class AthenaeumSnapshot {
+  public:
+    /*! \brief Screening data of one fragment.
+     *  \details Pointers are into the mapped file, and remain valid while any
+     *  copy of the snapshot exists. */
+    struct FragmentView {
+      //! \brief Number of atoms, as Fragment::Size.
+      uint32_t size;
+      uint32_t num_vertices;
+      uint32_t num_edges;
+      //! \brief Isomorphism masks of the graph vertices, in vertex order.
+      const uint64_t *labels;
+      /*! \brief Bits of the fragments of the same molecule which are
+       *  supersets of this one, 64 to a word. */
+      const uint64_t *supersets;
+    };
+
+    INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(AthenaeumSnapshot);
+
+    /*! \brief Map a snapshot.
+     *  \details The forcefield stored with the snapshot is loaded, and
+     *  resolves to the shared forcefield equal to it.
+     *  \param path the snapshot file.
+     *  \throws std::runtime_error if the file is not a snapshot of this
+     *  platform. */
+    explicit AthenaeumSnapshot(const std::string &path);
+
+    bool operator==(const AthenaeumSnapshot &snap) const {
+      return m_data == snap.m_data;
+    }
+    bool operator!=(const AthenaeumSnapshot &snap) const {
+      return m_data != snap.m_data;
+    }
+    operator bool() const { return bool(m_data); }
+
+    //! \brief Number of source molecules.
+    size_t NumMolecules() const;
+
+    //! \brief Number of fragments of all source molecules.
+    size_t NumFragments() const;
+
+    //! \brief Number of fragments of the source molecule at a position.
+    size_t NumFragments(size_t mol) const;
+
+    //! \brief Screening data of a fragment of a source molecule.
+    FragmentView GetFragmentView(size_t mol, size_t pos) const;
+
+    /*! \brief Fragments of the source molecule at a position.
+     *  \details Loads the molecule on first use. Fragments are in the same
+     *  order as their views.
+     *  \throws std::runtime_error if the stored molecule cannot be loaded. */
+    const Athenaeum::FragContain &GetFragments(size_t mol) const;
+
+    //! \brief Number of source molecules loaded so far.
+    size_t NumLoaded() const;
+
+    //! \brief Forcefield of the Athenaeum the snapshot was made from.
+    const Forcefield &GetForcefield() const;
+
+    //! \brief Boolean setting of the Athenaeum the snapshot was made from.
+    bool GetBool(Athenaeum::Settings param) const;
+
+    //! \brief Integer setting of the Athenaeum the snapshot was made from.
+    int32_t GetInt(Athenaeum::Settings param) const;
+
+    //! \brief Path of the snapshot file.
+    const std::string &GetPath() const;
+
+  private:
+    struct Impl;
+    std::shared_ptr<Impl> m_data;
+  };
+
+  /*! \brief Save a snapshot of an Athenaeum.
+   *  \param ath the Athenaeum.
+   *  \param path the file to write.
+   *  \throws std::runtime_error if the file cannot be written. */
+  void SaveAthenaeumSnapshot(const Athenaeum &ath, const std::string &path);
+
+  //! \brief If a file is an Athenaeum snapshot.
+  bool IsAthenaeumSnapshot(const std::string &path);
+
+} // namespace indigox::io
+
+#endif /* INDIGOX_IO_ATHENAEUM_SNAPSHOT_HPP */
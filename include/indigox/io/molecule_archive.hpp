@@ -0,0 +1,114 @@
+/*! \file molecule_archive.hpp */
+#ifndef INDIGOX_IO_MOLECULE_ARCHIVE_HPP
+#define INDIGOX_IO_MOLECULE_ARCHIVE_HPP
+
+#include "../utils/fwd_declares.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace indigox::io {
+  /*! \brief Single file store of many molecules.
+   *  \details Each molecule is held as one block of the columns of a
+   *  ColumnarMolecule: coordinates, charges, residues, atom and bond types,
+   *  bonds and interned names. An index of block offsets and molecule names
+   *  at the end of the file gives constant time access by position or name.
+   *  The file is memory mapped, so opening an archive reads only its index
+   *  and getting a molecule copies only its block.
+   *
+   *  Molecules are appended to the end of the blocks, and the index is
+   *  rewritten when the archive is flushed or closed. If a process stops
+   *  before then, the index is rebuilt from the blocks on the next open.
+   *  Blocks are in native byte order, and angles, dihedrals and other
+   *  perceived data are not stored.
+   *
+   *  Atom and bond types are stored by ID, and each block records the
+   *  content hash of its forcefield. Typed molecules are read with the
+   *  forcefield given on opening, or the built in GROMOS 54A7 forcefield if
+   *  their hash matches it. Getting and appending molecules are safe from
+   *  many threads, and molecules are decoded concurrently. */
+  class MoleculeArchive {
+  public:
+    INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(MoleculeArchive);
+
+    /*! \brief Open an archive, creating it if the file does not exist.
+     *  \param path the archive file.
+     *  \param ff the forcefield of typed molecules in the archive, if any.
+     *  \throws std::runtime_error if the file is not an archive of this
+     *  platform, or cannot be created. */
+    explicit MoleculeArchive(const std::string &path,
+                             const Forcefield &ff = Forcefield());
+
+    bool operator==(const MoleculeArchive &archive) const {
+      return m_data == archive.m_data;
+    }
+    bool operator!=(const MoleculeArchive &archive) const {
+      return m_data != archive.m_data;
+    }
+    operator bool() const { return bool(m_data); }
+
+    //! \brief Number of molecules in the archive.
+    uint64_t NumMolecules() const;
+
+    //! \brief Path of the archive file.
+    const std::string &GetPath() const;
+
+    /*! \brief Forcefield of typed molecules.
+     *  \details Either the forcefield given on opening or that of the first
+     *  typed molecule appended. */
+    Forcefield GetForcefield() const;
+
+    //! \brief If the archive has a molecule with the given name.
+    bool HasMolecule(const std::string &name) const;
+
+    /*! \brief Position of the first molecule with the given name.
+     *  \return the position, or -1 if there is no such molecule. */
+    int64_t GetIndex(const std::string &name) const;
+
+    /*! \brief Name of the molecule at a position.
+     *  \throws std::out_of_range if there is no such position. */
+    const std::string &GetName(uint64_t pos) const;
+
+    /*! \brief Get the molecule at a position in columnar form.
+     *  \throws std::out_of_range if there is no such position.
+     *  \throws std::runtime_error if the block is corrupt, or its types need
+     *  a forcefield the archive was not opened with. */
+    ColumnarMolecule GetColumnar(uint64_t pos) const;
+
+    /*! \brief Get the first molecule with a name in columnar form.
+     *  \throws std::out_of_range if there is no such molecule.
+     *  \see GetColumnar(uint64_t) const */
+    ColumnarMolecule GetColumnar(const std::string &name) const;
+
+    /*! \brief Get the molecule at a position.
+     *  \details Equivalent to GetColumnar(pos).ToMolecule().
+     *  \see GetColumnar(uint64_t) const */
+    Molecule GetMolecule(uint64_t pos) const;
+
+    /*! \brief Get the first molecule with a name.
+     *  \see GetColumnar(const std::string&) const */
+    Molecule GetMolecule(const std::string &name) const;
+
+    /*! \brief Append a molecule to the archive.
+     *  \return the position of the appended molecule.
+     *  \throws std::runtime_error if the molecule is typed with a forcefield
+     *  other than that of the archive, or the file cannot be written. */
+    uint64_t Append(const ColumnarMolecule &mol);
+
+    //! \brief Append a molecule to the archive. \see Append
+    uint64_t Append(const Molecule &mol);
+
+    /*! \brief Write the index of any appended molecules.
+     *  \details Called when the last copy of the archive is destroyed.
+     *  \throws std::runtime_error if the file cannot be written. */
+    void Flush();
+
+  private:
+    struct Impl;
+    std::shared_ptr<Impl> m_data;
+  };
+
+} // namespace indigox::io
+
+#endif /* INDIGOX_IO_MOLECULE_ARCHIVE_HPP */
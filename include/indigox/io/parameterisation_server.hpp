@@ -0,0 +1,131 @@
+/*! \file parameterisation_server.hpp */
+#ifndef INDIGOX_IO_PARAMETERISATION_SERVER_HPP
+#define INDIGOX_IO_PARAMETERISATION_SERVER_HPP
+
+#include "../utils/fwd_declares.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace indigox::io {
+  /*! \brief Long running CherryPicker parameterisation over a Unix socket.
+   *  \details The server keeps a configured CherryPicker, and so its
+   *  Athenaeums and forcefield, loaded between requests, so a client pays
+   *  only for parameterising its molecule. Requests are answered by a pool of
+   *  worker threads, each with its own copy of the CherryPicker sharing the
+   *  Athenaeums. Idle connections are polled rather than holding a worker,
+   *  so any number of clients may stay connected, and a worker takes each
+   *  request as it arrives. A connection may send any number of requests,
+   *  which are answered in order. A connection which stalls for 30 s within
+   *  a request or its answer is closed.
+   *
+   *  Each message is a frame of a four byte magic, a one byte kind and an
+   *  eight byte payload length in native byte order, followed by the
+   *  payload. A request holds a molecule in the binary format of
+   *  SaveMolecule, and is answered either by the parameterised molecule in
+   *  the same format or by an error message. An error parameterising one
+   *  molecule does not close the connection.
+   *
+   *  As the Athenaeums are held only by the server, worker processes on a
+   *  node which parameterise through it share one copy of them. Requests
+   *  beyond the number of server threads wait for a free one. */
+  class ParameterisationServer {
+  public:
+    INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(ParameterisationServer);
+
+    /*! \brief Listen for requests on a socket.
+     *  \details A stale socket file left by a server which has stopped is
+     *  replaced. Requests are not answered until Serve() is called.
+     *  \param picker the configured CherryPicker, with its Athenaeums added.
+     *  \param socket_path the path of the socket.
+     *  \param num_threads number of worker threads, or 0 for one per core.
+     *  \throws std::runtime_error if the socket cannot be created, or another
+     *  server is listening on it. */
+    ParameterisationServer(const algorithm::CherryPicker &picker,
+                           const std::string &socket_path,
+                           uint32_t num_threads = 0);
+
+    bool operator==(const ParameterisationServer &server) const {
+      return m_data == server.m_data;
+    }
+    bool operator!=(const ParameterisationServer &server) const {
+      return m_data != server.m_data;
+    }
+    operator bool() const { return bool(m_data); }
+
+    /*! \brief Answer requests until Stop() is called.
+     *  \details The calling thread accepts connections and polls them for
+     *  requests, which it hands to the workers.
+     *  \throws std::runtime_error if the connections cannot be polled. */
+    void Serve();
+
+    /*! \brief Stop serving.
+     *  \details Open connections are closed, and Serve() returns once the
+     *  requests being parameterised are finished. May be called from any
+     *  thread, but not from a signal handler. */
+    void Stop();
+
+    //! \brief Path of the socket.
+    const std::string &GetSocketPath() const;
+
+    //! \brief Number of requests answered so far, including errors.
+    uint64_t NumServed() const;
+
+  private:
+    struct Impl;
+    std::shared_ptr<Impl> m_data;
+  };
+
+  /*! \brief Connection to a ParameterisationServer.
+   *  \details The connection is kept open between requests, and reopened
+   *  once if the server has restarted since the last request. Copies share
+   *  the connection, and their requests are sent one at a time, so threads
+   *  wanting requests answered concurrently should each have their own
+   *  client. */
+  class ParameterisationClient {
+  public:
+    INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(ParameterisationClient);
+
+    /*! \brief Connect to a server.
+     *  \param socket_path the socket the server is listening on.
+     *  \throws std::runtime_error if the server cannot be reached. */
+    explicit ParameterisationClient(const std::string &socket_path);
+
+    bool operator==(const ParameterisationClient &client) const {
+      return m_data == client.m_data;
+    }
+    bool operator!=(const ParameterisationClient &client) const {
+      return m_data != client.m_data;
+    }
+    operator bool() const { return bool(m_data); }
+
+    /*! \brief Parameterise a molecule with the server.
+     *  \param mol the molecule to parameterise.
+     *  \return the parameterised molecule. The given molecule is unchanged.
+     *  \throws std::runtime_error if the server cannot be reached, or failed
+     *  to parameterise the molecule. */
+    Molecule ParameteriseMolecule(const Molecule &mol);
+
+    //! \brief Path of the socket.
+    const std::string &GetSocketPath() const;
+
+  private:
+    struct Impl;
+    std::shared_ptr<Impl> m_data;
+  };
+
+  /*! \brief Parameterise a molecule with a ParameterisationServer.
+   *  \details Opens a connection for the one request. \see
+   *  ParameterisationClient
+   *  \param socket_path the socket the server is listening on.
+   *  \param mol the molecule to parameterise.
+   *  \return the parameterised molecule. The given molecule is unchanged.
+   *  \throws std::runtime_error if the server cannot be reached, or failed
+   *  to parameterise the molecule. */
+  Molecule ParameteriseRemote(const std::string &socket_path,
+                              const Molecule &mol);
+
+} // namespace indigox::io
+
+#endif /* INDIGOX_IO_PARAMETERISATION_SERVER_HPP */
@@ -0,0 +1,93 @@
+/*! \file readers.hpp */
+#ifndef INDIGOX_IO_READERS_HPP
+#define INDIGOX_IO_READERS_HPP
+
+#include "../utils/fwd_declares.hpp"
+
+#include <string>
+#include <vector>
+
+namespace indigox::io {
+
+  /*! \brief Read the atoms and bonds of a PDB file.
+   *  \details Atoms are taken from ATOM and HETATM records up to the first
+   *  ENDMDL, with the element from columns 77-78, the name from columns
+   *  13-16 and the tag from the serial number. Coordinates are converted from
+   *  angstroms to nanometres. Bonds are taken from CONECT records. The
+   *  molecule is named for the file, without its extension.
+   *  \param path the file to read.
+   *  \return the new molecule.
+   *  \throws std::runtime_error if the file cannot be read. */
+  Molecule ReadPDBFile(const std::string &path);
+
+  /*! \brief Read formal charges and bond orders from an IXD file.
+   *  \details Each line is one of ATOM tag charge implicit_count, BOND tag
+   *  tag order, or MOLECULE charge. Carbon atoms not given in an ATOM line
+   *  have their implicit count set from their bond orders.
+   *  \param path the file to read.
+   *  \param mol the molecule the details are for.
+   *  \throws std::out_of_range if an atom or bond does not exist.
+   *  \throws std::invalid_argument if a carbon has an impossible valence, or
+   *  the formal charges do not sum to the molecular charge. */
+  void ReadIXDFile(const std::string &path, Molecule &mol);
+
+  /*! \brief Read a parameterised molecule from a GROMACS ITP file.
+   *  \details The atoms, bonds, angles and dihedrals blocks are read, with
+   *  types taken from GROMOS style gb_, ga_, gi_ and gd_ macros.
+   *  \param path the file to read.
+   *  \param ff the forcefield the types belong to.
+   *  \return the new molecule.
+   *  \throws std::out_of_range if an atom, angle or type does not exist. */
+  Molecule ReadITPFile(const std::string &path, const Forcefield &ff);
+
+  /*! \brief Read a parameterised molecule from a GROMOS MTB file.
+   *  \details Only MTBUILDBLSOLUTE blocks are read, with one line per atom,
+   *  bond, angle or dihedral.
+   *  \param path the file to read.
+   *  \param ff the forcefield the types belong to.
+   *  \return the new molecule.
+   *  \throws std::out_of_range if an atom, angle, dihedral or type does not
+   *  exist. */
+  Molecule ReadMTBFile(const std::string &path, const Forcefield &ff);
+
+  /*! \brief Read a parameterised molecule with coordinates.
+   *  \details Types are read from an MTB, ITP or TOP file, and any details
+   *  from an IXD file. Positions and elements are then taken from the atoms
+   *  of a PDB file with the same tags.
+   *  \param coord_path the PDB file.
+   *  \param param_path the MTB, ITP or TOP file.
+   *  \param ff the forcefield the types belong to.
+   *  \param detail_path the IXD file, or empty if there is none.
+   *  \return the new molecule.
+   *  \throws std::runtime_error if a file is of an unknown format, or the
+   *  files have different numbers of atoms. */
+  Molecule ReadParameterisedMolecule(const std::string &coord_path,
+                                     const std::string &param_path,
+                                     const Forcefield &ff,
+                                     const std::string &detail_path = "");
+
+  /*! \brief Read a molecule and its fragments from a fragment file.
+   *  \details A fragment file has a MOLECULE block giving the PDB, parameter
+   *  and IXD files of the molecule, relative to the fragment file, followed
+   *  by pairs of FRAGMENT and OVERLAP blocks of atom tags. The molecule is
+   *  read with ReadParameterisedMolecule and named for the fragment file,
+   *  without its extension.
+   *  \param path the file to read.
+   *  \param ff the forcefield the types belong to.
+   *  \param[out] fragments the fragments of the molecule are added to this.
+   *  \return the new molecule.
+   *  \throws std::runtime_error if the blocks are malformed.
+   *  \throws std::out_of_range if a fragment atom does not exist. */
+  Molecule ReadFragmentFile(const std::string &path, const Forcefield &ff,
+                            std::vector<Fragment> &fragments);
+
+  /*! \brief Read a GROMOS IFP file as a forcefield.
+   *  \details See the GROMOS manual for the format. The forcefield is named
+   *  for the file, without its extension.
+   *  \param path the file to read.
+   *  \return the new forcefield. */
+  Forcefield ReadIFPFile(const std::string &path);
+
+} // namespace indigox::io
+
+#endif /* INDIGOX_IO_READERS_HPP */
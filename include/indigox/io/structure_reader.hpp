@@ -0,0 +1,75 @@
+/*! \file structure_reader.hpp */
+#ifndef INDIGOX_IO_STRUCTURE_READER_HPP
+#define INDIGOX_IO_STRUCTURE_READER_HPP
+
+#include "../utils/fwd_declares.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace indigox::io {
+  /*! \brief Streaming reader of multi-record SDF and MOL2 files.
+   *  \details The file is mapped rather than loaded, and records are found
+   *  and parsed in batches. Each batch is split between worker threads, and
+   *  the next batch is parsed while the current one is consumed. At most two
+   *  batches are held at once, so memory use does not depend on the size of
+   *  the file. Molecules are returned in file order.
+   *
+   *  SDF records are read as V2000 molecules, with charges from the atom
+   *  block or M  CHG properties. MOL2 records are read from their MOLECULE,
+   *  ATOM and BOND sections, with partial charges if present. Atoms are named
+   *  and tagged as in the file, or for SDF by element and position.
+   *  Coordinates are converted from angstroms to nanometres. */
+  class StructureReader {
+  public:
+    //! \brief Supported file formats.
+    enum class Format { SDF, MOL2 };
+
+    INDIGOX_GENERIC_PIMPL_CLASS_DEFAULTS(StructureReader);
+
+    /*! \brief Open a file, with the format given by its extension.
+     *  \details .sdf, .sd and .mol files are read as SDF, and .mol2 files as
+     *  MOL2.
+     *  \param path the file to read.
+     *  \param num_threads number of worker threads, or 0 for one per core.
+     *  \param batch_size number of records parsed by each worker at a time.
+     *  \throws std::runtime_error if the file cannot be mapped or has an
+     *  unknown extension. */
+    explicit StructureReader(const std::string &path, uint32_t num_threads = 0,
+                             uint32_t batch_size = 64);
+
+    /*! \brief Open a file of the given format.
+     *  \see StructureReader(const std::string&, uint32_t, uint32_t) */
+    StructureReader(const std::string &path, Format format,
+                    uint32_t num_threads = 0, uint32_t batch_size = 64);
+
+    bool operator==(const StructureReader &reader) const {
+      return m_data == reader.m_data;
+    }
+    bool operator!=(const StructureReader &reader) const {
+      return m_data != reader.m_data;
+    }
+    operator bool() const { return bool(m_data); }
+
+    /*! \brief Read the next molecule.
+     *  \param[out] mol the molecule read.
+     *  \return false if all records have been read.
+     *  \throws std::runtime_error if the record is malformed. The record is
+     *  skipped, so reading can continue. */
+    bool Next(Molecule &mol);
+
+    //! \brief Number of molecules returned so far.
+    uint64_t NumRead() const;
+
+    //! \brief Format the file is read as.
+    Format GetFormat() const;
+
+  private:
+    struct Impl;
+    std::shared_ptr<Impl> m_data;
+  };
+
+} // namespace indigox::io
+
+#endif /* INDIGOX_IO_STRUCTURE_READER_HPP */
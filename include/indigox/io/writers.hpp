@@ -0,0 +1,46 @@
+/*! \file writers.hpp */
+#ifndef INDIGOX_IO_WRITERS_HPP
+#define INDIGOX_IO_WRITERS_HPP
+
+#include "../classes/parameterised.hpp"
+#include "../utils/fwd_declares.hpp"
+
+#include <string>
+
+namespace indigox::io {
+
+  /*! \brief Write the atoms and bonds of a molecule to a PDB file.
+   *  \details All atoms are written as HETATM records, with coordinates
+   *  converted from nanometres to angstroms, followed by a CONECT record for
+   *  each bonded atom.
+   *  \param path the file to write.
+   *  \param mol the molecule to write.
+   *  \throws std::runtime_error if the file cannot be written. */
+  void WritePDBFile(const std::string &path, Molecule &mol);
+
+  /*! \brief Write a parameterised molecule to a GROMACS ITP file.
+   *  \details Parameters are given as GROMOS gb_, ga_, gi_ and gd_ macros.
+   *  If the parameterisation of the molecule is also given, the spread of
+   *  charges and any other mapped types are added as comments.
+   *  \param path the file to write.
+   *  \param mol the molecule to write.
+   *  \param pmol the parameterisation of the molecule, if available.
+   *  \throws std::runtime_error if the file cannot be written. */
+  void WriteITPFile(const std::string &path, Molecule &mol,
+                    const ParamMolecule &pmol = ParamMolecule());
+
+  /*! \brief Write a parameterised molecule to a GROMACS RTP file.
+   *  \details The molecule is written as a single residue, named for the
+   *  residue of its first atom, with explicit parameter values. Comments are
+   *  added from the parameterisation as for WriteITPFile.
+   *  \param path the file to write.
+   *  \param mol the molecule to write.
+   *  \param pmol the parameterisation of the molecule, if available.
+   *  \throws std::out_of_range if the molecule has no atoms.
+   *  \throws std::runtime_error if the file cannot be written. */
+  void WriteRTPFile(const std::string &path, Molecule &mol,
+                    const ParamMolecule &pmol = ParamMolecule());
+
+} // namespace indigox::io
+
+#endif /* INDIGOX_IO_WRITERS_HPP */
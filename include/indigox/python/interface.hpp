@@ -18,11 +18,20 @@ void GeneratePyForcefield(pybind11::module &m);
 void GeneratePyAthenaeum(pybind11::module &m);
 void GeneratePyGraphAlgorithms(pybind11::module &m);
 void GeneratePyParameterisedMolecule(pybind11::module &m);
+void GeneratePyReaders(pybind11::module &m);
+void GeneratePyWriters(pybind11::module &m);
+void GeneratePyArchive(pybind11::module &m);
+void GeneratePyServer(pybind11::module &m);
 
 void GeneratePyElectronAssigner(pybind11::module &m);
 
 void GenerateOpaqueContainers(pybind11::module &m);
 
+/*! \brief Call guard releasing the GIL for the duration of a bound call.
+ *  \details For long running functions which take and return only C++
+ *  objects, so that other Python threads can run in the meantime. */
+using ReleaseGIL = pybind11::call_guard<pybind11::gil_scoped_release>;
+
 template <typename T> std::string outstream_operator(const T &t) {
   std::stringstream ss;
   ss << t;
@@ -1,22 +1,28 @@
-#ifndef INDIGOX_PYTHON_PICKLE_HPP
-#define INDIGOX_PYTHON_PICKLE_HPP
-
-#include <indigox/classes/atom.hpp>
-#include <indigox/classes/bond.hpp>
-#include <indigox/classes/molecule.hpp>
-#include <indigox/classes/periodictable.hpp>
-
 #include <pybind11/pybind11.h>
 
-namespace py = pybind11;
+#ifndef INDIGOX_PYTHON_PICKLE_HPP
+#define INDIGOX_PYTHON_PICKLE_HPP
 
-py::tuple PickleAtom(const indigox::Atom atom);
-indigox::Atom UnpickleAtom(py::tuple &t);
+/*! \brief Serialise an object to a portable binary string for pickling.
+ *  \details Uses the same cereal archive as the binary save files. The GIL
+ *  is released while the archive is written. Instantiated for Molecule,
+ *  Athenaeum and ParamMolecule.
+ *  \param obj the object to pickle.
+ *  \return the pickled state. */
+template <class T> pybind11::bytes PickleObject(const T &obj);
 
-py::tuple PickleBond(const indigox::Bond bond);
-indigox::Bond UnpickleBond(py::tuple &t);
+/*! \brief Restore an object from the state made by PickleObject.
+ *  \param state the pickled state.
+ *  \return the restored object.
+ *  \throws std::runtime_error if the state was pickled by an incompatible
+ *  version. */
+template <class T> T UnpickleObject(const pybind11::bytes &state);
 
-py::tuple PicklePeriodicTable(const indigox::PeriodicTable table);
-indigox::PeriodicTable UnpicklePeriodicTable(py::tuple &t);
+/*! \brief Pickling support for binding with py::class_::def.
+ *  \details Provides __getstate__ and __setstate__ so objects can be sent to
+ *  multiprocessing and concurrent.futures workers. */
+template <class T> auto PickleSupport() {
+  return pybind11::pickle(&PickleObject<T>, &UnpickleObject<T>);
+}
 
 #endif /* INDIGOX_PYTHON_PICKLE_HPP */
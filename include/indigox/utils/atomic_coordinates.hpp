@@ -1,8 +1,8 @@
 #include "serialise.hpp"
-#include "vec_avx.hpp"
 
 #include <cstdint>
 #include <cstdlib>
+#include <memory>
 #include <new>
 
 #ifndef INDIGOX_UTILS_ATOMIC_COORDINATES_HPP
@@ -15,6 +15,14 @@ namespace indigox {
     double x, y, z;
   };
 
+  // Read only view of the coordinates of a set of atoms, with each axis stored
+  // contiguously. Lets algorithms work on coordinates held by a Molecule or by
+  // a ConformerSet without copying them.
+  struct CoordinateFrame {
+    const double *x, *y, *z;
+    uint32_t size;
+  };
+
 #define count_per_size 3
 #define scale_factor 2
   struct AtomicCoordinates {
@@ -43,8 +51,7 @@ namespace indigox {
       }
     }
     
-    AtomicCoordinates()
-        : unaligned_mem(nullptr), data(nullptr), max_size(0), size(0) {}
+    AtomicCoordinates() : data(nullptr), max_size(0), size(0) {}
 
     AtomicCoordinates(uint32_t count) : AtomicCoordinates() { Reserve(count); }
 
@@ -59,14 +66,12 @@ namespace indigox {
     }
 
     AtomicCoordinates(AtomicCoordinates &&other)
-        : unaligned_mem(other.unaligned_mem), data(other.data),
+        : unaligned_mem(std::move(other.unaligned_mem)), data(other.data),
           max_size(other.max_size), size(other.size) {
-      other.unaligned_mem = nullptr;
       other.data = nullptr;
     }
 
     ~AtomicCoordinates() {
-      delete[] unaligned_mem;
       max_size = 0;
       size = 0;
     }
@@ -76,8 +81,9 @@ namespace indigox {
       if (&other == this) return *this;
 
       // Release
-      delete[] unaligned_mem;
+      unaligned_mem.reset();
       data = nullptr;
+      max_size = 0;
 
       // Reacquire and copy
       Reserve(other.size);
@@ -95,14 +101,11 @@ namespace indigox {
       // Self check
       if (&other == this) return *this;
 
-      // Release
-      delete[] unaligned_mem;
-      data = nullptr;
-
       // Steal from other
-      unaligned_mem = other.unaligned_mem;
+      unaligned_mem = std::move(other.unaligned_mem);
       data = other.data;
-      other.unaligned_mem = nullptr;
+      max_size = other.max_size;
+      size = other.size;
       other.data = nullptr;
 
       return *this;
@@ -114,6 +117,17 @@ namespace indigox {
               data[index + 2 * max_size]};
     }
 
+    CoordinateFrame Frame() {
+      if (!data) return {nullptr, nullptr, nullptr, 0};
+      return {x_vals(), y_vals(), z_vals(), size};
+    }
+
+    // Owner of the memory the coordinates are held in. Holding it keeps the
+    // memory alive after the coordinates are reallocated or destroyed, so
+    // views of the coordinates never dangle, though they then no longer
+    // reflect changes.
+    std::shared_ptr<const void> Storage() const { return unaligned_mem; }
+
     double* x_vals() { return data; }
     double* y_vals() { return &data[max_size]; }
     double* z_vals() { return &data[2 * max_size]; }
@@ -168,8 +182,7 @@ namespace indigox {
     }
 
   private:
-    char *unaligned_mem = nullptr; // Unaligned raw memory
-    char *old_unaligned = nullptr; // Old unaligned raw memory after resizing
+    std::shared_ptr<char[]> unaligned_mem; // Unaligned raw memory
 
   public:
     double *data = nullptr; // Aligned type-d memory
@@ -181,18 +194,17 @@ namespace indigox {
     // Allocates space for at least count xyz.
     // Rounds count up to nearest multiple of 4.
     // Copies current memory into new.
-    // Puts current into old and leaves for calling method to free
+    // Current memory is released unless held through Storage()
     void AllocateMemory(uint32_t count) {
-      const uint32_t align = sizeof(Vec4d) - 1; // align on 32 byte boundary
+      const uint32_t align = 63; // align on 64 byte boundary for any SIMD
 
       // Allocate new memory block
       if (count % 4)
         count += 4 - (count % 4); // Round up to nearest multiple of 4
       uint32_t new_size = count * count_per_size * sizeof(double);
-      char *new_mem = new char[new_size + align];
-      if (!new_mem) throw std::bad_alloc();
+      std::shared_ptr<char[]> new_mem(new char[new_size + align]);
       double *new_data =
-          (double *)(((uintptr_t)new_mem + align) & ~(uintptr_t)(align));
+          (double *)(((uintptr_t)new_mem.get() + align) & ~(uintptr_t)(align));
 
       // Copy existing data
       if (data) {
@@ -201,17 +213,9 @@ namespace indigox {
         memcpy(&new_data[count * 2], &data[max_size * 2], size * sizeof(double));
       }
 
-      // Save old data.
-      old_unaligned = unaligned_mem;
-      unaligned_mem = new_mem;
+      unaligned_mem = std::move(new_mem);
       data = new_data;
       max_size = count;
-
-      // Free old data
-      if (old_unaligned) {
-        delete[] old_unaligned;
-        old_unaligned = nullptr;
-      }
     }
   };
 
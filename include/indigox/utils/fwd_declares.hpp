@@ -53,6 +53,10 @@ namespace indigox {
   class Element;
   class PeriodicTable;
   class Residue;
+  class ColumnarMolecule;
+  class ColumnarAtom;
+  class ColumnarBond;
+  class ConformerSet;
 
   // CherryPicker Related
   class ParamMolecule;
@@ -115,6 +119,10 @@ namespace indigox {
     class CMGEdge;
   } // namespace graph
 
+  namespace io {
+    class MoleculeArchive;
+  } // namespace io
+
   namespace test {
     struct TestForcefield;
     struct TestFFAtom;
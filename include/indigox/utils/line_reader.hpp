@@ -0,0 +1,92 @@
+/*! \file line_reader.hpp */
+#ifndef INDIGOX_UTILS_LINE_READER_HPP
+#define INDIGOX_UTILS_LINE_READER_HPP
+
+#include "mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace indigox::utils {
+
+  /*! \brief Line by line reading of a mapped file.
+   *  \details Lines are returned as views into the mapping rather than
+   *  copied, and remain valid for the lifetime of the reader. Line endings,
+   *  either \\n or \\r\\n, are not included in the returned lines. */
+  class LineReader {
+  public:
+    /*! \brief Map a file for reading.
+     *  \throws std::runtime_error if the file cannot be opened or mapped. */
+    explicit LineReader(const std::string &path);
+
+    /*! \brief Read the next line.
+     *  \param[out] line the line read.
+     *  \return false if the end of the file has been reached. */
+    bool Next(std::string_view &line) {
+      if (m_pos == m_end) return false;
+      const char *begin = m_pos;
+      const char *end = static_cast<const char *>(
+          std::memchr(begin, '\n', size_t(m_end - begin)));
+      m_pos = end ? end + 1 : m_end;
+      if (!end) end = m_end;
+      if (end != begin && end[-1] == '\r') --end;
+      line = std::string_view(begin, size_t(end - begin));
+      ++m_line;
+      return true;
+    }
+
+    //! \brief Number of lines read so far.
+    size_t GetLineNumber() const { return m_line; }
+
+    //! \brief Path of the file being read.
+    const std::string &GetPath() const { return m_file.GetPath(); }
+
+    //! \brief Path and current line number, for error messages.
+    std::string GetLocation() const;
+
+  private:
+    MappedFile m_file;
+    const char *m_pos = nullptr;
+    const char *m_end = nullptr;
+    size_t m_line = 0;
+  };
+
+  //! \brief Remove leading and trailing whitespace.
+  std::string_view Trim(std::string_view s);
+
+  //! \brief Remove everything from the first \p comment character onwards.
+  std::string_view StripComment(std::string_view s, char comment);
+
+  /*! \brief Characters [begin, end) of a line.
+   *  \details Clamped to the length of the line, so short lines give short or
+   *  empty fields rather than an error, as with fixed column formats. */
+  inline std::string_view Columns(std::string_view s, size_t begin,
+                                  size_t end) {
+    if (begin >= s.size()) return {};
+    return s.substr(begin, end - begin);
+  }
+
+  /*! \brief Split a line into whitespace separated tokens.
+   *  \param line the line to split.
+   *  \param[out] tokens views of the tokens, replacing any existing content.
+   *  \return the number of tokens. */
+  size_t Split(std::string_view line, std::vector<std::string_view> &tokens);
+
+  /*! \brief Parse an integer.
+   *  \details Surrounding whitespace is ignored and a leading sign accepted.
+   *  Anything else in the field is an error.
+   *  \return false if the field is not an integer. */
+  bool ParseInt(std::string_view s, int64_t &value);
+
+  /*! \brief Parse a floating point number.
+   *  \details As for ParseInt. Exponents, infinities and NaN are accepted.
+   *  \return false if the field is not a number. */
+  bool ParseReal(std::string_view s, double &value);
+
+} // namespace indigox::utils
+
+#endif /* INDIGOX_UTILS_LINE_READER_HPP */
@@ -0,0 +1,61 @@
+/*! \file mapped_file.hpp */
+#ifndef INDIGOX_UTILS_MAPPED_FILE_HPP
+#define INDIGOX_UTILS_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace indigox::utils {
+
+  /*! \brief Read only memory mapping of a whole file.
+   *  \details The file is mapped on construction and unmapped on destruction,
+   *  so pages are only read from disk when they are first accessed. On
+   *  platforms without mmap the file is read into memory instead. Mapped data
+   *  starts on a page boundary, and read data is at least aligned for
+   *  doubles. */
+  class MappedFile {
+  public:
+    //! \brief Construct with no file.
+    MappedFile() = default;
+
+    /*! \brief Map a file.
+     *  \param path the file to map.
+     *  \throws std::runtime_error if the file cannot be opened or mapped. */
+    explicit MappedFile(const std::string &path);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    ~MappedFile();
+
+    //! \brief Start of the file contents, null if no file is mapped.
+    const char *GetData() const { return m_data; }
+
+    //! \brief Number of bytes in the file.
+    size_t GetSize() const { return m_size; }
+
+    //! \brief Path of the mapped file.
+    const std::string &GetPath() const { return m_path; }
+
+    //! \brief If the contents are mapped rather than read into memory.
+    bool IsMapped() const { return m_mapped; }
+
+    operator bool() const { return m_data != nullptr; }
+
+  private:
+    void Release();
+
+  private:
+    std::string m_path;
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+    bool m_mapped = false;
+    //! \brief Contents when read rather than mapped.
+    std::vector<double> m_buffer;
+  };
+
+} // namespace indigox::utils
+
+#endif /* INDIGOX_UTILS_MAPPED_FILE_HPP */
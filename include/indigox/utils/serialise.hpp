@@ -77,4 +77,8 @@ namespace stdx {
 #define INDIGOX_IS_HUMAN_READABLE(archive_t)                                   \
   cereal::traits::is_text_archive<archive_t>::value
 
+// Versions of archived classes whose layout has changed. These must be seen
+// by every translation unit saving the class.
+INDIGOX_SERIALISE_VERSION(indigox::Forcefield, 1)
+
 #endif /* INDIGOX_UTILS_SERIALISE_HPP */
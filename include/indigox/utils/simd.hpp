@@ -0,0 +1,121 @@
+/*! \file simd.hpp */
+#ifndef INDIGOX_UTILS_SIMD_HPP
+#define INDIGOX_UTILS_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace indigox::simd {
+
+  /*! \brief Instruction set levels with a kernel backend.
+   *  \details Each backend is compiled for its own instruction set, so the
+   *  library itself does not require any extensions of the host. The widest
+   *  level supported by both the build and the running CPU is selected the
+   *  first time a kernel is called. */
+  enum class Level {
+    Scalar, //!< Portable C++, always available.
+    SSE42,  //!< 2 doubles per vector.
+    AVX2,   //!< 4 doubles per vector.
+    AVX512, //!< 8 doubles per vector.
+  };
+
+  /*! \brief The widest level supported by this build and CPU.
+   *  \details Determined from CPUID. If the INDIGOX_SIMD environment variable
+   *  is set to one of scalar, sse4.2, avx2 or avx512, the level is capped at
+   *  that value. */
+  Level DetectedLevel();
+
+  //! \brief The level of the kernels currently in use.
+  Level ActiveLevel();
+
+  /*! \brief Select the kernels to use.
+   *  \param level the level to use.
+   *  \throws std::runtime_error if the level is wider than DetectedLevel(). */
+  void SetLevel(Level level);
+
+  //! \brief Human readable name of a level.
+  std::string LevelName(Level level);
+
+  /*! \brief Squared distances and bond cutoffs from a point to many atoms.
+   *  \details For each of the \p n atoms, calculates the squared distance to
+   *  \p pos and the squared bond cutoff, (r[i] + radius)^2. If \p box is not
+   *  null, distances use the minimum image convention in an orthorhombic box
+   *  with lengths box[0..2].
+   *  \param x,y,z,r coordinates and radii of the atoms.
+   *  \param n number of atoms.
+   *  \param pos coordinates of the point.
+   *  \param radius radius of the point, including any tolerance.
+   *  \param box box lengths, or null when not periodic.
+   *  \param dist_sq,cutoff_sq output arrays of at least \p n values. */
+  void DistanceCheck(const double *x, const double *y, const double *z,
+                     const double *r, size_t n, const double *pos,
+                     double radius, const double *box, double *dist_sq,
+                     double *cutoff_sq);
+
+  //! \brief Separate x, y and z coordinate arrays of a set of points.
+  struct Points {
+    const double *x, *y, *z;
+  };
+
+  //! \brief Distances between each pair of points a[i] and b[i].
+  void Lengths(Points a, Points b, size_t n, double *out);
+
+  /*! \brief Components of the angles between points a[i], b[i] and c[i].
+   *  \details With u = a - b and v = c - b, calculates u.v and |u x v|. The
+   *  angle is atan2(cross, dot).
+   *  \param dot,cross output arrays of at least \p n values. */
+  void AngleComponents(Points a, Points b, Points c, size_t n, double *dot,
+                       double *cross);
+
+  /*! \brief Components of the torsions about points a[i] to d[i].
+   *  \details With b1 = b - a, b2 = c - b and b3 = d - c, calculates
+   *  x = (b1 x b2).(b2 x b3) and y = |b2| b1.(b2 x b3). The IUPAC signed
+   *  torsion angle is atan2(y, x).
+   *  \param x,y output arrays of at least \p n values. */
+  void TorsionComponents(Points a, Points b, Points c, Points d, size_t n,
+                         double *x, double *y);
+
+  //! \brief Harmonic energies, k[i] (value[i] - ideal[i])^2 / 2.
+  void HarmonicEnergies(const double *value, const double *ideal,
+                        const double *k, size_t n, double *out);
+
+  //! \brief Quartic energies, k[i] (value[i]^2 - ideal[i]^2)^2 / 4.
+  void QuarticEnergies(const double *value, const double *ideal,
+                       const double *k, size_t n, double *out);
+
+  //! \brief Sum of \p n values.
+  double Sum(const double *values, size_t n);
+
+  //! \brief Sum of squared deviations of \p n values from \p mean.
+  double SumSquaredDeviations(const double *values, size_t n, double mean);
+
+  /*! \brief Table of kernels provided by a backend.
+   *  \details Internal to the dispatch mechanism. Each backend translation
+   *  unit fills one of these from the templates in simd_kernels.hpp. */
+  struct Kernels {
+    Level level;
+    void (*distance_check)(const double *, const double *, const double *,
+                           const double *, size_t, const double *, double,
+                           const double *, double *, double *);
+    void (*lengths)(Points, Points, size_t, double *);
+    void (*angle_components)(Points, Points, Points, size_t, double *,
+                             double *);
+    void (*torsion_components)(Points, Points, Points, Points, size_t,
+                               double *, double *);
+    void (*harmonic_energies)(const double *, const double *, const double *,
+                              size_t, double *);
+    void (*quartic_energies)(const double *, const double *, const double *,
+                             size_t, double *);
+    double (*sum)(const double *, size_t);
+    double (*sum_squared_deviations)(const double *, size_t, double);
+  };
+
+  const Kernels &ScalarKernels();
+  const Kernels &SSE42Kernels();
+  const Kernels &AVX2Kernels();
+  const Kernels &AVX512Kernels();
+
+} // namespace indigox::simd
+
+#endif /* INDIGOX_UTILS_SIMD_HPP */
@@ -0,0 +1,233 @@
+/*! \file simd_kernels.hpp
+ *  \brief Kernel templates shared by the SIMD backends.
+ *  \details Only to be included by the backend translation units, after they
+ *  define their batch type. A batch type provides a register type \c reg,
+ *  the number of doubles per register \c width, and static load, store,
+ *  set1, add, sub, mul, div, sqrt, round and hsum functions. Everything here
+ *  is in an anonymous namespace, and only raw loops and intrinsics are used,
+ *  so no code compiled for a wider instruction set can be shared with code
+ *  compiled for a narrower one. */
+#ifndef INDIGOX_UTILS_SIMD_KERNELS_HPP
+#define INDIGOX_UTILS_SIMD_KERNELS_HPP
+
+#include "simd.hpp"
+
+#include <cmath>
+
+namespace indigox::simd {
+  namespace {
+
+    // One double at a time, used for the remainder of every kernel
+    struct ScalarBatch {
+      using reg = double;
+      static constexpr size_t width = 1;
+      static reg load(const double *p) { return *p; }
+      static void store(double *p, reg v) { *p = v; }
+      static reg set1(double v) { return v; }
+      static reg add(reg a, reg b) { return a + b; }
+      static reg sub(reg a, reg b) { return a - b; }
+      static reg mul(reg a, reg b) { return a * b; }
+      static reg div(reg a, reg b) { return a / b; }
+      static reg sqrt(reg a) { return std::sqrt(a); }
+      static reg round(reg a) { return std::nearbyint(a); }
+      static double hsum(reg a) { return a; }
+    };
+
+    template <class B>
+    size_t DistanceCheckRange(const double *x, const double *y,
+                              const double *z, const double *r, size_t begin,
+                              size_t n, const double *pos, double radius,
+                              const double *box, double *dist_sq,
+                              double *cutoff_sq) {
+      using reg = typename B::reg;
+      reg px = B::set1(pos[0]), py = B::set1(pos[1]), pz = B::set1(pos[2]);
+      reg ra = B::set1(radius);
+      reg bx = B::set1(box ? box[0] : 0.), ibx = B::set1(box ? 1 / box[0] : 0.);
+      reg by = B::set1(box ? box[1] : 0.), iby = B::set1(box ? 1 / box[1] : 0.);
+      reg bz = B::set1(box ? box[2] : 0.), ibz = B::set1(box ? 1 / box[2] : 0.);
+      size_t i = begin;
+      for (; i + B::width <= n; i += B::width) {
+        reg dx = B::sub(B::load(x + i), px);
+        reg dy = B::sub(B::load(y + i), py);
+        reg dz = B::sub(B::load(z + i), pz);
+        // Minimum image. A no-op when not periodic.
+        dx = B::sub(dx, B::mul(bx, B::round(B::mul(dx, ibx))));
+        dy = B::sub(dy, B::mul(by, B::round(B::mul(dy, iby))));
+        dz = B::sub(dz, B::mul(bz, B::round(B::mul(dz, ibz))));
+        reg d = B::add(B::mul(dx, dx), B::add(B::mul(dy, dy), B::mul(dz, dz)));
+        reg c = B::add(B::load(r + i), ra);
+        B::store(dist_sq + i, d);
+        B::store(cutoff_sq + i, B::mul(c, c));
+      }
+      return i;
+    }
+
+    template <class B>
+    void DistanceCheckKernel(const double *x, const double *y, const double *z,
+                             const double *r, size_t n, const double *pos,
+                             double radius, const double *box, double *dist_sq,
+                             double *cutoff_sq) {
+      size_t i = DistanceCheckRange<B>(x, y, z, r, 0, n, pos, radius, box,
+                                       dist_sq, cutoff_sq);
+      DistanceCheckRange<ScalarBatch>(x, y, z, r, i, n, pos, radius, box,
+                                      dist_sq, cutoff_sq);
+    }
+
+    // Geometry kernels process [begin, n) in whole batches and return where
+    // they stopped, so the remainder can be finished with ScalarBatch.
+
+    template <class B> struct Vec3 {
+      typename B::reg x, y, z;
+    };
+
+    template <class B> Vec3<B> LoadSub(Points a, Points b, size_t i) {
+      return {B::sub(B::load(a.x + i), B::load(b.x + i)),
+              B::sub(B::load(a.y + i), B::load(b.y + i)),
+              B::sub(B::load(a.z + i), B::load(b.z + i))};
+    }
+
+    template <class B>
+    typename B::reg Dot(const Vec3<B> &a, const Vec3<B> &b) {
+      return B::add(B::mul(a.x, b.x),
+                    B::add(B::mul(a.y, b.y), B::mul(a.z, b.z)));
+    }
+
+    template <class B> Vec3<B> Cross(const Vec3<B> &a, const Vec3<B> &b) {
+      return {B::sub(B::mul(a.y, b.z), B::mul(a.z, b.y)),
+              B::sub(B::mul(a.z, b.x), B::mul(a.x, b.z)),
+              B::sub(B::mul(a.x, b.y), B::mul(a.y, b.x))};
+    }
+
+    template <class B>
+    size_t LengthsRange(Points a, Points b, size_t i, size_t n, double *out) {
+      for (; i + B::width <= n; i += B::width) {
+        Vec3<B> d = LoadSub<B>(a, b, i);
+        B::store(out + i, B::sqrt(Dot<B>(d, d)));
+      }
+      return i;
+    }
+
+    template <class B>
+    size_t AngleRange(Points a, Points b, Points c, size_t i, size_t n,
+                      double *dot, double *cross) {
+      for (; i + B::width <= n; i += B::width) {
+        Vec3<B> u = LoadSub<B>(a, b, i), v = LoadSub<B>(c, b, i);
+        Vec3<B> w = Cross<B>(u, v);
+        B::store(dot + i, Dot<B>(u, v));
+        B::store(cross + i, B::sqrt(Dot<B>(w, w)));
+      }
+      return i;
+    }
+
+    template <class B>
+    size_t TorsionRange(Points a, Points b, Points c, Points d, size_t i,
+                        size_t n, double *x, double *y) {
+      for (; i + B::width <= n; i += B::width) {
+        Vec3<B> b1 = LoadSub<B>(b, a, i), b2 = LoadSub<B>(c, b, i),
+                b3 = LoadSub<B>(d, c, i);
+        Vec3<B> n1 = Cross<B>(b1, b2), n2 = Cross<B>(b2, b3);
+        B::store(x + i, Dot<B>(n1, n2));
+        B::store(y + i, B::mul(B::sqrt(Dot<B>(b2, b2)), Dot<B>(b1, n2)));
+      }
+      return i;
+    }
+
+    template <class B>
+    size_t HarmonicRange(const double *v, const double *v0, const double *k,
+                         size_t i, size_t n, double *out) {
+      typename B::reg half = B::set1(0.5);
+      for (; i + B::width <= n; i += B::width) {
+        typename B::reg d = B::sub(B::load(v + i), B::load(v0 + i));
+        B::store(out + i, B::mul(B::mul(half, B::load(k + i)), B::mul(d, d)));
+      }
+      return i;
+    }
+
+    template <class B>
+    size_t QuarticRange(const double *v, const double *v0, const double *k,
+                        size_t i, size_t n, double *out) {
+      typename B::reg quarter = B::set1(0.25);
+      for (; i + B::width <= n; i += B::width) {
+        typename B::reg x = B::load(v + i), x0 = B::load(v0 + i);
+        typename B::reg d = B::sub(B::mul(x, x), B::mul(x0, x0));
+        B::store(out + i,
+                 B::mul(B::mul(quarter, B::load(k + i)), B::mul(d, d)));
+      }
+      return i;
+    }
+
+    template <class B>
+    void LengthsKernel(Points a, Points b, size_t n, double *out) {
+      LengthsRange<ScalarBatch>(a, b, LengthsRange<B>(a, b, 0, n, out), n,
+                                out);
+    }
+
+    template <class B>
+    void AngleKernel(Points a, Points b, Points c, size_t n, double *dot,
+                     double *cross) {
+      size_t i = AngleRange<B>(a, b, c, 0, n, dot, cross);
+      AngleRange<ScalarBatch>(a, b, c, i, n, dot, cross);
+    }
+
+    template <class B>
+    void TorsionKernel(Points a, Points b, Points c, Points d, size_t n,
+                       double *x, double *y) {
+      size_t i = TorsionRange<B>(a, b, c, d, 0, n, x, y);
+      TorsionRange<ScalarBatch>(a, b, c, d, i, n, x, y);
+    }
+
+    template <class B>
+    void HarmonicKernel(const double *v, const double *v0, const double *k,
+                        size_t n, double *out) {
+      size_t i = HarmonicRange<B>(v, v0, k, 0, n, out);
+      HarmonicRange<ScalarBatch>(v, v0, k, i, n, out);
+    }
+
+    template <class B>
+    void QuarticKernel(const double *v, const double *v0, const double *k,
+                       size_t n, double *out) {
+      size_t i = QuarticRange<B>(v, v0, k, 0, n, out);
+      QuarticRange<ScalarBatch>(v, v0, k, i, n, out);
+    }
+
+    template <class B> double SumKernel(const double *v, size_t n) {
+      typename B::reg acc = B::set1(0.);
+      size_t i = 0;
+      for (; i + B::width <= n; i += B::width)
+        acc = B::add(acc, B::load(v + i));
+      double sum = B::hsum(acc);
+      for (; i < n; ++i) sum += v[i];
+      return sum;
+    }
+
+    template <class B>
+    double SumSquaredDeviationsKernel(const double *v, size_t n, double mean) {
+      typename B::reg acc = B::set1(0.), m = B::set1(mean);
+      size_t i = 0;
+      for (; i + B::width <= n; i += B::width) {
+        typename B::reg d = B::sub(B::load(v + i), m);
+        acc = B::add(acc, B::mul(d, d));
+      }
+      double sum = B::hsum(acc);
+      for (; i < n; ++i) sum += (v[i] - mean) * (v[i] - mean);
+      return sum;
+    }
+
+    template <class B> Kernels MakeKernels(Level level) {
+      Kernels k;
+      k.level = level;
+      k.distance_check = &DistanceCheckKernel<B>;
+      k.lengths = &LengthsKernel<B>;
+      k.angle_components = &AngleKernel<B>;
+      k.torsion_components = &TorsionKernel<B>;
+      k.harmonic_energies = &HarmonicKernel<B>;
+      k.quartic_energies = &QuarticKernel<B>;
+      k.sum = &SumKernel<B>;
+      k.sum_squared_deviations = &SumSquaredDeviationsKernel<B>;
+      return k;
+    }
+
+  } // namespace
+} // namespace indigox::simd
+
+#endif /* INDIGOX_UTILS_SIMD_KERNELS_HPP */
@@ -1,4 +1,5 @@
 #include <indigox/algorithm/cherrypicker.hpp>
+#include <indigox/algorithm/graph/canonical.hpp>
 #include <indigox/algorithm/graph/isomorphism.hpp>
 #include <indigox/classes/angle.hpp>
 #include <indigox/classes/athenaeum.hpp>
@@ -9,6 +10,7 @@
 #include <indigox/classes/parameterised.hpp>
 #include <indigox/graph/condensed.hpp>
 #include <indigox/graph/molecular.hpp>
+#include <indigox/io/athenaeum_snapshot.hpp>
 #include <indigox/utils/combinatronics.hpp>
 
 #include <rilib/RI.h>
@@ -17,7 +19,10 @@
 #include <indigo-bondorder/indigo-bondorder.hpp>
 
 #include <algorithm>
+#include <array>
 #include <map>
+#include <numeric>
+#include <set>
 #include <vector>
 
 namespace indigox::algorithm {
@@ -41,10 +46,12 @@ namespace indigox::algorithm {
     SetBool(CPSet::AllowDanglingAngles);
     SetBool(CPSet::AllowDanglingDihedrals);
     SetBool(CPSet::UseRISubgraphMatching);
+    SetBool(CPSet::UseSymmetryReduction);
 
     SetInt(CPSet::MinimumFragmentSize, 4);
     SetInt(CPSet::MaximumFragmentSize, -1);
     SetInt(CPSet::ElectronMethod, 2); // Default to FPT for high accuracy and speed
+    SetInt(CPSet::SymmetryGroupLimit, 5000);
   }
 
   bool CherryPicker::GetBool(CPSet param) {
@@ -82,13 +89,38 @@ namespace indigox::algorithm {
   bool CherryPicker::AddAthenaeum(Athenaeum &library) {
     std::cout << "Adding new Athenaeum..." << std::endl;
     if (library.GetForcefield() != _ff) return false;
-    _libs.push_back(library);
+    // Angles and dihedrals of the source molecules are looked up while
+    // parameterising, so perceive them now to keep that read only.
+    for (auto &mol_frags : library.GetFragments()) {
+      Molecule mol = mol_frags.first;
+      mol.PerceiveAngles();
+      mol.PerceiveDihedrals();
+    }
+    _libs.push_back({library, {}});
+    return true;
+  }
+
+  bool CherryPicker::AddAthenaeum(io::AthenaeumSnapshot &library) {
+    std::cout << "Adding new Athenaeum snapshot..." << std::endl;
+    if (library.GetForcefield() != _ff) return false;
+    _libs.push_back({{}, library});
     return true;
   }
 
   bool CherryPicker::RemoveAthenaeum(Athenaeum &library) {
     std::cout << "Removing Athenaeum..." << std::endl;
-    auto pos = std::find(_libs.begin(), _libs.end(), library);
+    auto pos = std::find_if(_libs.begin(), _libs.end(), [&library](auto &lib) {
+      return lib.athenaeum == library;
+    });
+    if (pos != _libs.end()) _libs.erase(pos);
+    return pos != _libs.end();
+  }
+
+  bool CherryPicker::RemoveAthenaeum(io::AthenaeumSnapshot &library) {
+    std::cout << "Removing Athenaeum snapshot..." << std::endl;
+    auto pos = std::find_if(_libs.begin(), _libs.end(), [&library](auto &lib) {
+      return lib.snapshot == library;
+    });
     if (pos != _libs.end()) _libs.erase(pos);
     return pos != _libs.end();
   }
@@ -99,6 +131,17 @@ namespace indigox::algorithm {
   using U = graph::Undirected;
   using GL = graph::GraphLabel;
 
+  // Target molecule data shared by all fragment matches. Atoms are indexed by
+  // their position in the target MolecularGraph, and each automorphism of the
+  // target CMG is lifted to a permutation of those indices.
+  struct TargetSymmetry {
+    std::vector<Atom> atoms;
+    eastl::vector_map<graph::MGVertex, uint32_t> atom_index;
+    eastl::vector_map<CMGV, uint32_t> vertex_index;
+    std::vector<Permutation> group;
+    std::vector<Permutation> atom_perms;
+  };
+
   struct CherryPickerCallback : public CMGCallback {
     using GraphType = graph::CondensedMolecularGraph;
     using BaseType = CMGCallback;
@@ -107,6 +150,16 @@ namespace indigox::algorithm {
     using VertMasks = eastl::vector_map<CMGV, graph::VertexIsoMask>;
     using EdgeMasks = eastl::vector_map<CMGE, graph::EdgeIsoMask>;
 
+    // Parameters found from a single mapping. Target atoms are stored as
+    // indices into TargetSymmetry::atoms so that the evidence can be applied
+    // to any symmetry equivalent mapping.
+    struct Evidence {
+      std::vector<std::pair<uint32_t, Atom>> atoms;
+      std::vector<std::pair<std::array<uint32_t, 2>, Bond>> bonds;
+      std::vector<std::pair<std::array<uint32_t, 3>, Angle>> angles;
+      std::vector<std::pair<std::array<uint32_t, 4>, Dihedral>> dihedrals;
+    };
+
     CherryPicker &cherrypicker;
     GraphType small;
     GraphType large;
@@ -116,24 +169,29 @@ namespace indigox::algorithm {
     EdgeMasks emasks_small;
     ParamMolecule pmol;
     Fragment frag;
+    TargetSymmetry &symmetry;
     bool has_mapping;
+    bool expand_symmetry;
 
     CherryPickerCallback(CherryPicker &cp, GraphType &l, VertMasks &vl,
                          EdgeMasks &el, ParamMolecule &p, Fragment &f,
                          graph::VertexIsoMask vertmask,
-                         graph::EdgeIsoMask edgemask)
+                         graph::EdgeIsoMask edgemask, TargetSymmetry &sym,
+                         bool expand)
         : cherrypicker(cp), small(f.GetGraph()), large(l), vmasks_large(vl),
-          emasks_large(el), pmol(p), frag(f), has_mapping(false) {
+          emasks_large(el), pmol(p), frag(f), symmetry(sym),
+          has_mapping(false), expand_symmetry(expand) {
       for (CMGV v : small.GetVertices())
         vmasks_small.emplace(v, v.GetIsomorphismMask() & vertmask);
       for (CMGE e : small.GetEdges())
         emasks_small.emplace(e, e.GetIsomorphismMask() & edgemask);
     }
 
-    bool operator()(const CorrespondenceMap &map) override {
+    Evidence Collect(const CorrespondenceMap &map) {
       using ConSym = graph::CMGVertex::ContractedSymmetry;
-      has_mapping = true;
-      std::vector<graph::MGVertex> frag_v, target_v;
+      Evidence evidence;
+      std::vector<graph::MGVertex> frag_v;
+      std::vector<uint32_t> target_v;
       graph::CondensedMolecularGraph G = frag.GetGraph();
       graph::MolecularGraph molG = G.GetSuperGraph().GetMolecularGraph();
       Molecule fragMol = molG.GetMolecule();
@@ -142,7 +200,8 @@ namespace indigox::algorithm {
       std::vector<std::pair<size_t, size_t>> regions;
       for (auto &frag2target : map) {
         frag_v.emplace_back(frag2target.first.GetSource());
-        target_v.emplace_back(frag2target.second.GetSource());
+        target_v.emplace_back(
+            symmetry.atom_index.at(frag2target.second.GetSource()));
         size_t begin_size = frag_v.size();
         ConSym currentSym = ConSym::Hydrogen;
         for (auto &cv : frag2target.first.GetCondensedVertices()) {
@@ -154,7 +213,7 @@ namespace indigox::algorithm {
           frag_v.emplace_back(cv.second);
         }
         for (auto &cv : frag2target.second.GetContractedVertices())
-          target_v.emplace_back(cv);
+          target_v.emplace_back(symmetry.atom_index.at(cv));
         regions.emplace_back(begin_size, frag_v.size());
       }
 
@@ -165,14 +224,18 @@ namespace indigox::algorithm {
                               frag_v.begin() + be.second);
       }
 
+      auto target_of = [&frag_v, &target_v](const graph::MGVertex &v) {
+        auto p = std::find(frag_v.begin(), frag_v.end(), v);
+        return target_v[std::distance(frag_v.begin(), p)];
+      };
+
       while (permutation()) {
         // Parameterise the atoms
         auto patms = frag.GetAtoms();
         for (size_t i = 0; i < frag_v.size(); ++i) {
           if (std::find(patms.begin(), patms.end(), frag_v[i]) == patms.end())
             continue;
-          ParamAtom patm = pmol.GetAtom(target_v[i].GetAtom());
-          patm.MappedWith(frag_v[i].GetAtom());
+          evidence.atoms.emplace_back(target_v[i], frag_v[i].GetAtom());
         }
 
         // Parameterise the bonds
@@ -182,12 +245,9 @@ namespace indigox::algorithm {
               (std::find(patms.begin(), patms.end(), v1) == patms.end() ||
                std::find(patms.begin(), patms.end(), v2) == patms.end()))
             break;
-          auto p1 = std::find(frag_v.begin(), frag_v.end(), v1);
-          auto p2 = std::find(frag_v.begin(), frag_v.end(), v2);
-          Atom t1 = target_v[std::distance(frag_v.begin(), p1)].GetAtom();
-          Atom t2 = target_v[std::distance(frag_v.begin(), p2)].GetAtom();
-          ParamBond pbnd = pmol.GetBond(t1, t2);
-          pbnd.MappedWith(fragMol.GetBond(v1.GetAtom(), v2.GetAtom()));
+          evidence.bonds.emplace_back(
+              std::array<uint32_t, 2>{target_of(v1), target_of(v2)},
+              fragMol.GetBond(v1.GetAtom(), v2.GetAtom()));
         }
 
         // Parameterise the angles
@@ -198,14 +258,9 @@ namespace indigox::algorithm {
                std::find(patms.begin(), patms.end(), v2) == patms.end() ||
                std::find(patms.begin(), patms.end(), v3) == patms.end()))
             break;
-          auto p1 = std::find(frag_v.begin(), frag_v.end(), v1);
-          auto p2 = std::find(frag_v.begin(), frag_v.end(), v2);
-          auto p3 = std::find(frag_v.begin(), frag_v.end(), v3);
-          Atom t1 = target_v[std::distance(frag_v.begin(), p1)].GetAtom();
-          Atom t2 = target_v[std::distance(frag_v.begin(), p2)].GetAtom();
-          Atom t3 = target_v[std::distance(frag_v.begin(), p3)].GetAtom();
-          ParamAngle pang = pmol.GetAngle(t1, t2, t3);
-          pang.MappedWith(
+          evidence.angles.emplace_back(
+              std::array<uint32_t, 3>{target_of(v1), target_of(v2),
+                                      target_of(v3)},
               fragMol.GetAngle(v1.GetAtom(), v2.GetAtom(), v3.GetAtom()));
         }
 
@@ -219,21 +274,65 @@ namespace indigox::algorithm {
                std::find(patms.begin(), patms.end(), v3) == patms.end() ||
                std::find(patms.begin(), patms.end(), v4) == patms.end()))
             break;
-          auto p1 = std::find(frag_v.begin(), frag_v.end(), v1);
-          auto p2 = std::find(frag_v.begin(), frag_v.end(), v2);
-          auto p3 = std::find(frag_v.begin(), frag_v.end(), v3);
-          auto p4 = std::find(frag_v.begin(), frag_v.end(), v4);
-          Atom t1 = target_v[std::distance(frag_v.begin(), p1)].GetAtom();
-          Atom t2 = target_v[std::distance(frag_v.begin(), p2)].GetAtom();
-          Atom t3 = target_v[std::distance(frag_v.begin(), p3)].GetAtom();
-          Atom t4 = target_v[std::distance(frag_v.begin(), p4)].GetAtom();
-          ParamDihedral pdhd = pmol.GetDihedral(t1, t2, t3, t4);
-          pdhd.MappedWith(fragMol.GetDihedral(v1.GetAtom(), v2.GetAtom(),
-                                              v3.GetAtom(), v4.GetAtom()));
+          evidence.dihedrals.emplace_back(
+              std::array<uint32_t, 4>{target_of(v1), target_of(v2),
+                                      target_of(v3), target_of(v4)},
+              fragMol.GetDihedral(v1.GetAtom(), v2.GetAtom(), v3.GetAtom(),
+                                  v4.GetAtom()));
         }
         if (!cherrypicker.GetBool(CPSet::ParameteriseFromAllPermutations))
           break;
       }
+      return evidence;
+    }
+
+    // Apply evidence with the target atoms permuted by perm, or unpermuted
+    // if perm is null.
+    void Apply(const Evidence &evidence, const Permutation *perm) {
+      auto target = [this, perm](uint32_t i) -> const Atom & {
+        return symmetry.atoms[perm ? (*perm)[i] : i];
+      };
+      for (auto &atm : evidence.atoms) {
+        ParamAtom patm = pmol.GetAtom(target(atm.first));
+        patm.MappedWith(atm.second);
+      }
+      for (auto &bnd : evidence.bonds) {
+        ParamBond pbnd =
+            pmol.GetBond(target(bnd.first[0]), target(bnd.first[1]));
+        pbnd.MappedWith(bnd.second);
+      }
+      for (auto &ang : evidence.angles) {
+        ParamAngle pang = pmol.GetAngle(
+            target(ang.first[0]), target(ang.first[1]), target(ang.first[2]));
+        pang.MappedWith(ang.second);
+      }
+      for (auto &dhd : evidence.dihedrals) {
+        ParamDihedral pdhd =
+            pmol.GetDihedral(target(dhd.first[0]), target(dhd.first[1]),
+                             target(dhd.first[2]), target(dhd.first[3]));
+        pdhd.MappedWith(dhd.second);
+      }
+    }
+
+    bool operator()(const CorrespondenceMap &map) override {
+      has_mapping = true;
+      Evidence evidence = Collect(map);
+      if (!expand_symmetry) {
+        Apply(evidence, nullptr);
+        return true;
+      }
+      // Map is an orbit representative, so apply to each distinct image of it
+      // under the target automorphisms.
+      std::set<std::vector<uint32_t>> images;
+      for (size_t g = 0; g < symmetry.group.size(); ++g) {
+        std::vector<uint32_t> image;
+        image.reserve(map.size());
+        for (auto &frag2target : map)
+          image.push_back(
+              symmetry.group[g][symmetry.vertex_index.at(frag2target.second)]);
+        if (!images.insert(image).second) continue;
+        Apply(evidence, &symmetry.atom_perms[g]);
+      }
       return true;
     }
 
@@ -259,6 +358,55 @@ namespace indigox::algorithm {
     }
   };
 
+  // Lift the automorphisms of the target CMG to permutations of the target
+  // atoms, pairing contracted vertices in the same order as the callback.
+  void BuildTargetSymmetry(graph::MolecularGraph &G,
+                           graph::CondensedMolecularGraph &CMG,
+                           graph::VertexIsoMask vertmask,
+                           graph::EdgeIsoMask edgemask, size_t limit,
+                           TargetSymmetry &symmetry) {
+    const auto &mg_v = G.GetVertices();
+    symmetry.atoms.reserve(mg_v.size());
+    for (uint32_t i = 0; i < mg_v.size(); ++i) {
+      symmetry.atoms.emplace_back(mg_v[i].GetAtom());
+      symmetry.atom_index.emplace(mg_v[i], i);
+    }
+    const auto &cmg_v = CMG.GetVertices();
+    std::vector<std::vector<uint32_t>> expanded(cmg_v.size());
+    for (uint32_t i = 0; i < cmg_v.size(); ++i) {
+      symmetry.vertex_index.emplace(cmg_v[i], i);
+      expanded[i].push_back(symmetry.atom_index.at(cmg_v[i].GetSource()));
+      for (auto &cv : cmg_v[i].GetContractedVertices())
+        expanded[i].push_back(symmetry.atom_index.at(cv));
+    }
+    if (!limit) return;
+
+    // Always distinguish condensed counts so lifted permutations exist
+    graph::VertexIsoMask condensed;
+    condensed.from_uint64(0x1C03FFF800);
+    symmetry.group =
+        AutomorphismGroup(CMG, vertmask | condensed, edgemask, limit);
+    if (symmetry.group.size() < 2) {
+      symmetry.group.clear();
+      return;
+    }
+
+    for (const Permutation &g : symmetry.group) {
+      Permutation lifted(symmetry.atoms.size());
+      std::iota(lifted.begin(), lifted.end(), 0);
+      for (uint32_t k = 0; k < expanded.size(); ++k) {
+        if (expanded[k].size() != expanded[g[k]].size()) {
+          symmetry.group.clear();
+          symmetry.atom_perms.clear();
+          return;
+        }
+        for (size_t i = 0; i < expanded[k].size(); ++i)
+          lifted[expanded[k][i]] = expanded[g[k]][i];
+      }
+      symmetry.atom_perms.emplace_back(std::move(lifted));
+    }
+  }
+
   ParamMolecule CherryPicker::ParameteriseMolecule(Molecule &mol) {
     std::cout << "Parameterising molecule " << mol.GetName() << "." << std::endl;
 
@@ -316,20 +464,99 @@ namespace indigox::algorithm {
     for (CMGE e : CMG.GetEdges())
       emasks.emplace(e, edgemask & e.GetIsomorphismMask());
 
+    TargetSymmetry symmetry;
+    size_t group_limit = 0;
+    if (GetBool(CPSet::UseSymmetryReduction) &&
+        GetInt(CPSet::SymmetryGroupLimit) > 0)
+      group_limit = GetInt(CPSet::SymmetryGroupLimit);
+    BuildTargetSymmetry(G, CMG, vertmask, edgemask, group_limit, symmetry);
+    bool use_symmetry = !symmetry.group.empty();
+
     std::unique_ptr<rilib::Graph> CMG_ri;
-    if (GetBool(CPSet::UseRISubgraphMatching))
+    if (!use_symmetry && GetBool(CPSet::UseRISubgraphMatching))
       CMG_ri = CMGToRIGraph(CMG, edgemask, vertmask);
 
     // Run the matching
+    int64_t charge_rounding = 1000;
     if (GetInt(CPSet::ChargeRounding) > 3) {
-      ParamMolecule::charge_rounding = 1;
+      charge_rounding = 1;
       for (int32_t i = 0; i < GetInt(CPSet::ChargeRounding); ++i)
-        ParamMolecule::charge_rounding *= 10;
-    } else {
-      ParamMolecule::charge_rounding = 1000;
+        charge_rounding *= 10;
     }
-    for (Athenaeum &lib : _libs) {
-      for (auto &g_frag : lib.GetFragments()) {
+    pmol.SetChargeRounding(charge_rounding);
+    // Match a fragment, returning if any mapping was found
+    auto match_fragment = [&](Fragment frag) {
+      CherryPickerCallback callback(*this, CMG, vmasks, emasks, pmol, frag,
+                                    vertmask, edgemask, symmetry,
+                                    use_symmetry);
+      graph::CondensedMolecularGraph FG = frag.GetGraph();
+
+      if (use_symmetry) {
+        SubgraphIsomorphisms(FG, CMG, vertmask, edgemask, symmetry.group,
+                             callback);
+      } else if (!GetBool(CPSet::UseRISubgraphMatching)) {
+        SubgraphIsomorphisms(FG, CMG, callback);
+      } else {
+        std::unique_ptr<rilib::Graph> FG_ri = CMGToRIGraph(FG, edgemask, vertmask);
+        std::unique_ptr<rilib::AttributeComparator> vert_compare = std::make_unique<Uint64AttrComparator>();
+        std::unique_ptr<rilib::AttributeComparator> edge_compare = std::make_unique<Uint32AttrComparator>();
+        std::unique_ptr<rilib::MatchListener> listener = std::make_unique<RICherryPickerMatcher>(callback);
+        std::unique_ptr<rilib::MaMaConstrFirst> mama = std::make_unique<rilib::MaMaConstrFirst>(*FG_ri);
+        mama->build(*FG_ri);
+        long tmp_1, tmp_2, tmp_3;
+        // run the matching
+        rilib::match(*CMG_ri, *FG_ri, *mama, *listener,
+                     rilib::MATCH_TYPE::MT_INDSUB, *vert_compare,
+                     *edge_compare, &tmp_1, &tmp_2, &tmp_3);
+      }
+      return callback.has_mapping;
+    };
+
+    // Masked vertex labels of the target, sorted so that a snapshot fragment
+    // with more of a label than the target cannot match and is not loaded
+    uint64_t label_mask = vertmask.to_uint64();
+    std::vector<uint64_t> target_labels, frag_labels;
+    for (CMGV v : CMG.GetVertices())
+      target_labels.push_back(v.GetIsomorphismMask().to_uint64() & label_mask);
+    std::sort(target_labels.begin(), target_labels.end());
+
+    for (Library &lib : _libs) {
+      if (lib.snapshot) {
+        io::AthenaeumSnapshot &snap = lib.snapshot;
+        for (size_t m = 0; m < snap.NumMolecules(); ++m) {
+          boost::dynamic_bitset<> fragments(snap.NumFragments(m));
+          fragments.set();
+          for (size_t pos = 0; pos < fragments.size();
+               pos = fragments.find_next(pos)) {
+            io::AthenaeumSnapshot::FragmentView view =
+                snap.GetFragmentView(m, pos);
+            if ((int32_t)view.size < GetInt(CPSet::MinimumFragmentSize))
+              continue;
+            if (GetInt(CPSet::MaximumFragmentSize) > 0 &&
+                (int32_t)view.size > GetInt(CPSet::MaximumFragmentSize))
+              continue;
+            if (int64_t(view.num_vertices) > CMG.NumVertices()) continue;
+            frag_labels.assign(view.labels, view.labels + view.num_vertices);
+            for (uint64_t &label : frag_labels) label &= label_mask;
+            std::sort(frag_labels.begin(), frag_labels.end());
+            bool matched =
+                int64_t(view.num_edges) <= CMG.NumEdges() &&
+                std::includes(target_labels.begin(), target_labels.end(),
+                              frag_labels.begin(), frag_labels.end()) &&
+                match_fragment(snap.GetFragments(m)[pos]);
+            if (matched) continue;
+            for (size_t i = 0; i < fragments.size(); ++i) {
+              if ((view.supersets[i / 64] >> (i % 64)) & 1) fragments.reset(i);
+            }
+          }
+        }
+        using ATSet = Athenaeum::Settings;
+        pmol.ApplyParameteristion(snap.GetBool(ATSet::SelfConsistent));
+        continue;
+      }
+
+      Athenaeum &ath = lib.athenaeum;
+      for (auto &g_frag : ath.GetFragments()) {
         // Initially all fragments are to be searched
         boost::dynamic_bitset<> fragments(g_frag.second.size());
         fragments.set();
@@ -342,30 +569,11 @@ namespace indigox::algorithm {
               (int32_t)frag.Size() > GetInt(CPSet::MaximumFragmentSize))
             continue;
           if (frag.GetGraph().NumVertices() > CMG.NumVertices()) continue;
-          CherryPickerCallback callback(*this, CMG, vmasks, emasks, pmol, frag,
-                                        vertmask, edgemask);
-          graph::CondensedMolecularGraph FG = frag.GetGraph();
-
-          if (!GetBool(CPSet::UseRISubgraphMatching)) {
-            SubgraphIsomorphisms(FG, CMG, callback);
-          } else {
-            std::unique_ptr<rilib::Graph> FG_ri = CMGToRIGraph(FG, edgemask, vertmask);
-            std::unique_ptr<rilib::AttributeComparator> vert_compare = std::make_unique<Uint64AttrComparator>();
-            std::unique_ptr<rilib::AttributeComparator> edge_compare = std::make_unique<Uint32AttrComparator>();
-            std::unique_ptr<rilib::MatchListener> listener = std::make_unique<RICherryPickerMatcher>(callback);
-            std::unique_ptr<rilib::MaMaConstrFirst> mama = std::make_unique<rilib::MaMaConstrFirst>(*FG_ri);
-            mama->build(*FG_ri);
-            long tmp_1, tmp_2, tmp_3;
-            // run the matching
-            rilib::match(*CMG_ri, *FG_ri, *mama, *listener,
-                         rilib::MATCH_TYPE::MT_INDSUB, *vert_compare,
-                         *edge_compare, &tmp_1, &tmp_2, &tmp_3);
-          }
-          if (!callback.has_mapping) { fragments -= frag.GetSupersets(); }
+          if (!match_fragment(frag)) { fragments -= frag.GetSupersets(); }
         }
       }
       using ATSet = Athenaeum::Settings;
-      pmol.ApplyParameteristion(lib.GetBool(ATSet::SelfConsistent));
+      pmol.ApplyParameteristion(ath.GetBool(ATSet::SelfConsistent));
     }
     
     // Redistribute any excess charge, but only if all atoms have been mapped
@@ -386,7 +594,7 @@ namespace indigox::algorithm {
       double total_charge = 0.;
       for (Atom atm : mol.GetAtoms()) total_charge += atm.GetPartialCharge();
       double to_add = target_charge - total_charge;
-      uint64_t count = (uint64_t)abs(round(to_add * ParamMolecule::charge_rounding));
+      uint64_t count = (uint64_t)abs(round(to_add * charge_rounding));
       if (count && addable_atoms.empty()) {
         std::cout << "WARNING: Total charge does not match target charge but no atoms are available for charge redistribution.\n";
         return pmol;
@@ -394,13 +602,13 @@ namespace indigox::algorithm {
       if (abs(to_add) > 0.1) std::cout << "WARNING: CherryPicker redistributing a large charge imbalance: " << to_add << "\n";
       
       if (to_add < 0) {
-        double charge_delta = -1. / ParamMolecule::charge_rounding;
+        double charge_delta = -1. / charge_rounding;
         for (int64_t pos = 0; count; count -= 1, pos += 1) {
           if (pos == (int64_t)addable_atoms.size()) pos = 0;
           addable_atoms[pos].AddRedistributedCharge(charge_delta);
         }
       } else {
-        double charge_delta = 1. / ParamMolecule::charge_rounding;
+        double charge_delta = 1. / charge_rounding;
         for (int64_t pos = addable_atoms.size() - 1; count; count -= 1, pos -= 1) {
           if (!pos) pos = addable_atoms.size() - 1;
           addable_atoms[pos].AddRedistributedCharge(charge_delta);
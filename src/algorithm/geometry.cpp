@@ -0,0 +1,192 @@
+#include <indigox/algorithm/geometry.hpp>
+#include <indigox/classes/angle.hpp>
+#include <indigox/classes/atom.hpp>
+#include <indigox/classes/bond.hpp>
+#include <indigox/classes/dihedral.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/utils/atomic_coordinates.hpp>
+#include <indigox/utils/simd.hpp>
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace indigox::algorithm {
+
+  namespace {
+    const double unset = std::numeric_limits<double>::quiet_NaN();
+    const double pi = 3.14159265358979323846;
+    const double to_radians = pi / 180.;
+    const double to_degrees = 180. / pi;
+
+    // Coordinates of the N atoms of each term, gathered into contiguous
+    // arrays for the kernels.
+    template <size_t N> struct Gathered {
+      std::array<std::vector<double>, 3 * N> data;
+      std::array<simd::Points, N> points;
+    };
+
+    template <size_t N, class Terms>
+    void Gather(Molecule &mol, const CoordinateFrame &frame,
+                const Terms &terms, Gathered<N> &g) {
+      if (frame.size != mol.NumAtoms())
+        throw std::runtime_error("Frame has wrong number of atoms");
+      const double *xyz[3] = {frame.x, frame.y, frame.z};
+      for (std::vector<double> &v : g.data) v.resize(terms.size());
+      for (size_t i = 0; i < terms.size(); ++i) {
+        const auto &atoms = terms[i].GetAtoms();
+        for (size_t j = 0; j < N; ++j) {
+          int64_t idx = atoms[j].GetIndex();
+          for (size_t d = 0; d < 3; ++d) g.data[3 * j + d][i] = xyz[d][idx];
+        }
+      }
+      for (size_t j = 0; j < N; ++j)
+        g.points[j] = {g.data[3 * j].data(), g.data[3 * j + 1].data(),
+                       g.data[3 * j + 2].data()};
+    }
+
+    using EnergyKernel = void (*)(const double *, const double *,
+                                  const double *, size_t, double *);
+
+    // Terms sharing a functional form, with their kernel inputs
+    struct EnergyBatch {
+      std::vector<uint32_t> terms;
+      std::vector<double> value, ideal, k;
+
+      void Add(uint32_t term, double v, double v0, double kb) {
+        terms.push_back(term);
+        value.push_back(v);
+        ideal.push_back(v0);
+        k.push_back(kb);
+      }
+
+      // Calculate the energies and add them to those of the terms
+      void Apply(EnergyKernel kernel, std::vector<double> &energies) {
+        std::vector<double> out(terms.size());
+        kernel(value.data(), ideal.data(), k.data(), terms.size(), out.data());
+        for (size_t i = 0; i < terms.size(); ++i) {
+          double &e = energies[terms[i]];
+          e = std::isnan(e) ? out[i] : e + out[i];
+        }
+      }
+    };
+
+    TermGeometry Empty(size_t n) {
+      TermGeometry geom;
+      geom.values.assign(n, unset);
+      geom.ideals.assign(n, unset);
+      geom.energies.assign(n, unset);
+      return geom;
+    }
+  } // namespace
+
+  TermGeometry MeasureBonds(Molecule &mol) {
+    return MeasureBonds(mol, mol.GetAtomicCoordinates().Frame());
+  }
+
+  TermGeometry MeasureBonds(Molecule &mol, const CoordinateFrame &frame) {
+    const Molecule::MoleculeBonds &bonds = mol.GetBonds();
+    TermGeometry geom = Empty(bonds.size());
+    Gathered<2> g;
+    Gather(mol, frame, bonds, g);
+    simd::Lengths(g.points[0], g.points[1], bonds.size(), geom.values.data());
+
+    EnergyBatch harmonic, quartic;
+    for (uint32_t i = 0; i < bonds.size(); ++i) {
+      if (!bonds[i].HasType()) continue;
+      const FFBond &type = bonds[i].GetType();
+      EnergyBatch *batch = nullptr;
+      if (type.GetType() == BondType::Harmonic) batch = &harmonic;
+      if (type.GetType() == BondType::Quartic) batch = &quartic;
+      if (!batch) continue;
+      geom.ideals[i] = type.GetIdealLength();
+      batch->Add(i, geom.values[i], geom.ideals[i], type.GetForceConstant());
+    }
+    harmonic.Apply(&simd::HarmonicEnergies, geom.energies);
+    quartic.Apply(&simd::QuarticEnergies, geom.energies);
+    return geom;
+  }
+
+  TermGeometry MeasureAngles(Molecule &mol) {
+    return MeasureAngles(mol, mol.GetAtomicCoordinates().Frame());
+  }
+
+  TermGeometry MeasureAngles(Molecule &mol, const CoordinateFrame &frame) {
+    const Molecule::MoleculeAngles &angles = mol.GetAngles();
+    size_t n = angles.size();
+    TermGeometry geom = Empty(n);
+    Gathered<3> g;
+    Gather(mol, frame, angles, g);
+    std::vector<double> dot(n), cross(n);
+    simd::AngleComponents(g.points[0], g.points[1], g.points[2], n,
+                          dot.data(), cross.data());
+    for (size_t i = 0; i < n; ++i)
+      geom.values[i] = std::atan2(cross[i], dot[i]) * to_degrees;
+
+    EnergyBatch harmonic, cosine;
+    for (uint32_t i = 0; i < n; ++i) {
+      if (!angles[i].HasType()) continue;
+      const FFAngle &type = angles[i].GetType();
+      double theta = geom.values[i] * to_radians;
+      double k = type.GetForceConstant();
+      if (type.GetType() == AngleType::Harmonic) {
+        geom.ideals[i] = type.GetIdealAngle();
+        harmonic.Add(i, theta, geom.ideals[i] * to_radians, k);
+      } else if (type.GetType() == AngleType::CosineHarmonic) {
+        geom.ideals[i] = type.GetIdealAngle();
+        cosine.Add(i, std::cos(theta),
+                   std::cos(geom.ideals[i] * to_radians), k);
+      }
+    }
+    harmonic.Apply(&simd::HarmonicEnergies, geom.energies);
+    cosine.Apply(&simd::HarmonicEnergies, geom.energies);
+    return geom;
+  }
+
+  TermGeometry MeasureDihedrals(Molecule &mol) {
+    return MeasureDihedrals(mol, mol.GetAtomicCoordinates().Frame());
+  }
+
+  TermGeometry MeasureDihedrals(Molecule &mol, const CoordinateFrame &frame) {
+    const Molecule::MoleculeDihedrals &dihedrals = mol.GetDihedrals();
+    size_t n = dihedrals.size();
+    TermGeometry geom = Empty(n);
+    Gathered<4> g;
+    Gather(mol, frame, dihedrals, g);
+    std::vector<double> x(n), y(n);
+    simd::TorsionComponents(g.points[0], g.points[1], g.points[2],
+                            g.points[3], n, x.data(), y.data());
+    for (size_t i = 0; i < n; ++i)
+      geom.values[i] = std::atan2(y[i], x[i]) * to_degrees;
+
+    // Impropers are harmonic in the deviation from the ideal angle, wrapped
+    // to (-180, 180]
+    EnergyBatch improper;
+    for (uint32_t i = 0; i < n; ++i) {
+      if (!dihedrals[i].HasType()) continue;
+      double phi = geom.values[i];
+      for (const FFDihedral &type : dihedrals[i].GetTypes()) {
+        double energy = unset;
+        if (type.GetType() == DihedralType::Proper) {
+          if (std::isnan(geom.ideals[i])) geom.ideals[i] = type.GetPhaseShift();
+          double arg = type.GetMultiplicity() * phi - type.GetPhaseShift();
+          energy = type.GetForceConstant() * (1. + std::cos(arg * to_radians));
+        } else if (type.GetType() == DihedralType::Improper) {
+          if (std::isnan(geom.ideals[i])) geom.ideals[i] = type.GetIdealAngle();
+          double delta = phi - type.GetIdealAngle();
+          delta -= 360. * std::round(delta / 360.);
+          improper.Add(i, delta, 0., type.GetForceConstant());
+        }
+        if (std::isnan(energy)) continue;
+        double &e = geom.energies[i];
+        e = std::isnan(e) ? energy : e + energy;
+      }
+    }
+    improper.Apply(&simd::HarmonicEnergies, geom.energies);
+    return geom;
+  }
+
+} // namespace indigox::algorithm
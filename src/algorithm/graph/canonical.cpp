@@ -0,0 +1,382 @@
+#include <indigox/algorithm/graph/canonical.hpp>
+#include <indigox/classes/atom.hpp>
+#include <indigox/classes/bond.hpp>
+#include <indigox/classes/periodictable.hpp>
+#include <indigox/graph/condensed.hpp>
+#include <indigox/graph/molecular.hpp>
+
+#include <EASTL/vector_map.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <numeric>
+#include <ostream>
+#include <set>
+
+namespace indigox::algorithm {
+  using namespace indigox::graph;
+
+  namespace {
+    // =======================================================================
+    // == LABELLED GRAPH =====================================================
+    // =======================================================================
+
+    // Plain integer representation of a labelled graph, so the search does
+    // not need to touch the pimpl'd vertex and edge handles.
+    struct LabelledGraph {
+      std::vector<uint64_t> labels;
+      std::vector<std::vector<std::pair<uint32_t, uint32_t>>> adjacency;
+    };
+
+    template <class GraphType, class VertLabel, class EdgeLabel>
+    LabelledGraph BuildLabelledGraph(GraphType &G, VertLabel vlabel,
+                                     EdgeLabel elabel) {
+      using V = typename GraphType::VertContain::value_type;
+      const std::vector<V> &verts = G.GetVertices();
+      eastl::vector_map<V, uint32_t> index;
+      index.reserve(verts.size());
+      for (uint32_t i = 0; i < verts.size(); ++i) index.emplace(verts[i], i);
+
+      LabelledGraph L;
+      L.labels.reserve(verts.size());
+      L.adjacency.resize(verts.size());
+      for (uint32_t i = 0; i < verts.size(); ++i) {
+        L.labels.push_back(vlabel(verts[i]));
+        for (const V &nbr : G.GetNeighbours(verts[i]))
+          L.adjacency[i].emplace_back(index.at(nbr),
+                                      elabel(G.GetEdge(verts[i], nbr)));
+      }
+      return L;
+    }
+
+    // =======================================================================
+    // == PARTITION REFINEMENT ===============================================
+    // =======================================================================
+
+    // An ordered partition is stored as a colour per vertex, where the colour
+    // is the index of the first position of the vertex's cell. This keeps
+    // colours independent of the input vertex order.
+    using Colouring = std::vector<uint32_t>;
+
+    size_t NumCells(const Colouring &c) {
+      std::vector<bool> seen(c.size(), false);
+      size_t count = 0;
+      for (uint32_t col : c) {
+        if (!seen[col]) ++count;
+        seen[col] = true;
+      }
+      return count;
+    }
+
+    Colouring InitialColouring(const LabelledGraph &G) {
+      size_t n = G.labels.size();
+      std::vector<uint32_t> order(n);
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(), order.end(), [&G](uint32_t a, uint32_t b) {
+        return G.labels[a] < G.labels[b];
+      });
+      Colouring c(n);
+      uint32_t start = 0;
+      for (uint32_t i = 0; i < n; ++i) {
+        if (i && G.labels[order[i]] != G.labels[order[i - 1]]) start = i;
+        c[order[i]] = start;
+      }
+      return c;
+    }
+
+    // Weisfeiler-Lehman style colour refinement to an equitable partition.
+    // The signature of a vertex is its current colour and the sorted multiset
+    // of (edge label, neighbour colour) pairs. Ties in the sort are between
+    // vertices which end up in the same cell, so the result is canonical.
+    void Refine(const LabelledGraph &G, Colouring &c) {
+      size_t n = c.size();
+      std::vector<std::vector<uint64_t>> sig(n);
+      std::vector<uint32_t> order(n);
+      Colouring next(n);
+      size_t cells = NumCells(c);
+      while (cells < n) {
+        for (uint32_t v = 0; v < n; ++v) {
+          sig[v].clear();
+          for (auto &nbr : G.adjacency[v])
+            sig[v].push_back((uint64_t(nbr.second) << 32) | c[nbr.first]);
+          std::sort(sig[v].begin(), sig[v].end());
+        }
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+          if (c[a] != c[b]) return c[a] < c[b];
+          return sig[a] < sig[b];
+        });
+        size_t new_cells = 0;
+        uint32_t start = 0;
+        for (uint32_t i = 0; i < n; ++i) {
+          uint32_t v = order[i];
+          if (!i || c[v] != c[order[i - 1]] || sig[v] != sig[order[i - 1]]) {
+            start = i;
+            ++new_cells;
+          }
+          next[v] = start;
+        }
+        c.swap(next);
+        if (new_cells == cells) break;
+        cells = new_cells;
+      }
+    }
+
+    // Split v from its cell, placing it first.
+    void Individualise(Colouring &c, uint32_t v) {
+      uint32_t cell = c[v];
+      for (uint32_t &col : c) {
+        if (col == cell) col = cell + 1;
+      }
+      c[v] = cell;
+    }
+
+    // =======================================================================
+    // == HASHING ============================================================
+    // =======================================================================
+
+    uint64_t Mix(uint64_t x) {
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdULL;
+      x ^= x >> 33;
+      x *= 0xc4ceb9fe1a85ec53ULL;
+      x ^= x >> 33;
+      return x;
+    }
+
+    GraphHash HashCertificate(const std::vector<uint64_t> &cert) {
+      uint64_t h1 = 0x9e3779b97f4a7c15ULL;
+      uint64_t h2 = 0xc2b2ae3d27d4eb4fULL ^ cert.size();
+      for (uint64_t w : cert) {
+        h1 = Mix(h1 ^ w) + h2;
+        h2 = Mix(h2 + ((w << 31) | (w >> 33)) * 0x9e3779b97f4a7c15ULL) ^ h1;
+      }
+      return {Mix(h1 ^ (h2 >> 1)), Mix(h2 + h1)};
+    }
+
+    // =======================================================================
+    // == SEARCH TREE ========================================================
+    // =======================================================================
+
+    // Individualisation-refinement search for the minimum certificate.
+    // Automorphisms are found by comparing leaves against the first and best
+    // leaves, and children in the same orbit of the automorphisms fixing the
+    // current prefix are pruned.
+    struct CanonicalSearch {
+      const LabelledGraph &G;
+      size_t n;
+      std::vector<uint32_t> first_lab, best_lab;
+      std::vector<uint64_t> first_cert, best_cert;
+      std::vector<std::vector<uint32_t>> automorphisms;
+      std::vector<uint32_t> prefix;
+
+      CanonicalSearch(const LabelledGraph &g) : G(g), n(g.labels.size()) {}
+
+      void Run() {
+        if (!n) return;
+        Colouring c = InitialColouring(G);
+        Refine(G, c);
+        Descend(c);
+      }
+
+      std::vector<uint64_t> Certificate(const std::vector<uint32_t> &lab,
+                                        const Colouring &c) const {
+        std::vector<uint64_t> cert;
+        cert.reserve(1 + 2 * n);
+        cert.push_back(n);
+        for (uint32_t v : lab) cert.push_back(G.labels[v]);
+        std::vector<std::pair<uint64_t, uint64_t>> edges;
+        for (uint32_t v = 0; v < n; ++v) {
+          for (auto &nbr : G.adjacency[v]) {
+            if (c[v] < c[nbr.first])
+              edges.emplace_back((uint64_t(c[v]) << 32) | c[nbr.first],
+                                 nbr.second);
+          }
+        }
+        std::sort(edges.begin(), edges.end());
+        cert.push_back(edges.size());
+        for (auto &e : edges) {
+          cert.push_back(e.first);
+          cert.push_back(e.second);
+        }
+        return cert;
+      }
+
+      void Leaf(const Colouring &c) {
+        std::vector<uint32_t> lab(n);
+        for (uint32_t v = 0; v < n; ++v) lab[c[v]] = v;
+        std::vector<uint64_t> cert = Certificate(lab, c);
+        if (first_cert.empty()) {
+          first_lab = best_lab = lab;
+          first_cert = best_cert = cert;
+          return;
+        }
+        const std::vector<uint32_t> *matched = nullptr;
+        if (cert == first_cert) matched = &first_lab;
+        else if (cert == best_cert) matched = &best_lab;
+        if (matched) {
+          std::vector<uint32_t> aut(n);
+          for (uint32_t i = 0; i < n; ++i) aut[(*matched)[i]] = lab[i];
+          automorphisms.emplace_back(std::move(aut));
+        } else if (cert < best_cert) {
+          best_lab.swap(lab);
+          best_cert.swap(cert);
+        }
+      }
+
+      // Orbits of the group generated by the automorphisms which fix the
+      // current prefix pointwise.
+      std::vector<uint32_t> PrefixOrbits() const {
+        std::vector<uint32_t> parent(n);
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&parent](uint32_t x) {
+          while (parent[x] != x) x = parent[x] = parent[parent[x]];
+          return x;
+        };
+        for (auto &aut : automorphisms) {
+          bool fixes = std::all_of(prefix.begin(), prefix.end(),
+                                   [&aut](uint32_t v) { return aut[v] == v; });
+          if (!fixes) continue;
+          for (uint32_t v = 0; v < n; ++v) {
+            uint32_t a = find(v), b = find(aut[v]);
+            if (a != b) parent[std::max(a, b)] = std::min(a, b);
+          }
+        }
+        for (uint32_t v = 0; v < n; ++v) parent[v] = find(v);
+        return parent;
+      }
+
+      void Descend(const Colouring &c) {
+        // Target cell is the first non-singleton cell
+        std::vector<uint32_t> cell_size(n, 0);
+        for (uint32_t col : c) ++cell_size[col];
+        uint32_t target = 0;
+        while (target < n && cell_size[target] < 2) ++target;
+        if (target >= n) {
+          Leaf(c);
+          return;
+        }
+
+        std::vector<uint32_t> explored;
+        for (uint32_t v = 0; v < n; ++v) {
+          if (c[v] != target) continue;
+          if (!explored.empty()) {
+            std::vector<uint32_t> orbits = PrefixOrbits();
+            if (std::any_of(explored.begin(), explored.end(),
+                            [&](uint32_t u) { return orbits[u] == orbits[v]; }))
+              continue;
+          }
+          explored.push_back(v);
+          Colouring child(c);
+          Individualise(child, v);
+          Refine(G, child);
+          prefix.push_back(v);
+          Descend(child);
+          prefix.pop_back();
+        }
+      }
+    };
+
+    template <class GraphType>
+    CanonicalLabelling<typename GraphType::VertContain::value_type>
+    RunCanonical(GraphType &G, const LabelledGraph &L) {
+      CanonicalSearch search(L);
+      search.Run();
+      CanonicalLabelling<typename GraphType::VertContain::value_type> result;
+      const auto &verts = G.GetVertices();
+      result.ordering.reserve(search.best_lab.size());
+      for (uint32_t v : search.best_lab) result.ordering.push_back(verts[v]);
+      result.hash = HashCertificate(search.best_cert);
+      return result;
+    }
+
+    LabelledGraph Label(CondensedMolecularGraph &G, VertexIsoMask vmask,
+                        EdgeIsoMask emask) {
+      return BuildLabelledGraph(
+          G,
+          [&vmask](const CMGVertex &v) {
+            return (v.GetIsomorphismMask() & vmask).to_uint64();
+          },
+          [&emask](const CMGEdge &e) {
+            return (e.GetIsomorphismMask() & emask).to_uint32();
+          });
+    }
+
+    LabelledGraph Label(MolecularGraph &G) {
+      return BuildLabelledGraph(
+          G,
+          [](const MGVertex &v) {
+            const Atom &atm = v.GetAtom();
+            uint64_t z = atm.GetElement().GetAtomicNumber();
+            return (z << 32) | uint32_t(atm.GetFormalCharge());
+          },
+          [](const MGEdge &e) { return uint32_t(e.GetBond().GetOrder()); });
+    }
+  } // namespace
+
+  // =========================================================================
+  // == PUBLIC INTERFACE =====================================================
+  // =========================================================================
+
+  std::ostream &operator<<(std::ostream &os, const GraphHash &h) {
+    std::ios_base::fmtflags flags(os.flags());
+    char fill = os.fill('0');
+    os << std::hex << std::setw(16) << h.high << std::setw(16) << h.low;
+    os.flags(flags);
+    os.fill(fill);
+    return os;
+  }
+
+  CMGCanonicalForm CanonicalForm(CondensedMolecularGraph &G,
+                                 VertexIsoMask vmask, EdgeIsoMask emask) {
+    return RunCanonical(G, Label(G, vmask, emask));
+  }
+
+  CMGCanonicalForm CanonicalForm(CondensedMolecularGraph &G) {
+    VertexIsoMask vmask;
+    vmask.set();
+    EdgeIsoMask emask;
+    emask.set();
+    return CanonicalForm(G, vmask, emask);
+  }
+
+  MGCanonicalForm CanonicalForm(MolecularGraph &G) {
+    return RunCanonical(G, Label(G));
+  }
+
+  GraphHash CanonicalHash(CondensedMolecularGraph &G, VertexIsoMask vmask,
+                          EdgeIsoMask emask) {
+    return CanonicalForm(G, vmask, emask).hash;
+  }
+
+  GraphHash CanonicalHash(CondensedMolecularGraph &G) {
+    return CanonicalForm(G).hash;
+  }
+
+  GraphHash CanonicalHash(MolecularGraph &G) { return CanonicalForm(G).hash; }
+
+  std::vector<Permutation> AutomorphismGroup(CondensedMolecularGraph &G,
+                                             VertexIsoMask vmask,
+                                             EdgeIsoMask emask, size_t limit) {
+    LabelledGraph L = Label(G, vmask, emask);
+    CanonicalSearch search(L);
+    search.Run();
+
+    Permutation identity(L.labels.size());
+    std::iota(identity.begin(), identity.end(), 0);
+    std::set<Permutation> seen{identity};
+    std::vector<Permutation> group{identity};
+    // Breadth first closure of the generators
+    for (size_t i = 0; i < group.size(); ++i) {
+      for (const Permutation &gen : search.automorphisms) {
+        Permutation next(identity.size());
+        for (uint32_t v = 0; v < next.size(); ++v) next[v] = gen[group[i][v]];
+        if (!seen.insert(next).second) continue;
+        if (group.size() >= limit) return {};
+        group.emplace_back(std::move(next));
+      }
+    }
+    return group;
+  }
+
+} // namespace indigox::algorithm
@@ -1,6 +1,6 @@
 #include <indigox/algorithm/access.hpp>
+#include <indigox/algorithm/graph/canonical.hpp>
 #include <indigox/algorithm/graph/isomorphism.hpp>
-#include <indigox/algorithm/graph/connectivity.hpp>
 #include <indigox/classes/atom.hpp>
 #include <indigox/classes/bond.hpp>
 #include <indigox/graph/condensed.hpp>
@@ -12,6 +12,13 @@
 
 #include <EASTL/vector_map.h>
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <map>
+#include <numeric>
+
 
 namespace indigox::algorithm {
   using namespace indigox::graph;
@@ -238,118 +245,468 @@ namespace indigox::algorithm {
     VF2SubgraphIsoRunner(G1, G2, CB);
   }
 
-  using CSubgraphMap = eastl::vector<std::pair<CMGVertex, CMGVertex>>;
-  using AllCSubgraphMaps = eastl::vector_map<CMGVertex, CSubgraphMap>;
-  struct RILargestCommonCSubgraphMatcher : rilib::MatchListener {
-    CondensedMolecularGraph &small, &big;
-    AllCSubgraphMaps& matches;
-    RILargestCommonCSubgraphMatcher(CondensedMolecularGraph& s, CondensedMolecularGraph& b,
-                                   AllCSubgraphMaps& m)
-    : small(s), big(b), matches(m) { }
-    virtual void match(int n, int * small_ids, int * large_ids) {
-      CSubgraphMap m; m.reserve(n);
-      for (int i = 0; i < n; ++i) {
-        m.emplace_back(small.GetVertices()[small_ids[i]],
-                                    big.GetVertices()[large_ids[i]]);
+  // =========================================================================
+  // ==== McSplit based maximum common connected subgraph ====================
+  // =========================================================================
+
+  namespace {
+    // Dense representation of a labelled graph, for the symmetry reduced
+    // matcher. Edge labels are offset by one so that zero means no edge.
+    struct DenseGraph {
+      size_t n;
+      std::vector<uint64_t> labels;
+      std::vector<uint32_t> edges;
+      std::vector<uint32_t> degree;
+      std::vector<std::vector<uint32_t>> neighbours;
+      uint32_t Edge(uint32_t u, uint32_t v) const { return edges[u * n + v]; }
+    };
+
+    template <class GraphType, class VertLabel, class EdgeLabel>
+    DenseGraph MakeDense(GraphType &G, VertLabel vlabel, EdgeLabel elabel) {
+      using V = typename GraphType::VertContain::value_type;
+      const std::vector<V> &verts = G.GetVertices();
+      eastl::vector_map<V, uint32_t> index;
+      index.reserve(verts.size());
+      for (uint32_t i = 0; i < verts.size(); ++i) index.emplace(verts[i], i);
+
+      DenseGraph D;
+      D.n = verts.size();
+      D.edges.assign(D.n * D.n, 0);
+      D.degree.assign(D.n, 0);
+      D.neighbours.resize(D.n);
+      for (uint32_t i = 0; i < D.n; ++i) {
+        D.labels.push_back(vlabel(verts[i]));
+        for (const V &nbr : G.GetNeighbours(verts[i])) {
+          D.edges[i * D.n + index.at(nbr)] =
+              elabel(G.GetEdge(verts[i], nbr)) + 1;
+          D.neighbours[i].push_back(index.at(nbr));
+          ++D.degree[i];
+        }
       }
-      for (auto& sub_tar : m) {
-        if (matches.at(sub_tar.first).size() < m.size())
-          matches[sub_tar.first] = m;
+      return D;
+    }
+
+    // Set of vertices of a graph as a bitset, 64 vertices to a word
+    struct VertexSet {
+      std::vector<uint64_t> words;
+
+      VertexSet() = default;
+      explicit VertexSet(size_t n) : words((n + 63) / 64, 0) {}
+
+      void Set(uint32_t v) { words[v / 64] |= uint64_t(1) << (v % 64); }
+      void Reset(uint32_t v) { words[v / 64] &= ~(uint64_t(1) << (v % 64)); }
+      size_t Count() const {
+        size_t count = 0;
+        for (uint64_t w : words) count += __builtin_popcountll(w);
+        return count;
+      }
+      bool Any() const {
+        for (uint64_t w : words) {
+          if (w) return true;
+        }
+        return false;
+      }
+      template <class Func> void ForEach(Func func) const {
+        for (size_t i = 0; i < words.size(); ++i) {
+          for (uint64_t w = words[i]; w; w &= w - 1)
+            func(uint32_t(i * 64 + __builtin_ctzll(w)));
+        }
+      }
+      // Intersection with another set
+      VertexSet And(const VertexSet &other) const {
+        VertexSet out(*this);
+        for (size_t i = 0; i < words.size(); ++i)
+          out.words[i] &= other.words[i];
+        return out;
+      }
+      // Difference with another set
+      VertexSet AndNot(const VertexSet &other) const {
+        VertexSet out(*this);
+        for (size_t i = 0; i < words.size(); ++i)
+          out.words[i] &= ~other.words[i];
+        return out;
+      }
+    };
+
+    // Label class of the McSplit partition. Every left vertex of a class may
+    // be matched to every right vertex.
+    struct BiDomain {
+      VertexSet left, right;
+      size_t left_size, right_size;
+      bool adjacent;
+      size_t Bound() const { return std::min(left_size, right_size); }
+    };
+
+    // Labelled graph with the neighbours of each vertex held as a bitset per
+    // edge label, so domains are split by intersecting bitsets.
+    struct BitGraph {
+      size_t n;
+      std::vector<uint64_t> labels;
+      std::vector<uint32_t> degree;
+      // Closed neighbourhood of each vertex, including itself
+      std::vector<VertexSet> closed;
+      // Neighbours of each vertex, by edge label
+      std::vector<std::vector<std::pair<uint32_t, VertexSet>>> by_label;
+    };
+
+    template <class GraphType, class VertLabel, class EdgeLabel>
+    BitGraph MakeBitGraph(GraphType &G, VertLabel vlabel, EdgeLabel elabel) {
+      using V = typename GraphType::VertContain::value_type;
+      const std::vector<V> &verts = G.GetVertices();
+      eastl::vector_map<V, uint32_t> index;
+      index.reserve(verts.size());
+      for (uint32_t i = 0; i < verts.size(); ++i) index.emplace(verts[i], i);
+
+      BitGraph B;
+      B.n = verts.size();
+      B.degree.assign(B.n, 0);
+      B.closed.assign(B.n, VertexSet(B.n));
+      B.by_label.resize(B.n);
+      for (uint32_t i = 0; i < B.n; ++i) {
+        B.labels.push_back(vlabel(verts[i]));
+        B.closed[i].Set(i);
+        auto &groups = B.by_label[i];
+        for (const V &nbr : G.GetNeighbours(verts[i])) {
+          uint32_t j = index.at(nbr);
+          uint32_t label = elabel(G.GetEdge(verts[i], nbr));
+          auto pos =
+              std::find_if(groups.begin(), groups.end(),
+                           [label](auto &g) { return g.first == label; });
+          if (pos == groups.end())
+            pos = groups.emplace(groups.end(), label, VertexSet(B.n));
+          pos->second.Set(j);
+          B.closed[i].Set(j);
+          ++B.degree[i];
+        }
       }
+      return B;
     }
-  };
-  
-  // LCSubGraph
-  int LargestCommonSubgraph(CondensedMolecularGraph& source_g,
-                            CondensedMolecularGraph& target_g,
-                            size_t smallest_size,
-                            AllCSubgraphMaps& largest_subgraphs) {
-    
-    // Setup the return map
-    largest_subgraphs.clear();
-    for(CMGVertex v : source_g.GetVertices()) largest_subgraphs[v] = CSubgraphMap();
-    
-    // Generate all subgraphs of source_g
-    ConnectedSubgraphs subgraph_generator(source_g, smallest_size, std::min(target_g.NumVertices(), source_g.NumVertices()));
-    CondensedMolecularGraph sub;
-    graph::VertexIsoMask vertmask; vertmask.set();
-    graph::EdgeIsoMask edgemask; edgemask.set();
-    std::unique_ptr<rilib::Graph> target_ri = CMGToRIGraph(target_g, edgemask, vertmask);
-    // Iterate over subgraphs checking for isomporhisms
-    while (subgraph_generator(sub)) {
-      // convert subgraph to ri graph
-      std::unique_ptr<rilib::Graph> sub_ri = CMGToRIGraph(sub, edgemask, vertmask);
-      Uint64AttrComparator* vert_compare = new Uint64AttrComparator();
-      Uint32AttrComparator* edge_compare = new Uint32AttrComparator();
-      RILargestCommonCSubgraphMatcher* listener = new RILargestCommonCSubgraphMatcher(sub, target_g, largest_subgraphs);
-      rilib::MaMaConstrFirst* mama = new rilib::MaMaConstrFirst(*sub_ri);
-      mama->build(*sub_ri);
-      long tmp_1, tmp_2, tmp_3;
-      // run the matching
-      rilib::match(*target_ri, *sub_ri, *mama, *listener,
-                   rilib::MATCH_TYPE::MT_INDSUB, *vert_compare,
-                   *edge_compare, &tmp_1, &tmp_2, &tmp_3);
-      delete vert_compare;
-      delete edge_compare;
-      delete listener;
-      delete mama;
+
+    // Branch and bound search for the largest common connected induced
+    // subgraph containing each vertex of the source graph. A branch is only
+    // pruned when its bound cannot improve the result of any source vertex
+    // which could still be part of it.
+    struct McSplitSearch {
+      using Mapping = std::vector<std::pair<uint32_t, uint32_t>>;
+      using Clock = std::chrono::steady_clock;
+
+      const BitGraph &G1, &G2;
+      size_t smallest;
+      uint64_t node_limit;
+      double time_limit;
+      uint64_t nodes = 0;
+      bool exhausted = false;
+      Clock::time_point start;
+      std::vector<Mapping> best;
+      Mapping current;
+
+      McSplitSearch(const BitGraph &g1, const BitGraph &g2, size_t min,
+                    uint64_t nlim, double tlim)
+          : G1(g1), G2(g2), smallest(std::max<size_t>(min, 1)),
+            node_limit(nlim), time_limit(tlim), start(Clock::now()),
+            best(g1.n) {}
+
+      static void Push(std::vector<BiDomain> &domains, VertexSet left,
+                       VertexSet right, bool adjacent) {
+        size_t l = left.Count(), r = right.Count();
+        if (!l || !r) return;
+        domains.push_back({std::move(left), std::move(right), l, r, adjacent});
+      }
+
+      void Run() {
+        std::vector<BiDomain> domains;
+        std::map<uint64_t, std::pair<VertexSet, VertexSet>> classes;
+        auto entry = [&](uint64_t label) -> auto & {
+          auto pos = classes.find(label);
+          if (pos == classes.end())
+            pos = classes
+                      .emplace(label, std::make_pair(VertexSet(G1.n),
+                                                     VertexSet(G2.n)))
+                      .first;
+          return pos->second;
+        };
+        for (uint32_t u = 0; u < G1.n; ++u) entry(G1.labels[u]).first.Set(u);
+        for (uint32_t x = 0; x < G2.n; ++x) entry(G2.labels[x]).second.Set(x);
+        for (auto &cls : classes)
+          Push(domains, std::move(cls.second.first),
+               std::move(cls.second.second), false);
+        Search(domains);
+      }
+
+      bool BudgetExhausted() {
+        if (exhausted) return true;
+        ++nodes;
+        if (node_limit && nodes > node_limit) exhausted = true;
+        if (time_limit > 0 && !(nodes & 0x3FF)) {
+          std::chrono::duration<double> elapsed = Clock::now() - start;
+          if (elapsed.count() > time_limit) exhausted = true;
+        }
+        return exhausted;
+      }
+
+      void Record() {
+        if (current.size() < smallest) return;
+        for (auto &uv : current) {
+          if (best[uv.first].size() < current.size()) best[uv.first] = current;
+        }
+      }
+
+      bool CanImprove(const std::vector<BiDomain> &domains) const {
+        size_t bound = current.size();
+        for (auto &dom : domains) bound += dom.Bound();
+        if (bound < smallest) return false;
+        for (auto &uv : current) {
+          if (best[uv.first].size() < bound) return true;
+        }
+        bool improves = false;
+        for (auto &dom : domains) {
+          dom.left.ForEach([&](uint32_t u) {
+            if (best[u].size() < bound) improves = true;
+          });
+          if (improves) return true;
+        }
+        return false;
+      }
+
+      // Smallest domain which can be extended from, preferring domains
+      // adjacent to the current mapping when it is not empty.
+      int64_t SelectDomain(const std::vector<BiDomain> &domains) const {
+        int64_t selected = -1;
+        size_t selected_size = std::numeric_limits<size_t>::max();
+        for (size_t i = 0; i < domains.size(); ++i) {
+          if (!current.empty() && !domains[i].adjacent) continue;
+          size_t sz = std::max(domains[i].left_size, domains[i].right_size);
+          if (sz < selected_size) {
+            selected = i;
+            selected_size = sz;
+          }
+        }
+        return selected;
+      }
+
+      // Split each domain by the edge label of its vertices to the newly
+      // mapped pair, with non-neighbours kept as a class of their own
+      std::vector<BiDomain> Split(const std::vector<BiDomain> &domains,
+                                  uint32_t v, uint32_t w) const {
+        std::vector<BiDomain> next;
+        for (auto &dom : domains) {
+          Push(next, dom.left.AndNot(G1.closed[v]),
+               dom.right.AndNot(G2.closed[w]), dom.adjacent);
+          for (auto &l : G1.by_label[v]) {
+            for (auto &r : G2.by_label[w]) {
+              if (l.first != r.first) continue;
+              Push(next, dom.left.And(l.second), dom.right.And(r.second),
+                   true);
+            }
+          }
+        }
+        return next;
+      }
+
+      void Search(std::vector<BiDomain> &domains) {
+        if (BudgetExhausted()) return;
+        Record();
+        if (!CanImprove(domains)) return;
+
+        int64_t d = SelectDomain(domains);
+        if (d < 0) return;
+
+        // Branch on the highest degree left vertex of the domain
+        uint32_t v = 0;
+        bool found = false;
+        domains[d].left.ForEach([&](uint32_t u) {
+          if (!found || G1.degree[u] > G1.degree[v]) v = u;
+          found = true;
+        });
+        VertexSet right = domains[d].right;
+        right.ForEach([&](uint32_t w) {
+          if (exhausted) return;
+          std::vector<BiDomain> next = Split(domains, v, w);
+          current.emplace_back(v, w);
+          Search(next);
+          current.pop_back();
+        });
+        if (exhausted) return;
+
+        // Branch where v is left unmatched
+        domains[d].left.Reset(v);
+        if (!--domains[d].left_size) domains.erase(domains.begin() + d);
+        Search(domains);
+      }
+    };
+
+    template <class V, class GraphType>
+    int RunMcSplit(GraphType &source_g, GraphType &target_g,
+                   const BitGraph &source, const BitGraph &target,
+                   size_t smallest_size, uint64_t node_limit,
+                   double time_limit,
+                   eastl::vector_map<V, eastl::vector<std::pair<V, V>>> &out) {
+      out.clear();
+      const auto &source_v = source_g.GetVertices();
+      const auto &target_v = target_g.GetVertices();
+      for (const V &v : source_v) out[v] = eastl::vector<std::pair<V, V>>();
+
+      McSplitSearch search(source, target, smallest_size, node_limit,
+                           time_limit);
+      search.Run();
+
+      for (uint32_t u = 0; u < source.n; ++u) {
+        auto &m = out[source_v[u]];
+        m.reserve(search.best[u].size());
+        for (auto &uv : search.best[u])
+          m.emplace_back(source_v[uv.first], target_v[uv.second]);
+      }
+      return search.exhausted ? 1 : 0;
     }
-    
-    return 0;
+  } // namespace
+
+  using CSubgraphMap = eastl::vector<std::pair<CMGVertex, CMGVertex>>;
+  using AllCSubgraphMaps = eastl::vector_map<CMGVertex, CSubgraphMap>;
+
+  int LargestCommonSubgraph(CondensedMolecularGraph &source_g,
+                            CondensedMolecularGraph &target_g,
+                            size_t smallest_size,
+                            AllCSubgraphMaps &largest_subgraphs,
+                            uint64_t node_limit, double time_limit) {
+    auto vlabel = [](const CMGVertex &v) {
+      return v.GetIsomorphismMask().to_uint64();
+    };
+    auto elabel = [](const CMGEdge &e) {
+      return e.GetIsomorphismMask().to_uint32();
+    };
+    BitGraph source = MakeBitGraph(source_g, vlabel, elabel);
+    BitGraph target = MakeBitGraph(target_g, vlabel, elabel);
+    return RunMcSplit<CMGVertex>(source_g, target_g, source, target,
+                                 smallest_size, node_limit, time_limit,
+                                 largest_subgraphs);
   }
-  
+
   using SubgraphMap = eastl::vector<std::pair<MGVertex, MGVertex>>;
   using AllSubgraphMaps = eastl::vector_map<MGVertex, SubgraphMap>;
-  struct RILargestCommonSubgraphMatcher : rilib::MatchListener {
-    MolecularGraph &small, &big;
-    AllSubgraphMaps& matches;
-    RILargestCommonSubgraphMatcher(MolecularGraph& s, MolecularGraph& b,
-                                    AllSubgraphMaps& m)
-    : small(s), big(b), matches(m) { }
-    virtual void match(int n, int * small_ids, int * large_ids) {
-      SubgraphMap m; m.reserve(n);
-      for (int i = 0; i < n; ++i) {
-        m.emplace_back(small.GetVertices()[small_ids[i]],
-                       big.GetVertices()[large_ids[i]]);
+
+  int LargestCommonSubgraph(MolecularGraph &source_g, MolecularGraph &target_g,
+                            size_t smallest_size,
+                            AllSubgraphMaps &largest_subgraphs,
+                            uint64_t node_limit, double time_limit) {
+    auto vlabel = [](const MGVertex &v) {
+      return uint64_t(v.GetAtom().GetElement().GetAtomicNumber());
+    };
+    auto elabel = [](const MGEdge &e) {
+      return uint32_t(e.GetBond().GetOrder());
+    };
+    BitGraph source = MakeBitGraph(source_g, vlabel, elabel);
+    BitGraph target = MakeBitGraph(target_g, vlabel, elabel);
+    return RunMcSplit<MGVertex>(source_g, target_g, source, target,
+                                smallest_size, node_limit, time_limit,
+                                largest_subgraphs);
+  }
+
+  // =========================================================================
+  // ==== Symmetry reduced subgraph isomorphism ==============================
+  // =========================================================================
+
+  namespace {
+    // Backtracking induced subgraph isomorphism which only reports the
+    // lexicographically smallest isomorphism of each orbit under the target
+    // automorphism group. At each depth the image must be the smallest vertex
+    // of its orbit under the stabiliser of the images assigned so far.
+    struct SymmetricMatcher {
+      const DenseGraph &P, &T;
+      const std::vector<Permutation> &group;
+      std::vector<uint32_t> order, parent, image;
+      std::vector<bool> used;
+      std::function<void(const std::vector<uint32_t> &)> found;
+
+      SymmetricMatcher(const DenseGraph &p, const DenseGraph &t,
+                       const std::vector<Permutation> &g)
+          : P(p), T(t), group(g), parent(p.n, UINT32_MAX), image(p.n),
+            used(t.n, false) {
+        // Breadth first order so each vertex after the first in a component
+        // has a previously matched neighbour
+        std::vector<bool> seen(P.n, false);
+        for (uint32_t root = 0; root < P.n; ++root) {
+          if (seen[root]) continue;
+          seen[root] = true;
+          order.push_back(root);
+          for (size_t i = order.size() - 1; i < order.size(); ++i) {
+            for (uint32_t nbr : P.neighbours[order[i]]) {
+              if (seen[nbr]) continue;
+              seen[nbr] = true;
+              parent[nbr] = order[i];
+              order.push_back(nbr);
+            }
+          }
+        }
       }
-      for (auto& sub_tar : m) {
-        if (matches.at(sub_tar.first).size() < m.size())
-          matches[sub_tar.first] = m;
+
+      void Run() {
+        if (P.n > T.n) return;
+        std::vector<uint32_t> stabiliser;
+        for (uint32_t i = 0; i < group.size(); ++i) stabiliser.push_back(i);
+        Search(0, stabiliser);
       }
-    }
-  };
-  
-  int LargestCommonSubgraph(MolecularGraph& source_g, MolecularGraph& target_g,
-                            size_t smallest_size, AllSubgraphMaps& largest_subgraphs) {
-    // Setup the return map
-    largest_subgraphs.clear();
-    for(MGVertex v : source_g.GetVertices()) largest_subgraphs[v] = SubgraphMap();
-    
-    // Generate all subgraphs of source_g
-    ConnectedSubgraphs subgraph_generator(source_g, smallest_size, std::min(target_g.NumVertices(), source_g.NumVertices()));
-    MolecularGraph sub;
-    std::unique_ptr<rilib::Graph> target_ri = MGToRIGraph(target_g);
-    // Iterate over subgraphs checking for isomporhisms
-    while (subgraph_generator(sub)) {
-      // convert subgraph to ri graph
-      std::unique_ptr<rilib::Graph> sub_ri = MGToRIGraph(sub);
-      Uint32AttrComparator* vert_compare = new Uint32AttrComparator();
-      Uint32AttrComparator* edge_compare = new Uint32AttrComparator();
-      RILargestCommonSubgraphMatcher* listener = new RILargestCommonSubgraphMatcher(sub, target_g, largest_subgraphs);
-      rilib::MaMaConstrFirst* mama = new rilib::MaMaConstrFirst(*sub_ri);
-      mama->build(*sub_ri);
-      long tmp_1, tmp_2, tmp_3;
-      // run the matching
-      rilib::match(*target_ri, *sub_ri, *mama, *listener,
-                   rilib::MATCH_TYPE::MT_INDSUB, *vert_compare,
-                   *edge_compare, &tmp_1, &tmp_2, &tmp_3);
-      delete vert_compare;
-      delete edge_compare;
-      delete listener;
-      delete mama;
-    }
-    
-    return 0;
+
+      bool Feasible(size_t depth, uint32_t p, uint32_t t) const {
+        if (used[t] || P.labels[p] != T.labels[t]) return false;
+        for (size_t j = 0; j < depth; ++j) {
+          uint32_t q = order[j];
+          if (P.Edge(p, q) != T.Edge(t, image[q])) return false;
+        }
+        return true;
+      }
+
+      void Search(size_t depth, const std::vector<uint32_t> &stabiliser) {
+        if (depth == order.size()) {
+          found(image);
+          return;
+        }
+        uint32_t p = order[depth];
+        auto try_candidate = [&](uint32_t t) {
+          if (!Feasible(depth, p, t)) return;
+          std::vector<uint32_t> next;
+          for (uint32_t g : stabiliser) {
+            if (group[g][t] < t) return;
+            if (group[g][t] == t) next.push_back(g);
+          }
+          image[p] = t;
+          used[t] = true;
+          Search(depth + 1, next);
+          used[t] = false;
+        };
+        if (parent[p] != UINT32_MAX) {
+          for (uint32_t t : T.neighbours[image[parent[p]]]) try_candidate(t);
+        } else {
+          for (uint32_t t = 0; t < T.n; ++t) try_candidate(t);
+        }
+      }
+    };
+  } // namespace
+
+  void SubgraphIsomorphisms(CondensedMolecularGraph &G1,
+                            CondensedMolecularGraph &G2, VertexIsoMask vmask,
+                            EdgeIsoMask emask,
+                            const std::vector<Permutation> &group,
+                            CMGCallback &callback) {
+    auto vlabel = [&vmask](const CMGVertex &v) {
+      return (v.GetIsomorphismMask() & vmask).to_uint64();
+    };
+    auto elabel = [&emask](const CMGEdge &e) {
+      return (e.GetIsomorphismMask() & emask).to_uint32();
+    };
+    DenseGraph small = MakeDense(G1, vlabel, elabel);
+    DenseGraph large = MakeDense(G2, vlabel, elabel);
+    const auto &small_v = G1.GetVertices();
+    const auto &large_v = G2.GetVertices();
+
+    SymmetricMatcher matcher(small, large, group);
+    matcher.found = [&](const std::vector<uint32_t> &image) {
+      CMGCallback::CorrespondenceMap map;
+      map.reserve(image.size());
+      for (uint32_t i = 0; i < image.size(); ++i)
+        map.emplace(small_v[i], large_v[image[i]]);
+      callback(map);
+    };
+    matcher.Run();
   }
-  
+
 } // namespace indigox::algorithm
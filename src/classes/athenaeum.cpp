@@ -17,9 +17,12 @@
 #include <EASTL/vector_set.h>
 #include <algorithm>
 #include <deque>
+#include <exception>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <numeric>
+#include <thread>
 #include <vector>
 
 namespace indigox {
@@ -597,6 +600,64 @@ namespace indigox {
     return pos.first->second.size() - initial_count;
   }
 
+  size_t Athenaeum::AddAllFragments(const std::vector<Molecule> &mols,
+                                    uint32_t num_threads) {
+    if (!num_threads)
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (num_threads > mols.size()) num_threads = uint32_t(mols.size());
+    if (num_threads <= 1) {
+      size_t count = 0;
+      for (const Molecule &mol : mols) count += AddAllFragments(mol);
+      return count;
+    }
+
+    // Molecules are dealt out in turn, so large ones are spread out
+    std::vector<std::future<Athenaeum>> parts;
+    parts.reserve(num_threads);
+    for (uint32_t t = 0; t < num_threads; ++t) {
+      parts.emplace_back(std::async(std::launch::async, [this, &mols, t,
+                                                         num_threads]() {
+        Athenaeum part(m_data->ff);
+        part.m_data->bool_parameters = m_data->bool_parameters;
+        part.m_data->int_parameters = m_data->int_parameters;
+        for (size_t i = t; i < mols.size(); i += num_threads)
+          part.AddAllFragments(mols[i]);
+        return part;
+      }));
+    }
+
+    size_t count = 0;
+    std::exception_ptr error;
+    for (std::future<Athenaeum> &future : parts) {
+      Athenaeum part;
+      try {
+        part = future.get();
+      } catch (...) {
+        if (!error) error = std::current_exception();
+        continue;
+      }
+      for (auto &entry : part.m_data->fragments) {
+        auto pos = m_data->fragments.emplace(entry.first, FragContain());
+        FragContain &frags = pos.first->second;
+        if (pos.second) {
+          frags = entry.second;
+          count += frags.size();
+          continue;
+        }
+        // Molecule already fragmented, so only add fragments it lacks
+        size_t initial_count = frags.size();
+        for (Fragment &f : entry.second) {
+          if (std::find(frags.begin(), frags.end(), f) == frags.end())
+            frags.emplace_back(f);
+        }
+        count += frags.size() - initial_count;
+        if (frags.size() != initial_count) SortAndMask(entry.first);
+      }
+    }
+    if (error) std::rethrow_exception(error);
+    return count;
+  }
+
   void SaveAthenaeum(const Athenaeum &a, const std::string& path) {
     using Archive = cereal::PortableBinaryOutputArchive;
     std::ofstream os(path);
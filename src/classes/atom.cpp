@@ -244,11 +244,7 @@ namespace indigox {
 
   int64_t Atom::GetIndex() const {
     _sanity_check_(*this);
-    if (!m_data->molecule) return -1;
-    auto mol_atoms = m_data->molecule.GetAtoms();
-    auto idx = std::find(mol_atoms.begin(), mol_atoms.end(), *this);
-    return (idx == mol_atoms.end()) ? -1 : std::distance(mol_atoms.begin(), idx);
-//    return bool(m_data->molecule) ? m_data->position : -1;
+    return bool(m_data->molecule) ? int64_t(m_data->position) : -1;
   }
 
   const FFAtom &Atom::GetType() const {
@@ -311,8 +307,8 @@ namespace indigox {
 
   void Atom::SetElement(const Element &element) {
     _sanity_check_(*this);
-    if (m_data->molecule) { m_data->molecule.ModificationMade(); }
     m_data->element = element;
+    if (m_data->molecule) { m_data->molecule.ModificationMade(*this); }
   }
 
   void Atom::SetElement(std::string symbol) {
@@ -342,6 +338,8 @@ namespace indigox {
   void Atom::SetTag(int32_t tag) {
     _sanity_check_(*this);
     m_data->tag = tag;
+    if (m_data->molecule)
+      m_data->molecule.m_data->atom_index.InvalidateTags();
   }
 
   void Atom::SetChargeGroupID(int32_t id) {
@@ -201,6 +201,8 @@ namespace indigox {
   void Bond::SetTag(int64_t tag) {
     _sanity_check_(*this);
     m_data->tag = tag;
+    if (m_data->molecule)
+      m_data->molecule.m_data->bond_index.InvalidateTags();
   }
 
   void Bond::SetOrder(BondOrder order) {
@@ -0,0 +1,533 @@
+#include <indigox/classes/atom.hpp>
+#include <indigox/classes/bond.hpp>
+#include <indigox/classes/columnar.hpp>
+#include <indigox/classes/columnar_impl.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/classes/molecule_impl.hpp>
+#include <indigox/classes/periodictable.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#ifndef INDIGOX_DISABLE_SANITY_CHECKS
+#define _sanity_check_(x)                                                      \
+  if (!x)                                                                      \
+  throw std::runtime_error(                                                    \
+      "Attempting to access data from invalid columnar instance")
+#else
+#define _sanity_check_(x)
+#endif
+
+namespace indigox {
+
+  // =======================================================================
+  // == CONSTRUCTION =======================================================
+  // =======================================================================
+
+  ColumnarMolecule::ColumnarMolecule(const std::string &name)
+      : m_data(std::make_shared<Impl>(name)) {}
+
+  ColumnarMolecule::ColumnarMolecule(const Molecule &mol)
+      : m_data(std::make_shared<Impl>(mol.GetName())) {
+    Impl &dat = *m_data;
+    dat.molecular_charge = mol.GetMolecularCharge();
+    dat.forcefield = mol.GetForcefield();
+
+    const Molecule::MoleculeAtoms &atoms = mol.GetAtoms();
+    ReserveAtoms(atoms.size());
+    for (Atom atm : atoms) {
+      uint32_t idx = dat.AddAtom(atm.GetElement().GetAtomicNumber(),
+                                 atm.GetX(), atm.GetY(), atm.GetZ());
+      ColumnarAtom catm(m_data.get(), idx);
+      catm.SetFormalCharge(atm.GetFormalCharge());
+      dat.partial_charges[idx] = atm.GetPartialCharge();
+      dat.residue_ids[idx] = atm.GetResidueID();
+      dat.charge_group_ids[idx] = atm.GetChargeGroupID();
+      dat.names[idx] = dat.Intern(atm.GetName());
+      dat.residue_names[idx] = dat.Intern(atm.GetResidueName());
+      if (atm.HasType()) dat.atom_types[idx] = dat.Intern(atm.GetType());
+    }
+
+    const Molecule::MoleculeBonds &bonds = mol.GetBonds();
+    ReserveBonds(bonds.size());
+    for (const Bond &bnd : bonds) {
+      ColumnarBond cbnd = NewBond(GetAtom(bnd.GetAtoms()[0].GetIndex()),
+                                  GetAtom(bnd.GetAtoms()[1].GetIndex()));
+      dat.bond_orders[cbnd.m_idx] = bnd.GetOrder();
+      if (bnd.HasType())
+        dat.bond_types[cbnd.m_idx] = dat.Intern(bnd.GetType());
+    }
+  }
+
+  Molecule ColumnarMolecule::ToMolecule() const {
+    _sanity_check_(*this);
+    const Impl &dat = *m_data;
+    const PeriodicTable &pt = GetPeriodicTable();
+    Molecule mol(dat.name);
+    mol.SetMolecularCharge(dat.molecular_charge);
+    if (dat.forcefield) mol.SetForcefield(dat.forcefield);
+    mol.ReserveAtoms(NumAtoms());
+    mol.ReserveBonds(NumBonds());
+
+    const double *x = m_data->coordinates.x_vals();
+    const double *y = m_data->coordinates.y_vals();
+    const double *z = m_data->coordinates.z_vals();
+    std::vector<Atom> atoms;
+    atoms.reserve(NumAtoms());
+    for (size_t i = 0; i < dat.atomic_numbers.size(); ++i) {
+      Atom atm = mol.NewAtom(pt[dat.atomic_numbers[i]], x[i], y[i], z[i]);
+      atm.SetFormalCharge(dat.formal_charges[i]);
+      atm.SetPartialCharge(dat.partial_charges[i]);
+      atm.SetChargeGroupID(dat.charge_group_ids[i]);
+      atm.SetName(dat.strings[dat.names[i]]);
+      atm.SetResidueName(dat.strings[dat.residue_names[i]]);
+      atm.m_data->residue_id = dat.residue_ids[i];
+      if (dat.atom_types[i]) atm.SetType(dat.atom_type_pool[dat.atom_types[i]]);
+      atoms.emplace_back(atm);
+    }
+
+    for (size_t i = 0; i < dat.bond_atoms.size(); ++i) {
+      Bond bnd = mol.NewBond(atoms[dat.bond_atoms[i][0]],
+                             atoms[dat.bond_atoms[i][1]]);
+      bnd.SetOrder(dat.bond_orders[i]);
+      if (dat.bond_types[i]) bnd.SetType(dat.bond_type_pool[dat.bond_types[i]]);
+    }
+    return mol;
+  }
+
+  // =======================================================================
+  // == STATE GETTING AND SETTING ==========================================
+  // =======================================================================
+
+  const std::string &ColumnarMolecule::GetName() const {
+    _sanity_check_(*this);
+    return m_data->name;
+  }
+
+  void ColumnarMolecule::SetName(const std::string &name) {
+    _sanity_check_(*this);
+    m_data->name = name;
+  }
+
+  int32_t ColumnarMolecule::GetMolecularCharge() const {
+    _sanity_check_(*this);
+    return m_data->molecular_charge;
+  }
+
+  void ColumnarMolecule::SetMolecularCharge(int32_t q) {
+    _sanity_check_(*this);
+    m_data->molecular_charge = q;
+  }
+
+  const Forcefield &ColumnarMolecule::GetForcefield() const {
+    _sanity_check_(*this);
+    return m_data->forcefield;
+  }
+
+  void ColumnarMolecule::SetForcefield(const Forcefield &ff) {
+    _sanity_check_(*this);
+    m_data->forcefield = ff;
+  }
+
+  int64_t ColumnarMolecule::NumAtoms() const {
+    _sanity_check_(*this);
+    return static_cast<int64_t>(m_data->atomic_numbers.size());
+  }
+
+  int64_t ColumnarMolecule::NumBonds() const {
+    _sanity_check_(*this);
+    return static_cast<int64_t>(m_data->bond_atoms.size());
+  }
+
+  void ColumnarMolecule::ReserveAtoms(int64_t num) {
+    _sanity_check_(*this);
+    if (num <= 0) return;
+    Impl &dat = *m_data;
+    dat.atomic_numbers.reserve(num);
+    dat.formal_charges.reserve(num);
+    dat.partial_charges.reserve(num);
+    dat.residue_ids.reserve(num);
+    dat.charge_group_ids.reserve(num);
+    dat.names.reserve(num);
+    dat.residue_names.reserve(num);
+    dat.atom_types.reserve(num);
+    dat.coordinates.Reserve(num);
+  }
+
+  void ColumnarMolecule::ReserveBonds(int64_t num) {
+    _sanity_check_(*this);
+    if (num <= 0) return;
+    m_data->bond_atoms.reserve(num);
+    m_data->bond_orders.reserve(num);
+    m_data->bond_types.reserve(num);
+    m_data->bond_lookup.reserve(num);
+  }
+
+  ColumnarAtom ColumnarMolecule::NewAtom(const Element &element, double x,
+                                         double y, double z) {
+    _sanity_check_(*this);
+    uint32_t idx = m_data->AddAtom(element.GetAtomicNumber(), x, y, z);
+    return ColumnarAtom(m_data.get(), idx);
+  }
+
+  ColumnarBond ColumnarMolecule::NewBond(const ColumnarAtom &a,
+                                         const ColumnarAtom &b) {
+    _sanity_check_(*this);
+    if (a.m_data != m_data.get() || b.m_data != m_data.get() || a == b)
+      return ColumnarBond();
+    uint64_t key = Impl::BondKey(a.m_idx, b.m_idx);
+    int64_t found = m_data->FindBond(key);
+    if (found >= 0) return ColumnarBond(m_data.get(), uint32_t(found));
+
+    uint32_t idx = static_cast<uint32_t>(m_data->bond_atoms.size());
+    m_data->bond_atoms.push_back({a.m_idx, b.m_idx});
+    m_data->bond_orders.push_back(BondOrder::SINGLE);
+    m_data->bond_types.push_back(0);
+    m_data->AddBondKey(key, idx);
+    m_data->adjacency_valid = false;
+    return ColumnarBond(m_data.get(), idx);
+  }
+
+  ColumnarAtom ColumnarMolecule::GetAtom(uint32_t pos) const {
+    _sanity_check_(*this);
+    return pos < m_data->atomic_numbers.size() ? ColumnarAtom(m_data.get(), pos)
+                                               : ColumnarAtom();
+  }
+
+  ColumnarBond ColumnarMolecule::GetBond(uint32_t pos) const {
+    _sanity_check_(*this);
+    return pos < m_data->bond_atoms.size() ? ColumnarBond(m_data.get(), pos)
+                                           : ColumnarBond();
+  }
+
+  ColumnarBond ColumnarMolecule::GetBond(const ColumnarAtom &a,
+                                         const ColumnarAtom &b) const {
+    _sanity_check_(*this);
+    if (a.m_data != m_data.get() || b.m_data != m_data.get())
+      return ColumnarBond();
+    int64_t found = m_data->FindBond(Impl::BondKey(a.m_idx, b.m_idx));
+    return found < 0 ? ColumnarBond()
+                     : ColumnarBond(m_data.get(), uint32_t(found));
+  }
+
+  const std::vector<uint8_t> &ColumnarMolecule::GetAtomicNumbers() const {
+    _sanity_check_(*this);
+    return m_data->atomic_numbers;
+  }
+
+  const std::vector<int8_t> &ColumnarMolecule::GetFormalCharges() const {
+    _sanity_check_(*this);
+    return m_data->formal_charges;
+  }
+
+  const std::vector<double> &ColumnarMolecule::GetPartialCharges() const {
+    _sanity_check_(*this);
+    return m_data->partial_charges;
+  }
+
+  const std::vector<int32_t> &ColumnarMolecule::GetResidueIDs() const {
+    _sanity_check_(*this);
+    return m_data->residue_ids;
+  }
+
+  const std::vector<int32_t> &ColumnarMolecule::GetChargeGroupIDs() const {
+    _sanity_check_(*this);
+    return m_data->charge_group_ids;
+  }
+
+  const std::vector<ColumnarMolecule::PoolIndex> &
+  ColumnarMolecule::GetNameIndices() const {
+    _sanity_check_(*this);
+    return m_data->names;
+  }
+
+  const std::vector<ColumnarMolecule::PoolIndex> &
+  ColumnarMolecule::GetResidueNameIndices() const {
+    _sanity_check_(*this);
+    return m_data->residue_names;
+  }
+
+  const std::vector<ColumnarMolecule::PoolIndex> &
+  ColumnarMolecule::GetAtomTypeIndices() const {
+    _sanity_check_(*this);
+    return m_data->atom_types;
+  }
+
+  AtomicCoordinates &ColumnarMolecule::GetAtomicCoordinates() {
+    _sanity_check_(*this);
+    return m_data->coordinates;
+  }
+
+  const std::vector<std::array<uint32_t, 2>> &
+  ColumnarMolecule::GetBondAtoms() const {
+    _sanity_check_(*this);
+    return m_data->bond_atoms;
+  }
+
+  const std::vector<BondOrder> &ColumnarMolecule::GetBondOrders() const {
+    _sanity_check_(*this);
+    return m_data->bond_orders;
+  }
+
+  const std::vector<ColumnarMolecule::PoolIndex> &
+  ColumnarMolecule::GetBondTypeIndices() const {
+    _sanity_check_(*this);
+    return m_data->bond_types;
+  }
+
+  const std::vector<std::string> &ColumnarMolecule::GetStringPool() const {
+    _sanity_check_(*this);
+    return m_data->strings;
+  }
+
+  const std::vector<FFAtom> &ColumnarMolecule::GetAtomTypePool() const {
+    _sanity_check_(*this);
+    return m_data->atom_type_pool;
+  }
+
+  const std::vector<FFBond> &ColumnarMolecule::GetBondTypePool() const {
+    _sanity_check_(*this);
+    return m_data->bond_type_pool;
+  }
+
+  const std::vector<uint32_t> &ColumnarMolecule::GetAdjacencyOffsets() const {
+    _sanity_check_(*this);
+    m_data->BuildAdjacency();
+    return m_data->adjacency_offsets;
+  }
+
+  const std::vector<uint32_t> &ColumnarMolecule::GetAdjacentAtoms() const {
+    _sanity_check_(*this);
+    m_data->BuildAdjacency();
+    return m_data->adjacent_atoms;
+  }
+
+  const std::vector<uint32_t> &ColumnarMolecule::GetAdjacentBonds() const {
+    _sanity_check_(*this);
+    m_data->BuildAdjacency();
+    return m_data->adjacent_bonds;
+  }
+
+  size_t ColumnarMolecule::MemoryUsage() const {
+    _sanity_check_(*this);
+    const Impl &dat = *m_data;
+    auto bytes = [](const auto &v) {
+      using T = typename std::decay_t<decltype(v)>::value_type;
+      return v.capacity() * sizeof(T);
+    };
+    size_t count = bytes(dat.atomic_numbers) + bytes(dat.formal_charges) +
+                   bytes(dat.partial_charges) + bytes(dat.residue_ids) +
+                   bytes(dat.charge_group_ids) + bytes(dat.names) +
+                   bytes(dat.residue_names) + bytes(dat.atom_types) +
+                   bytes(dat.bond_atoms) + bytes(dat.bond_orders) +
+                   bytes(dat.bond_types) + bytes(dat.adjacency_offsets) +
+                   bytes(dat.adjacent_atoms) + bytes(dat.adjacent_bonds) +
+                   bytes(dat.atom_type_pool) + bytes(dat.bond_type_pool);
+    count += 3 * dat.coordinates.max_size * sizeof(double);
+    for (const std::string &s : dat.strings) count += s.capacity() + sizeof(s);
+    // Approximate node based hash table cost as key, value and two pointers
+    count += dat.string_lookup.size() * (sizeof(std::string) + 24);
+    count += bytes(dat.bond_lookup);
+    return count;
+  }
+
+  // =======================================================================
+  // == COLUMNAR ATOM ======================================================
+  // =======================================================================
+
+  int64_t ColumnarAtom::NumBonds() const {
+    _sanity_check_(*this);
+    m_data->BuildAdjacency();
+    return m_data->adjacency_offsets[m_idx + 1] -
+           m_data->adjacency_offsets[m_idx];
+  }
+
+  bool ColumnarAtom::HasType() const {
+    _sanity_check_(*this);
+    return m_data->atom_types[m_idx] != 0;
+  }
+
+  Element ColumnarAtom::GetElement() const {
+    _sanity_check_(*this);
+    return GetPeriodicTable()[m_data->atomic_numbers[m_idx]];
+  }
+
+  int32_t ColumnarAtom::GetFormalCharge() const {
+    _sanity_check_(*this);
+    return m_data->formal_charges[m_idx];
+  }
+
+  double ColumnarAtom::GetPartialCharge() const {
+    _sanity_check_(*this);
+    return m_data->partial_charges[m_idx];
+  }
+
+  int32_t ColumnarAtom::GetResidueID() const {
+    _sanity_check_(*this);
+    return m_data->residue_ids[m_idx];
+  }
+
+  const std::string &ColumnarAtom::GetResidueName() const {
+    _sanity_check_(*this);
+    return m_data->strings[m_data->residue_names[m_idx]];
+  }
+
+  int32_t ColumnarAtom::GetChargeGroupID() const {
+    _sanity_check_(*this);
+    return m_data->charge_group_ids[m_idx];
+  }
+
+  const std::string &ColumnarAtom::GetName() const {
+    _sanity_check_(*this);
+    return m_data->strings[m_data->names[m_idx]];
+  }
+
+  double ColumnarAtom::GetX() const {
+    _sanity_check_(*this);
+    return m_data->coordinates.x_vals()[m_idx];
+  }
+
+  double ColumnarAtom::GetY() const {
+    _sanity_check_(*this);
+    return m_data->coordinates.y_vals()[m_idx];
+  }
+
+  double ColumnarAtom::GetZ() const {
+    _sanity_check_(*this);
+    return m_data->coordinates.z_vals()[m_idx];
+  }
+
+  Coordinates ColumnarAtom::GetPosition() const {
+    _sanity_check_(*this);
+    return m_data->coordinates[m_idx];
+  }
+
+  const FFAtom &ColumnarAtom::GetType() const {
+    _sanity_check_(*this);
+    return m_data->atom_type_pool[m_data->atom_types[m_idx]];
+  }
+
+  std::vector<ColumnarAtom> ColumnarAtom::GetNeighbours() const {
+    _sanity_check_(*this);
+    m_data->BuildAdjacency();
+    std::vector<ColumnarAtom> nbrs;
+    uint32_t begin = m_data->adjacency_offsets[m_idx];
+    uint32_t end = m_data->adjacency_offsets[m_idx + 1];
+    nbrs.reserve(end - begin);
+    for (uint32_t i = begin; i < end; ++i)
+      nbrs.emplace_back(ColumnarAtom(m_data, m_data->adjacent_atoms[i]));
+    return nbrs;
+  }
+
+  std::vector<ColumnarBond> ColumnarAtom::GetBonds() const {
+    _sanity_check_(*this);
+    m_data->BuildAdjacency();
+    std::vector<ColumnarBond> bnds;
+    uint32_t begin = m_data->adjacency_offsets[m_idx];
+    uint32_t end = m_data->adjacency_offsets[m_idx + 1];
+    bnds.reserve(end - begin);
+    for (uint32_t i = begin; i < end; ++i)
+      bnds.emplace_back(ColumnarBond(m_data, m_data->adjacent_bonds[i]));
+    return bnds;
+  }
+
+  void ColumnarAtom::SetElement(const Element &e) {
+    _sanity_check_(*this);
+    m_data->atomic_numbers[m_idx] = static_cast<uint8_t>(e.GetAtomicNumber());
+  }
+
+  void ColumnarAtom::SetFormalCharge(int32_t q) {
+    _sanity_check_(*this);
+    if (q < std::numeric_limits<int8_t>::min() ||
+        q > std::numeric_limits<int8_t>::max())
+      throw std::runtime_error("Formal charge out of range");
+    m_data->formal_charges[m_idx] = static_cast<int8_t>(q);
+  }
+
+  void ColumnarAtom::SetPartialCharge(double q) {
+    _sanity_check_(*this);
+    m_data->partial_charges[m_idx] = q;
+  }
+
+  void ColumnarAtom::SetResidueID(int32_t id) {
+    _sanity_check_(*this);
+    m_data->residue_ids[m_idx] = id;
+  }
+
+  void ColumnarAtom::SetResidueName(const std::string &name) {
+    _sanity_check_(*this);
+    m_data->residue_names[m_idx] = m_data->Intern(name);
+  }
+
+  void ColumnarAtom::SetChargeGroupID(int32_t id) {
+    _sanity_check_(*this);
+    m_data->charge_group_ids[m_idx] = id;
+  }
+
+  void ColumnarAtom::SetName(const std::string &name) {
+    _sanity_check_(*this);
+    m_data->names[m_idx] = m_data->Intern(name);
+  }
+
+  void ColumnarAtom::SetPosition(double x, double y, double z) {
+    _sanity_check_(*this);
+    m_data->coordinates.SetCoordinates(m_idx, x, y, z);
+  }
+
+  void ColumnarAtom::SetType(const FFAtom &type) {
+    _sanity_check_(*this);
+    m_data->atom_types[m_idx] = m_data->Intern(type);
+  }
+
+  // =======================================================================
+  // == COLUMNAR BOND ======================================================
+  // =======================================================================
+
+  std::array<ColumnarAtom, 2> ColumnarBond::GetAtoms() const {
+    _sanity_check_(*this);
+    const std::array<uint32_t, 2> &atms = m_data->bond_atoms[m_idx];
+    return {ColumnarAtom(m_data, atms[0]), ColumnarAtom(m_data, atms[1])};
+  }
+
+  BondOrder ColumnarBond::GetOrder() const {
+    _sanity_check_(*this);
+    return m_data->bond_orders[m_idx];
+  }
+
+  bool ColumnarBond::HasType() const {
+    _sanity_check_(*this);
+    return m_data->bond_types[m_idx] != 0;
+  }
+
+  const FFBond &ColumnarBond::GetType() const {
+    _sanity_check_(*this);
+    return m_data->bond_type_pool[m_data->bond_types[m_idx]];
+  }
+
+  double ColumnarBond::Length() const {
+    _sanity_check_(*this);
+    const std::array<uint32_t, 2> &atms = m_data->bond_atoms[m_idx];
+    const double *x = m_data->coordinates.x_vals();
+    const double *y = m_data->coordinates.y_vals();
+    const double *z = m_data->coordinates.z_vals();
+    double dx = x[atms[0]] - x[atms[1]];
+    double dy = y[atms[0]] - y[atms[1]];
+    double dz = z[atms[0]] - z[atms[1]];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+  }
+
+  void ColumnarBond::SetOrder(BondOrder order) {
+    _sanity_check_(*this);
+    m_data->bond_orders[m_idx] = order;
+  }
+
+  void ColumnarBond::SetType(const FFBond &type) {
+    _sanity_check_(*this);
+    m_data->bond_types[m_idx] = m_data->Intern(type);
+  }
+
+} // namespace indigox
@@ -0,0 +1,239 @@
+#include <indigox/classes/conformers.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/utils/mapped_file.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#ifndef INDIGOX_DISABLE_SANITY_CHECKS
+#define _sanity_check_(x)                                                      \
+  if (!x)                                                                      \
+  throw std::runtime_error(                                                    \
+      "Attempting to access data from invalid conformer set")
+#else
+#define _sanity_check_(x)
+#endif
+
+namespace indigox {
+
+  namespace {
+    // Header of a conformer file, padded so the frames after it stay 64 byte
+    // aligned in a page aligned mapping.
+    struct FileHeader {
+      char magic[8];
+      uint32_t version;
+      uint32_t byte_order;
+      uint32_t num_atoms;
+      uint32_t num_frames;
+      uint32_t stride;
+      char padding[36];
+    };
+    static_assert(sizeof(FileHeader) == 64, "Conformer header must be 64 B");
+
+    const char file_magic[8] = {'I', 'X', 'C', 'O', 'N', 'F', '\0', '\0'};
+    const uint32_t file_version = 1;
+    const uint32_t byte_order_mark = 0x01020304;
+
+    // Number of atoms per axis, padded to a whole 64 bytes
+    uint32_t PaddedStride(uint32_t num_atoms) {
+      return num_atoms + (8 - num_atoms % 8) % 8;
+    }
+  } // namespace
+
+  // =======================================================================
+  // == CONFORMER SET IMPLEMENTATION =======================================
+  // =======================================================================
+
+  struct ConformerSet::Impl {
+    uint32_t num_atoms = 0;
+    uint32_t stride = 0;
+    uint32_t num_frames = 0;
+    uint32_t capacity = 0;
+
+    // Owned storage, shared with views which outlive a reallocation
+    std::shared_ptr<char[]> memory;
+    double *frames = nullptr;
+
+    // Mapped storage
+    utils::MappedFile file;
+
+    Impl() = default;
+    Impl(uint32_t n) : num_atoms(n), stride(PaddedStride(n)) {}
+
+    size_t FrameSize() const { return 3 * size_t(stride); }
+
+    const double *Frames() const {
+      if (file)
+        return reinterpret_cast<const double *>(file.GetData() +
+                                                sizeof(FileHeader));
+      return frames;
+    }
+
+    void CheckWritable(const CoordinateFrame &frame) const {
+      if (file) throw std::runtime_error("Mapped conformer sets are read only");
+      if (frame.size != num_atoms)
+        throw std::runtime_error("Frame has wrong number of atoms");
+    }
+
+    void Copy(double *dest, const CoordinateFrame &frame) {
+      if (!num_atoms) return;
+      std::memcpy(dest, frame.x, num_atoms * sizeof(double));
+      std::memcpy(dest + stride, frame.y, num_atoms * sizeof(double));
+      std::memcpy(dest + 2 * stride, frame.z, num_atoms * sizeof(double));
+    }
+
+    void Allocate(uint32_t count) {
+      const uintptr_t align = 63;
+      size_t num_doubles = count * FrameSize();
+      std::shared_ptr<char[]> mem(
+          new char[num_doubles * sizeof(double) + align]);
+      double *data =
+          reinterpret_cast<double *>((uintptr_t(mem.get()) + align) & ~align);
+      // Zeroed so the padding of each axis is deterministic when saved
+      std::fill(data, data + num_doubles, 0.);
+      if (num_frames)
+        std::memcpy(data, frames, num_frames * FrameSize() * sizeof(double));
+      memory = std::move(mem);
+      frames = data;
+      capacity = count;
+    }
+  };
+
+  // =======================================================================
+  // == CONFORMER SET CONSTRUCTION =========================================
+  // =======================================================================
+
+  ConformerSet::ConformerSet(uint32_t num_atoms)
+      : m_data(std::make_shared<Impl>(num_atoms)) {}
+
+  ConformerSet ConformerSet::Open(const std::string &path) {
+    utils::MappedFile file(path);
+    if (file.GetSize() < sizeof(FileHeader))
+      throw std::runtime_error("Not a conformer file: " + path);
+    FileHeader header;
+    std::memcpy(&header, file.GetData(), sizeof(FileHeader));
+    if (std::memcmp(header.magic, file_magic, sizeof(file_magic)))
+      throw std::runtime_error("Not a conformer file: " + path);
+    if (header.version != file_version)
+      throw std::runtime_error("Unsupported conformer file version: " + path);
+    if (header.byte_order != byte_order_mark)
+      throw std::runtime_error("Conformer file has wrong byte order: " + path);
+    if (header.stride != PaddedStride(header.num_atoms))
+      throw std::runtime_error("Corrupt conformer file: " + path);
+
+    ConformerSet set(header.num_atoms);
+    size_t expected = sizeof(FileHeader) + size_t(header.num_frames) *
+                                               set.m_data->FrameSize() *
+                                               sizeof(double);
+    if (file.GetSize() != expected)
+      throw std::runtime_error("Corrupt conformer file: " + path);
+    set.m_data->num_frames = header.num_frames;
+    set.m_data->capacity = header.num_frames;
+    set.m_data->file = std::move(file);
+    return set;
+  }
+
+  void ConformerSet::Save(const std::string &path) const {
+    _sanity_check_(m_data);
+    FileHeader header;
+    std::memset(&header, 0, sizeof(FileHeader));
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.byte_order = byte_order_mark;
+    header.num_atoms = m_data->num_atoms;
+    header.num_frames = m_data->num_frames;
+    header.stride = m_data->stride;
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) throw std::runtime_error("Unable to open file: " + path);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(FileHeader));
+    if (m_data->num_frames)
+      out.write(reinterpret_cast<const char *>(m_data->Frames()),
+                m_data->num_frames * m_data->FrameSize() * sizeof(double));
+    if (!out) throw std::runtime_error("Unable to write file: " + path);
+  }
+
+  // =======================================================================
+  // == CONFORMER SET DATA =================================================
+  // =======================================================================
+
+  uint32_t ConformerSet::NumAtoms() const {
+    _sanity_check_(m_data);
+    return m_data->num_atoms;
+  }
+
+  uint32_t ConformerSet::NumFrames() const {
+    _sanity_check_(m_data);
+    return m_data->num_frames;
+  }
+
+  uint32_t ConformerSet::GetStride() const {
+    _sanity_check_(m_data);
+    return m_data->stride;
+  }
+
+  bool ConformerSet::IsMapped() const {
+    _sanity_check_(m_data);
+    return bool(m_data->file);
+  }
+
+  void ConformerSet::Reserve(uint32_t count) {
+    _sanity_check_(m_data);
+    if (m_data->file)
+      throw std::runtime_error("Mapped conformer sets are read only");
+    if (count > m_data->capacity) m_data->Allocate(count);
+  }
+
+  std::shared_ptr<const void> ConformerSet::GetFrameStorage() const {
+    _sanity_check_(m_data);
+    // Mapped frames are never reallocated, so the mapping only needs to
+    // outlive the set
+    if (m_data->file) return m_data;
+    return m_data->memory;
+  }
+
+  uint32_t ConformerSet::AddFrame(const CoordinateFrame &frame) {
+    _sanity_check_(m_data);
+    m_data->CheckWritable(frame);
+    if (m_data->num_frames == m_data->capacity)
+      m_data->Allocate(std::max<uint32_t>(4, 2 * m_data->capacity));
+    m_data->Copy(m_data->frames + m_data->num_frames * m_data->FrameSize(),
+                 frame);
+    return m_data->num_frames++;
+  }
+
+  uint32_t ConformerSet::AddFrame(Molecule &mol) {
+    return AddFrame(mol.GetAtomicCoordinates().Frame());
+  }
+
+  void ConformerSet::SetFrame(uint32_t index, const CoordinateFrame &frame) {
+    _sanity_check_(m_data);
+    m_data->CheckWritable(frame);
+    if (index >= m_data->num_frames)
+      throw std::out_of_range("Frame index out of range");
+    m_data->Copy(m_data->frames + index * m_data->FrameSize(), frame);
+  }
+
+  CoordinateFrame ConformerSet::GetFrame(uint32_t index) const {
+    _sanity_check_(m_data);
+    if (index >= m_data->num_frames)
+      throw std::out_of_range("Frame index out of range");
+    const double *base = m_data->Frames() + index * m_data->FrameSize();
+    uint32_t stride = m_data->stride;
+    return {base, base + stride, base + 2 * stride, m_data->num_atoms};
+  }
+
+  void ConformerSet::ApplyFrame(uint32_t index, Molecule &mol) const {
+    CoordinateFrame frame = GetFrame(index);
+    AtomicCoordinates &coords = mol.GetAtomicCoordinates();
+    if (coords.size != frame.size)
+      throw std::runtime_error("Frame has wrong number of atoms");
+    if (!frame.size) return;
+    std::memcpy(coords.x_vals(), frame.x, frame.size * sizeof(double));
+    std::memcpy(coords.y_vals(), frame.y, frame.size * sizeof(double));
+    std::memcpy(coords.z_vals(), frame.z, frame.size * sizeof(double));
+  }
+
+} // namespace indigox
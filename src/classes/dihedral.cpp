@@ -145,6 +145,8 @@ namespace indigox {
   void Dihedral::SetTag(int64_t tag) {
     _sanity_check_(*this);
     m_data->tag = tag;
+    if (m_data->molecule)
+      m_data->molecule.m_data->dihedral_index.InvalidateTags();
   }
 
   void Dihedral::SetTypes(const DihedralTypes &types) {
@@ -1,12 +1,19 @@
 #include <indigox/classes/forcefield.hpp>
 #include <indigox/classes/periodictable.hpp>
+#include <indigox/utils/mapped_file.hpp>
 #include <indigox/utils/quad.hpp>
 #include <indigox/utils/serialise.hpp>
 #include <indigox/utils/triple.hpp>
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <fstream>
 #include <initializer_list>
+#include <limits>
+#include <mutex>
 #include <numeric>
+#include <string>
 
 namespace indigox {
 
@@ -27,16 +34,25 @@ namespace indigox {
     int32_t id;
     std::string name;
     int32_t element;
-    Forcefield ff;
+    // Weak, as the forcefield owns its types
+    std::weak_ptr<Forcefield::Impl> ff;
 
     Impl() = default;
     Impl(int32_t i, std::string n, const Element &e, const Forcefield &f)
-        : id(i), name(n), element(e.GetAtomicNumber()), ff(f) {}
+        : id(i), name(n), element(e.GetAtomicNumber()), ff(f.m_data) {}
 
     template <class Archive> void serialise(Archive &archive, const uint32_t) {
+      Forcefield f = GetForcefield();
       archive(INDIGOX_SERIAL_NVP("id", id), INDIGOX_SERIAL_NVP("name", name),
               INDIGOX_SERIAL_NVP("element", element),
-              INDIGOX_SERIAL_NVP("ff", ff));
+              INDIGOX_SERIAL_NVP("ff", f));
+      if (INDIGOX_IS_INPUT_ARCHIVE(Archive)) ff = f.m_data;
+    }
+
+    Forcefield GetForcefield() const {
+      Forcefield f;
+      f.m_data = ff.lock();
+      return f;
     }
   };
 
@@ -55,6 +71,12 @@ namespace indigox {
   template <class Archive>
   void FFAtom::serialise(Archive &archive, const uint32_t) {
     archive(INDIGOX_SERIAL_NVP("data", m_data));
+    // Use the matching type of the shared forcefield, once it is loaded
+    if (INDIGOX_IS_INPUT_ARCHIVE(Archive) && m_data) {
+      Forcefield ff = m_data->GetForcefield().GetShared();
+      FFAtom type = ff ? ff.GetAtomType(m_data->id) : FFAtom();
+      if (type && type.m_data->name == m_data->name) m_data = type.m_data;
+    }
   }
   INDIGOX_SERIALISE(FFAtom);
 
@@ -72,7 +94,7 @@ namespace indigox {
   }
   Forcefield FFAtom::GetForcefield() const {
     _sanity_check_(*this);
-    return m_data->ff;
+    return m_data->GetForcefield();
   }
   Element FFAtom::GetElement() const {
     _sanity_check_(*this);
@@ -127,11 +149,12 @@ namespace indigox {
     FFBond::DataStore raw_data;
     FFBond::AllowedMask allowed_parameters;
     FFBond linked_bond;
-    Forcefield ff;
+    // Weak, as the forcefield owns its types
+    std::weak_ptr<Forcefield::Impl> ff;
 
     Impl() = default;
     Impl(BondType t, int32_t i, FFParam data, const Forcefield &f)
-        : type(t), id(i), linked_bond(), ff(f) {
+        : type(t), id(i), linked_bond(), ff(f.m_data) {
       if (t == BondType::Harmonic) allowed_parameters.from_uint32(3);
       if (t == BondType::Quartic) allowed_parameters.from_uint32(3);
       raw_data.fill(0);
@@ -141,11 +164,19 @@ namespace indigox {
     }
 
     template <class Archive> void serialise(Archive &archive, const uint32_t) {
+      Forcefield f = GetForcefield();
       archive(INDIGOX_SERIAL_NVP("type", type), INDIGOX_SERIAL_NVP("id", id),
               INDIGOX_SERIAL_NVP("raw_data", raw_data),
               INDIGOX_SERIAL_NVP("allowed", allowed_parameters),
               INDIGOX_SERIAL_NVP("linked_bond_type", linked_bond),
-              INDIGOX_SERIAL_NVP("ff", ff));
+              INDIGOX_SERIAL_NVP("ff", f));
+      if (INDIGOX_IS_INPUT_ARCHIVE(Archive)) ff = f.m_data;
+    }
+
+    Forcefield GetForcefield() const {
+      Forcefield f;
+      f.m_data = ff.lock();
+      return f;
     }
   };
 
@@ -164,6 +195,12 @@ namespace indigox {
   template <class Archive>
   void FFBond::serialise(Archive &archive, const uint32_t) {
     archive(INDIGOX_SERIAL_NVP("data", m_data));
+    // Use the matching type of the shared forcefield, once it is loaded
+    if (INDIGOX_IS_INPUT_ARCHIVE(Archive) && m_data) {
+      Forcefield ff = m_data->GetForcefield().GetShared();
+      FFBond type = ff ? ff.GetBondType(m_data->type, m_data->id) : FFBond();
+      if (type) m_data = type.m_data;
+    }
   }
   INDIGOX_SERIALISE(FFBond)
 
@@ -199,7 +236,7 @@ namespace indigox {
   }
   Forcefield FFBond::GetForcefield() const {
     _sanity_check_(*this);
-    return m_data->ff;
+    return m_data->GetForcefield();
   }
 
   // ===========================================================================
@@ -263,11 +300,12 @@ namespace indigox {
     FFAngle::DataStore raw_data;
     FFAngle::AllowedMask allowed_parameters;
     FFAngle linked_angle;
-    Forcefield ff;
+    // Weak, as the forcefield owns its types
+    std::weak_ptr<Forcefield::Impl> ff;
 
     Impl() = default;
     Impl(AngleType t, int32_t i, FFParam data, const Forcefield &f)
-        : type(t), id(i), linked_angle(), ff(f) {
+        : type(t), id(i), linked_angle(), ff(f.m_data) {
       if (t == AngleType::Harmonic) allowed_parameters.from_uint32(3);
       if (t == AngleType::CosineHarmonic) allowed_parameters.from_uint32(3);
       raw_data.fill(0);
@@ -277,11 +315,19 @@ namespace indigox {
     }
 
     template <class Archive> void serialise(Archive &archive, const uint32_t) {
+      Forcefield f = GetForcefield();
       archive(INDIGOX_SERIAL_NVP("type", type), INDIGOX_SERIAL_NVP("id", id),
               INDIGOX_SERIAL_NVP("raw_data", raw_data),
               INDIGOX_SERIAL_NVP("allwed_mask", allowed_parameters),
               INDIGOX_SERIAL_NVP("link", linked_angle),
-              INDIGOX_SERIAL_NVP("ff", ff));
+              INDIGOX_SERIAL_NVP("ff", f));
+      if (INDIGOX_IS_INPUT_ARCHIVE(Archive)) ff = f.m_data;
+    }
+
+    Forcefield GetForcefield() const {
+      Forcefield f;
+      f.m_data = ff.lock();
+      return f;
     }
   };
 
@@ -300,6 +346,12 @@ namespace indigox {
   template <class Archive>
   void FFAngle::serialise(Archive &archive, const uint32_t) {
     archive(INDIGOX_SERIAL_NVP("data", m_data));
+    // Use the matching type of the shared forcefield, once it is loaded
+    if (INDIGOX_IS_INPUT_ARCHIVE(Archive) && m_data) {
+      Forcefield ff = m_data->GetForcefield().GetShared();
+      FFAngle type = ff ? ff.GetAngleType(m_data->type, m_data->id) : FFAngle();
+      if (type) m_data = type.m_data;
+    }
   }
   INDIGOX_SERIALISE(FFAngle);
 
@@ -335,7 +387,7 @@ namespace indigox {
   }
   Forcefield FFAngle::GetForcefield() const {
     _sanity_check_(*this);
-    return m_data->ff;
+    return m_data->GetForcefield();
   }
 
   // ===========================================================================
@@ -397,11 +449,12 @@ namespace indigox {
     int32_t id;
     FFDihedral::DataStore raw_data;
     FFDihedral::AllowedMask allowed_parameters;
-    Forcefield ff;
+    // Weak, as the forcefield owns its types
+    std::weak_ptr<Forcefield::Impl> ff;
 
     Impl() = default;
     Impl(DihedralType t, int32_t i, FFParam data, const Forcefield &f)
-        : type(t), id(i), ff(f) {
+        : type(t), id(i), ff(f.m_data) {
       if (t == DihedralType::Proper) allowed_parameters.from_uint32(7);
       if (t == DihedralType::Improper) allowed_parameters.from_uint32(10);
       raw_data.fill(0);
@@ -411,10 +464,18 @@ namespace indigox {
     }
 
     template <class Archive> void serialise(Archive &archive, const uint32_t) {
+      Forcefield f = GetForcefield();
       archive(INDIGOX_SERIAL_NVP("type", type), INDIGOX_SERIAL_NVP("id", id),
               INDIGOX_SERIAL_NVP("raw_data", raw_data),
               INDIGOX_SERIAL_NVP("allwed_mask", allowed_parameters),
-              INDIGOX_SERIAL_NVP("ff", ff));
+              INDIGOX_SERIAL_NVP("ff", f));
+      if (INDIGOX_IS_INPUT_ARCHIVE(Archive)) ff = f.m_data;
+    }
+
+    Forcefield GetForcefield() const {
+      Forcefield f;
+      f.m_data = ff.lock();
+      return f;
     }
   };
 
@@ -434,6 +495,13 @@ namespace indigox {
   template <class Archive>
   void FFDihedral::serialise(Archive &archive, const uint32_t) {
     archive(INDIGOX_SERIAL_NVP("data", m_data));
+    // Use the matching type of the shared forcefield, once it is loaded
+    if (INDIGOX_IS_INPUT_ARCHIVE(Archive) && m_data) {
+      Forcefield ff = m_data->GetForcefield().GetShared();
+      FFDihedral type =
+          ff ? ff.GetDihedralType(m_data->type, m_data->id) : FFDihedral();
+      if (type) m_data = type.m_data;
+    }
   }
   INDIGOX_SERIALISE(FFDihedral);
 
@@ -479,7 +547,7 @@ namespace indigox {
   }
   Forcefield FFDihedral::GetForcefield() const {
     _sanity_check_(*this);
-    return m_data->ff;
+    return m_data->GetForcefield();
   }
 
   // ===========================================================================
@@ -531,6 +599,181 @@ namespace indigox {
 #define _sanity_check_(x)
 #endif
 
+  // ===========================================================================
+  // == Forcefield Lookup Tables ===============================================
+  // ===========================================================================
+
+  namespace {
+    const uint32_t no_position = std::numeric_limits<uint32_t>::max();
+
+    // Position of the first type with each ID. IDs are small and dense in
+    // practice so are used directly as indices, with a map for any outliers.
+    class IDIndex {
+      static const int32_t dense_limit = 1 << 16;
+      std::vector<uint32_t> dense;
+      std::map<int32_t, uint32_t> sparse;
+
+    public:
+      uint32_t Find(int32_t id) const {
+        if (id >= 0 && id < dense_limit)
+          return size_t(id) < dense.size() ? dense[id] : no_position;
+        auto pos = sparse.find(id);
+        return pos == sparse.end() ? no_position : pos->second;
+      }
+
+      // Earlier types with the same ID take precedence
+      void Insert(int32_t id, uint32_t position) {
+        if (Find(id) != no_position) return;
+        if (id >= 0 && id < dense_limit) {
+          if (size_t(id) >= dense.size()) dense.resize(id + 1, no_position);
+          dense[id] = position;
+        } else {
+          sparse.emplace(id, position);
+        }
+      }
+
+      void Clear() {
+        dense.clear();
+        sparse.clear();
+      }
+    };
+
+    // Open-addressing hash table giving the position of the first type with
+    // each name. Types are never removed so no tombstones are needed.
+    class NameIndex {
+      std::vector<std::string> names;
+      std::vector<uint32_t> positions;
+      size_t count = 0;
+
+      static size_t Hash(const std::string &name) {
+        // FNV-1a
+        uint64_t h = 0xCBF29CE484222325ULL;
+        for (unsigned char c : name) {
+          h ^= c;
+          h *= 0x100000001B3ULL;
+        }
+        return static_cast<size_t>(h ^ (h >> 32));
+      }
+
+      size_t Probe(const std::string &name) const {
+        size_t mask = positions.size() - 1;
+        size_t pos = Hash(name) & mask;
+        while (positions[pos] != no_position && names[pos] != name)
+          pos = (pos + 1) & mask;
+        return pos;
+      }
+
+      void Rehash(size_t capacity) {
+        std::vector<std::string> old_names(capacity);
+        std::vector<uint32_t> old_positions(capacity, no_position);
+        old_names.swap(names);
+        old_positions.swap(positions);
+        for (size_t i = 0; i < old_positions.size(); ++i) {
+          if (old_positions[i] == no_position) continue;
+          size_t pos = Probe(old_names[i]);
+          names[pos] = std::move(old_names[i]);
+          positions[pos] = old_positions[i];
+        }
+      }
+
+    public:
+      uint32_t Find(const std::string &name) const {
+        if (!count) return no_position;
+        return positions[Probe(name)];
+      }
+
+      // Earlier types with the same name take precedence
+      void Insert(const std::string &name, uint32_t position) {
+        if (2 * (count + 1) > positions.size())
+          Rehash(std::max<size_t>(16, 2 * positions.size()));
+        size_t pos = Probe(name);
+        if (positions[pos] != no_position) return;
+        names[pos] = name;
+        positions[pos] = position;
+        ++count;
+      }
+
+      void Clear() {
+        names.clear();
+        positions.clear();
+        count = 0;
+      }
+    };
+
+    // Order dependent hash of forcefield contents
+    class Hasher {
+      uint64_t h = 0x9E3779B97F4A7C15ULL;
+
+    public:
+      void Add(uint64_t v) {
+        h ^= v + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 31;
+      }
+      void Add(int32_t v) { Add(static_cast<uint64_t>(uint32_t(v))); }
+      void Add(double v) {
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof(double));
+        Add(bits);
+      }
+      void Add(const std::string &v) {
+        Add(static_cast<uint64_t>(v.size()));
+        for (unsigned char c : v) Add(static_cast<uint64_t>(c));
+      }
+      uint64_t Get() const { return h; }
+    };
+
+    // Header of a compact forcefield file
+    struct FileHeader {
+      char magic[8];
+      uint32_t version;
+      uint32_t byte_order;
+      uint32_t family;
+      uint32_t num_atoms;
+      uint32_t num_bonds;
+      uint32_t num_angles;
+      uint32_t num_dihedrals;
+      uint32_t name_length;
+      uint32_t strings_size;
+      char padding[20];
+    };
+    static_assert(sizeof(FileHeader) == 64, "Forcefield header must be 64 B");
+
+    struct AtomRecord {
+      int32_t id;
+      int32_t element;
+      uint32_t name_offset;
+      uint32_t name_length;
+    };
+
+    // Bond, angle or dihedral type. Linked types are given by their record
+    // index among types of the same kind.
+    struct TermRecord {
+      uint32_t form;
+      int32_t id;
+      int32_t linked;
+      uint32_t num_params;
+      double params[3];
+    };
+    static_assert(sizeof(TermRecord) == 40, "Unexpected term record padding");
+
+    const char file_magic[8] = {'I', 'X', 'F', 'F', 'L', 'D', '\0', '\0'};
+    const uint32_t file_version = 1;
+    const uint32_t byte_order_mark = 0x01020304;
+
+    // Call add with the parameters of a record
+    template <class Add> void WithParams(const TermRecord &rec, Add &&add) {
+      const double *p = rec.params;
+      switch (rec.num_params) {
+      case 0: add(FFParam{}); break;
+      case 1: add(FFParam{p[0]}); break;
+      case 2: add(FFParam{p[0], p[1]}); break;
+      case 3: add(FFParam{p[0], p[1], p[2]}); break;
+      default: throw std::runtime_error("Corrupt forcefield file");
+      }
+    }
+  } // namespace
+
   // ===========================================================================
   // == Forcefield Data Implementation =========================================
   // ===========================================================================
@@ -543,6 +786,29 @@ namespace indigox {
     Forcefield::AngleTypes angles;
     Forcefield::DihedralTypes dihedrals;
 
+    // Sharing state. Built in forcefields are archived as a reference only,
+    // and loaded forcefields are swapped for the shared one they resolve to.
+    bool shared = false;
+    bool builtin = false;
+    bool loaded = false;
+    uint64_t hash = 0;
+    std::weak_ptr<Impl> shared_as;
+
+    // Registry of shared forcefields, which are released once no longer used
+    static std::mutex registry_mutex;
+    static std::vector<std::weak_ptr<Impl>> registry;
+
+    // Archive version of the Forcefield being loaded. The data is loaded
+    // through its pointer, so is only given its own version otherwise.
+    static thread_local uint32_t loading_version;
+
+    // Lookup tables, rebuilt rather than serialised
+    NameIndex atom_names;
+    IDIndex atom_ids;
+    std::map<BondType, IDIndex> bond_ids;
+    std::map<AngleType, IDIndex> angle_ids;
+    std::map<DihedralType, IDIndex> dihedral_ids;
+
     Impl() = default;
     Impl(FFFamily fam, std::string nme) : family(fam), name(nme) {
       using BndStr = Forcefield::BondTypes::mapped_type;
@@ -577,36 +843,126 @@ namespace indigox {
     }
 
     template <class Archive> void serialise(Archive &archive, const uint32_t) {
+      if (INDIGOX_IS_OUTPUT_ARCHIVE(Archive) && !shared) hash = ContentHash();
+      bool reference = builtin;
       archive(INDIGOX_SERIAL_NVP("family", family),
-              INDIGOX_SERIAL_NVP("name", name),
-              INDIGOX_SERIAL_NVP("atoms", atoms),
-              INDIGOX_SERIAL_NVP("bonds", bonds),
-              INDIGOX_SERIAL_NVP("angles", angles),
-              INDIGOX_SERIAL_NVP("dihedrals", dihedrals));
+              INDIGOX_SERIAL_NVP("name", name));
+      // Version 0 archives hold the full data, without hash or reference
+      bool legacy = INDIGOX_IS_INPUT_ARCHIVE(Archive) && loading_version < 1;
+      if (legacy) reference = false;
+      else
+        archive(INDIGOX_SERIAL_NVP("hash", hash),
+                INDIGOX_SERIAL_NVP("reference", reference));
+      if (!reference)
+        archive(INDIGOX_SERIAL_NVP("atoms", atoms),
+                INDIGOX_SERIAL_NVP("bonds", bonds),
+                INDIGOX_SERIAL_NVP("angles", angles),
+                INDIGOX_SERIAL_NVP("dihedrals", dihedrals));
+      if (INDIGOX_IS_INPUT_ARCHIVE(Archive)) {
+        builtin = reference;
+        BuildIndices();
+        if (legacy) hash = ContentHash();
+        loaded = true;
+      }
+    }
+
+    void CheckMutable() const {
+      if (shared) throw std::runtime_error("Shared forcefields are immutable");
+    }
+
+    uint64_t ContentHash() const {
+      Hasher h;
+      h.Add(static_cast<uint64_t>(family));
+      h.Add(name);
+      h.Add(static_cast<uint64_t>(atoms.size()));
+      for (const FFAtom &atm : atoms) {
+        h.Add(atm.m_data->id);
+        h.Add(atm.m_data->name);
+        h.Add(atm.m_data->element);
+      }
+      auto add_terms = [&h](auto &types, auto linked) {
+        for (auto &form : types) {
+          h.Add(static_cast<uint64_t>(form.first));
+          h.Add(static_cast<uint64_t>(form.second.size()));
+          for (auto &typ : form.second) {
+            h.Add(typ.m_data->id);
+            for (double v : typ.m_data->raw_data) h.Add(v);
+            auto link = linked(typ);
+            h.Add(link ? static_cast<uint64_t>(link.GetType()) : 0);
+            h.Add(link ? link.GetID() : 0);
+          }
+        }
+      };
+      add_terms(bonds, [](const FFBond &b) { return b.m_data->linked_bond; });
+      add_terms(angles,
+                [](const FFAngle &a) { return a.m_data->linked_angle; });
+      add_terms(dihedrals, [](const FFDihedral &) { return FFDihedral(); });
+      return h.Get();
+    }
+
+    // Registered forcefield equal to the given key, if any. Requires the
+    // registry lock. Forcefields no longer in use are pruned.
+    static std::shared_ptr<Impl> FindShared(FFFamily f, const std::string &n,
+                                            uint64_t h) {
+      std::shared_ptr<Impl> found;
+      auto pos = registry.begin();
+      for (std::weak_ptr<Impl> &entry : registry) {
+        std::shared_ptr<Impl> ff = entry.lock();
+        if (!ff) continue;
+        if (!found && ff->family == f && ff->hash == h && ff->name == n)
+          found = ff;
+        *pos++ = std::move(entry);
+      }
+      registry.erase(pos, registry.end());
+      return found;
+    }
+
+    template <class Types, class Indices>
+    static void BuildIndices(const Types &types, Indices &indices) {
+      indices.clear();
+      for (auto &typ : types) {
+        IDIndex &index = indices[typ.first];
+        for (uint32_t i = 0; i < typ.second.size(); ++i)
+          index.Insert(typ.second[i].GetID(), i);
+      }
+    }
+
+    void BuildIndices() {
+      atom_names.Clear();
+      atom_ids.Clear();
+      for (uint32_t i = 0; i < atoms.size(); ++i) {
+        atom_names.Insert(atoms[i].GetName(), i);
+        atom_ids.Insert(atoms[i].GetID(), i);
+      }
+      BuildIndices(bonds, bond_ids);
+      BuildIndices(angles, angle_ids);
+      BuildIndices(dihedrals, dihedral_ids);
+    }
+
+    // Type of the given form and ID, or an empty handle
+    template <class Types, class Indices, class Form>
+    static typename Types::mapped_type::value_type
+    Find(const Types &types, const Indices &indices, Form t, int32_t i) {
+      auto index = indices.find(t);
+      if (index == indices.end()) return {};
+      uint32_t pos = index->second.Find(i);
+      if (pos == no_position) return {};
+      return types.at(t)[pos];
     }
 
     bool Contains(BondType t) { return bonds.find(t) != bonds.end(); }
     bool Contains(BondType t, int32_t i) {
-      if (!Contains(t)) return false;
-      return (std::find_if(bonds.at(t).begin(), bonds.at(t).end(),
-                           [&i](auto &b) { return b.GetID() == i; }) !=
-              bonds.at(t).end());
+      return bool(Find(bonds, bond_ids, t, i));
     }
     bool Contains(AngleType t) { return angles.find(t) != angles.end(); }
     bool Contains(AngleType t, int32_t i) {
-      if (!Contains(t)) return false;
-      return (std::find_if(angles.at(t).begin(), angles.at(t).end(),
-                           [&i](auto &b) { return b.GetID() == i; }) !=
-              angles.at(t).end());
+      return bool(Find(angles, angle_ids, t, i));
     }
     bool Contains(DihedralType t) {
       return dihedrals.find(t) != dihedrals.end();
     }
     bool Contains(DihedralType t, int32_t i) {
-      if (!Contains(t)) return false;
-      return (std::find_if(dihedrals.at(t).begin(), dihedrals.at(t).end(),
-                           [&i](auto &b) { return b.GetID() == i; }) !=
-              dihedrals.at(t).end());
+      return bool(Find(dihedrals, dihedral_ids, t, i));
     }
   };
 
@@ -614,6 +970,10 @@ namespace indigox {
   // == Forcefield Construction and Assignment =================================
   // ===========================================================================
 
+  std::mutex Forcefield::Impl::registry_mutex;
+  std::vector<std::weak_ptr<Forcefield::Impl>> Forcefield::Impl::registry;
+  thread_local uint32_t Forcefield::Impl::loading_version = 0;
+
   Forcefield::Forcefield(FFFamily family, std::string name)
       : m_data(std::make_shared<Impl>(family, name)) {}
 
@@ -622,58 +982,291 @@ namespace indigox {
   // ===========================================================================
 
   template <class Archive>
-  void Forcefield::serialise(Archive &archive, const uint32_t) {
+  void Forcefield::serialise(Archive &archive, const uint32_t version) {
+    if (INDIGOX_IS_INPUT_ARCHIVE(Archive)) Impl::loading_version = version;
     archive(INDIGOX_SERIAL_NVP("data", m_data));
+    // Swap for the shared equivalent, unless still within loading the data
+    if (!INDIGOX_IS_INPUT_ARCHIVE(Archive) || !m_data || !m_data->loaded)
+      return;
+    Forcefield shared = GetShared();
+    // Built in forcefields are registered when first generated, so that
+    // older archives holding a full copy of one also resolve to it
+    if (!shared && m_data->family == FFFamily::GROMOS &&
+        m_data->name == "54A7")
+      GenerateGROMOS54A7();
+    if (!shared && m_data->builtin) {
+      std::lock_guard<std::mutex> lock(Impl::registry_mutex);
+      shared.m_data =
+          Impl::FindShared(m_data->family, m_data->name, m_data->hash);
+      if (!shared)
+        throw std::runtime_error("Saved forcefield " + m_data->name +
+                                 " does not match any built in forcefield");
+    } else if (!shared) {
+      shared = Share();
+    }
+    m_data->shared_as = shared.m_data;
+    m_data = shared.m_data;
   }
   INDIGOX_SERIALISE(Forcefield);
 
+  // ===========================================================================
+  // == Forcefield Sharing =====================================================
+  // ===========================================================================
+
+  uint64_t Forcefield::GetHash() const {
+    _sanity_check_(*this);
+    return m_data->shared ? m_data->hash : m_data->ContentHash();
+  }
+
+  bool Forcefield::IsShared() const {
+    _sanity_check_(*this);
+    return m_data->shared;
+  }
+
+  Forcefield Forcefield::Share() const {
+    _sanity_check_(*this);
+    uint64_t hash = GetHash();
+    std::lock_guard<std::mutex> lock(Impl::registry_mutex);
+    if (m_data->shared) return *this;
+    Forcefield ff;
+    ff.m_data = Impl::FindShared(m_data->family, m_data->name, hash);
+    if (ff) return ff;
+    m_data->hash = hash;
+    m_data->shared = true;
+    Impl::registry.emplace_back(m_data);
+    return *this;
+  }
+
+  Forcefield Forcefield::GetShared() const {
+    Forcefield ff;
+    if (!m_data) return ff;
+    if (m_data->shared) return *this;
+    ff.m_data = m_data->shared_as.lock();
+    return ff;
+  }
+
+  // ===========================================================================
+  // == Forcefield Files =======================================================
+  // ===========================================================================
+
+  Forcefield Forcefield::Open(const std::string &path) {
+    utils::MappedFile file(path);
+    if (file.GetSize() < sizeof(FileHeader))
+      throw std::runtime_error("Not a forcefield file: " + path);
+    FileHeader header;
+    std::memcpy(&header, file.GetData(), sizeof(FileHeader));
+    if (std::memcmp(header.magic, file_magic, sizeof(file_magic)))
+      throw std::runtime_error("Not a forcefield file: " + path);
+    if (header.version != file_version)
+      throw std::runtime_error("Unsupported forcefield file version: " + path);
+    if (header.byte_order != byte_order_mark)
+      throw std::runtime_error("Forcefield file has wrong byte order: " + path);
+    size_t num_terms = size_t(header.num_bonds) + header.num_angles +
+                       header.num_dihedrals;
+    size_t expected = sizeof(FileHeader) +
+                      header.num_atoms * sizeof(AtomRecord) +
+                      num_terms * sizeof(TermRecord) + header.strings_size;
+    if (file.GetSize() != expected || header.name_length > header.strings_size)
+      throw std::runtime_error("Corrupt forcefield file: " + path);
+
+    const char *data = file.GetData() + sizeof(FileHeader);
+    const AtomRecord *atoms = reinterpret_cast<const AtomRecord *>(data);
+    const TermRecord *terms = reinterpret_cast<const TermRecord *>(
+        data + header.num_atoms * sizeof(AtomRecord));
+    const char *strings = data + header.num_atoms * sizeof(AtomRecord) +
+                          num_terms * sizeof(TermRecord);
+    auto get_string = [&](uint32_t offset, uint32_t length) {
+      if (size_t(offset) + length > header.strings_size)
+        throw std::runtime_error("Corrupt forcefield file: " + path);
+      return std::string(strings + offset, length);
+    };
+
+    Forcefield ff(static_cast<FFFamily>(header.family),
+                  get_string(0, header.name_length));
+    PeriodicTable PT = GetPeriodicTable();
+    ff.ReserveAtomTypes(header.num_atoms);
+    for (uint32_t i = 0; i < header.num_atoms; ++i) {
+      const AtomRecord &rec = atoms[i];
+      ff.NewAtomType(rec.id, get_string(rec.name_offset, rec.name_length),
+                     PT[rec.element]);
+    }
+
+    // Each kind of term, then links between types of the same kind
+    auto read_terms = [&](auto new_type, auto link, const TermRecord *recs,
+                          uint32_t count) {
+      using Type = decltype(new_type(recs[0], FFParam{}));
+      std::vector<Type> types;
+      types.reserve(count);
+      for (uint32_t i = 0; i < count; ++i) {
+        WithParams(recs[i], [&](FFParam param) {
+          types.emplace_back(new_type(recs[i], param));
+        });
+      }
+      for (uint32_t i = 0; i < count; ++i) {
+        int32_t j = recs[i].linked;
+        if (j < 0 || uint32_t(j) <= i) continue;
+        if (uint32_t(j) >= count)
+          throw std::runtime_error("Corrupt forcefield file: " + path);
+        link(types[i], types[j]);
+      }
+    };
+    read_terms(
+        [&ff](const TermRecord &r, FFParam p) {
+          return ff.NewBondType(static_cast<BondType>(r.form), r.id, p);
+        },
+        [&ff](FFBond &a, FFBond &b) { ff.LinkBondTypes(a, b); }, terms,
+        header.num_bonds);
+    terms += header.num_bonds;
+    read_terms(
+        [&ff](const TermRecord &r, FFParam p) {
+          return ff.NewAngleType(static_cast<AngleType>(r.form), r.id, p);
+        },
+        [&ff](FFAngle &a, FFAngle &b) { ff.LinkAngleTypes(a, b); }, terms,
+        header.num_angles);
+    terms += header.num_angles;
+    read_terms(
+        [&ff](const TermRecord &r, FFParam p) {
+          return ff.NewDihedralType(static_cast<DihedralType>(r.form), r.id,
+                                    p);
+        },
+        [](FFDihedral &, FFDihedral &) {}, terms, header.num_dihedrals);
+    return ff.Share();
+  }
+
+  void Forcefield::Save(const std::string &path) const {
+    _sanity_check_(*this);
+    std::string strings = m_data->name;
+    std::vector<AtomRecord> atoms;
+    atoms.reserve(m_data->atoms.size());
+    for (const FFAtom &atm : m_data->atoms) {
+      AtomRecord rec;
+      rec.id = atm.m_data->id;
+      rec.element = atm.m_data->element;
+      rec.name_offset = uint32_t(strings.size());
+      rec.name_length = uint32_t(atm.m_data->name.size());
+      strings += atm.m_data->name;
+      atoms.emplace_back(rec);
+    }
+
+    std::vector<TermRecord> terms;
+    auto write_terms = [&terms](auto &types, auto linked) {
+      // Record index of each type, for links
+      std::map<const void *, int32_t> index;
+      int32_t count = 0;
+      for (auto &form : types) {
+        for (auto &typ : form.second) index.emplace(typ.m_data.get(), count++);
+      }
+      for (auto &form : types) {
+        for (auto &typ : form.second) {
+          TermRecord rec;
+          std::memset(&rec, 0, sizeof(TermRecord));
+          rec.form = static_cast<uint32_t>(form.first);
+          rec.id = typ.m_data->id;
+          auto link = linked(typ);
+          rec.linked = link ? index.at(link.m_data.get()) : -1;
+          rec.num_params = uint32_t(typ.m_data->allowed_parameters.count());
+          std::copy(typ.m_data->raw_data.begin(),
+                    typ.m_data->raw_data.begin() + rec.num_params, rec.params);
+          terms.emplace_back(rec);
+        }
+      }
+      return uint32_t(count);
+    };
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(FileHeader));
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.byte_order = byte_order_mark;
+    header.family = static_cast<uint32_t>(m_data->family);
+    header.num_atoms = uint32_t(atoms.size());
+    header.num_bonds = write_terms(
+        m_data->bonds, [](const FFBond &b) { return b.m_data->linked_bond; });
+    header.num_angles = write_terms(m_data->angles, [](const FFAngle &a) {
+      return a.m_data->linked_angle;
+    });
+    header.num_dihedrals = write_terms(
+        m_data->dihedrals, [](const FFDihedral &) { return FFDihedral(); });
+    header.name_length = uint32_t(m_data->name.size());
+    header.strings_size = uint32_t(strings.size());
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) throw std::runtime_error("Unable to open file: " + path);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(FileHeader));
+    out.write(reinterpret_cast<const char *>(atoms.data()),
+              atoms.size() * sizeof(AtomRecord));
+    out.write(reinterpret_cast<const char *>(terms.data()),
+              terms.size() * sizeof(TermRecord));
+    out.write(strings.data(), strings.size());
+    if (!out) throw std::runtime_error("Unable to write file: " + path);
+  }
+
   // ===========================================================================
   // == Forcefield Data Modification ===========================================
   // ===========================================================================
 
   FFBond Forcefield::NewBondType(BondType type, int32_t id, FFParam param) {
     _sanity_check_(*this);
+    m_data->CheckMutable();
     if (!m_data->Contains(type))
       throw std::out_of_range("Unsupported bond type");
     if (m_data->Contains(type, id))
       throw std::out_of_range("Bond ID already exists");
-    m_data->bonds[type].emplace_back(FFBond(type, id, param, *this));
-    return m_data->bonds[type].back();
+    std::vector<FFBond> &types = m_data->bonds[type];
+    m_data->bond_ids[type].Insert(id, types.size());
+    types.emplace_back(FFBond(type, id, param, *this));
+    return types.back();
   }
 
   FFAngle Forcefield::NewAngleType(AngleType type, int32_t id, FFParam param) {
     _sanity_check_(*this);
+    m_data->CheckMutable();
     if (!m_data->Contains(type))
       throw std::out_of_range("Unsupported angle type");
     if (m_data->Contains(type, id))
       throw std::out_of_range("Angle ID already exists");
-    m_data->angles[type].emplace_back(FFAngle(type, id, param, *this));
-    return m_data->angles[type].back();
+    std::vector<FFAngle> &types = m_data->angles[type];
+    m_data->angle_ids[type].Insert(id, types.size());
+    types.emplace_back(FFAngle(type, id, param, *this));
+    return types.back();
   }
 
   FFDihedral Forcefield::NewDihedralType(DihedralType type, int32_t id,
                                          FFParam param) {
     _sanity_check_(*this);
+    m_data->CheckMutable();
     if (!m_data->Contains(type))
       throw std::out_of_range("Unsupported dihedral type");
     if (m_data->Contains(type, id))
       throw std::out_of_range("Dihedral ID already exists");
-    m_data->dihedrals[type].emplace_back(FFDihedral(type, id, param, *this));
-    return m_data->dihedrals[type].back();
+    std::vector<FFDihedral> &types = m_data->dihedrals[type];
+    m_data->dihedral_ids[type].Insert(id, types.size());
+    types.emplace_back(FFDihedral(type, id, param, *this));
+    return types.back();
   }
 
   FFAtom Forcefield::NewAtomType(int32_t id, std::string name,
                                  const Element &element) {
     _sanity_check_(*this);
+    m_data->CheckMutable();
     FFAtom atm(id, name, element, *this);
-    if (std::find(m_data->atoms.begin(), m_data->atoms.end(), atm) !=
-        m_data->atoms.end())
+    // Only search when both the name and ID are already in use
+    if (m_data->atom_names.Find(name) != no_position &&
+        m_data->atom_ids.Find(id) != no_position &&
+        std::find(m_data->atoms.begin(), m_data->atoms.end(), atm) !=
+            m_data->atoms.end())
       throw std::out_of_range("Atom type already exists");
+    m_data->atom_names.Insert(name, m_data->atoms.size());
+    m_data->atom_ids.Insert(id, m_data->atoms.size());
     m_data->atoms.emplace_back(atm);
     return m_data->atoms.back();
   }
 
-  void Forcefield::ReserveAtomTypes(size_t sz) { m_data->atoms.reserve(sz); }
+  void Forcefield::ReserveAtomTypes(size_t sz) {
+    _sanity_check_(*this);
+    m_data->CheckMutable();
+    m_data->atoms.reserve(sz);
+  }
 
   FFBond Forcefield::NewBondType(BondType t, int32_t i, double a, double b) {
     return NewBondType(t, i, {a, b});
@@ -681,6 +1274,7 @@ namespace indigox {
 
   void Forcefield::LinkBondTypes(const FFBond &a, const FFBond &b) {
     _sanity_check_(*this);
+    m_data->CheckMutable();
     _sanity_check_(a);
     _sanity_check_(b);
     a.m_data->linked_bond = b;
@@ -688,6 +1282,8 @@ namespace indigox {
   }
 
   void Forcefield::ReserveBondTypes(BondType type, size_t size) {
+    _sanity_check_(*this);
+    m_data->CheckMutable();
     if (m_data->Contains(type)) m_data->bonds.at(type).reserve(size);
   }
 
@@ -697,6 +1293,7 @@ namespace indigox {
 
   void Forcefield::LinkAngleTypes(const FFAngle &a, const FFAngle &b) {
     _sanity_check_(*this);
+    m_data->CheckMutable();
     _sanity_check_(a);
     _sanity_check_(b);
     a.m_data->linked_angle = b;
@@ -704,6 +1301,8 @@ namespace indigox {
   }
 
   void Forcefield::ReserveAngleTypes(AngleType type, size_t size) {
+    _sanity_check_(*this);
+    m_data->CheckMutable();
     if (m_data->Contains(type)) m_data->angles.at(type).reserve(size);
   }
 
@@ -719,6 +1318,7 @@ namespace indigox {
 
   void Forcefield::ReserveDihedralTypes(DihedralType type, size_t size) {
     _sanity_check_(*this);
+    m_data->CheckMutable();
     if (m_data->Contains(type)) m_data->dihedrals.at(type).reserve(size);
   }
 
@@ -733,32 +1333,21 @@ namespace indigox {
 
   FFAtom Forcefield::GetAtomType(std::string name) const {
     _sanity_check_(*this);
-    auto bgn = m_data->atoms.begin();
-    auto end = m_data->atoms.end();
-    auto fnd = [&name](FFAtom atm) { return atm.GetName() == name; };
-    auto pos = std::find_if(bgn, end, fnd);
-    return (pos == end) ? FFAtom() : *pos;
+    uint32_t pos = m_data->atom_names.Find(name);
+    return (pos == no_position) ? FFAtom() : m_data->atoms[pos];
   }
 
   FFAtom Forcefield::GetAtomType(int32_t id) const {
     _sanity_check_(*this);
-    auto bgn = m_data->atoms.begin();
-    auto end = m_data->atoms.end();
-    auto fnd = [&id](auto &Z) { return Z.GetID() == id; };
-    auto pos = std::find_if(bgn, end, fnd);
-    return (pos == end) ? FFAtom() : *pos;
+    uint32_t pos = m_data->atom_ids.Find(id);
+    return (pos == no_position) ? FFAtom() : m_data->atoms[pos];
   }
 
   size_t Forcefield::NumAtomTypes() const { return m_data->atoms.size(); }
 
   FFBond Forcefield::GetBondType(BondType type, int32_t id) const {
     _sanity_check_(*this);
-    if (!m_data->Contains(type)) { return FFBond(); }
-    auto bgn = m_data->bonds.at(type).begin();
-    auto end = m_data->bonds.at(type).end();
-    auto fnd = [&id](auto &Z) { return Z.GetID() == id; };
-    auto pos = std::find_if(bgn, end, fnd);
-    return (pos == end) ? FFBond() : *pos;
+    return Impl::Find(m_data->bonds, m_data->bond_ids, type, id);
   }
   FFBond Forcefield::GetBondType(int32_t id) const {
     _sanity_check_(*this);
@@ -781,12 +1370,7 @@ namespace indigox {
   }
   FFAngle Forcefield::GetAngleType(AngleType type, int32_t id) const {
     _sanity_check_(*this);
-    if (!m_data->Contains(type)) { return FFAngle(); }
-    auto bgn = m_data->angles.at(type).begin();
-    auto end = m_data->angles.at(type).end();
-    auto fnd = [&id](auto &Z) { return Z.GetID() == id; };
-    auto pos = std::find_if(bgn, end, fnd);
-    return (pos == end) ? FFAngle() : *pos;
+    return Impl::Find(m_data->angles, m_data->angle_ids, type, id);
   }
 
   FFAngle Forcefield::GetAngleType(int id) const {
@@ -811,12 +1395,7 @@ namespace indigox {
 
   FFDihedral Forcefield::GetDihedralType(DihedralType type, int32_t id) const {
     _sanity_check_(*this);
-    if (!m_data->Contains(type)) { return FFDihedral(); }
-    auto bgn = m_data->dihedrals.at(type).begin();
-    auto end = m_data->dihedrals.at(type).end();
-    auto fnd = [&id](auto &Z) { return Z.GetID() == id; };
-    auto pos = std::find_if(bgn, end, fnd);
-    return (pos == end) ? FFDihedral() : *pos;
+    return Impl::Find(m_data->dihedrals, m_data->dihedral_ids, type, id);
   }
 
   FFDihedral Forcefield::GetDihedralType(int32_t id) const {
@@ -854,10 +1433,10 @@ namespace indigox {
   bool Forcefield::operator==(const Forcefield &ff) const {
     _sanity_check_(*this);
     _sanity_check_(ff);
+    if (m_data == ff.m_data) return true;
     if (GetFamily() != ff.GetFamily()) return false;
     if (GetName() != ff.GetName()) return false;
-    /// \todo Add more indepth comparision
-    return true;
+    return GetHash() == ff.GetHash();
   }
 
   std::ostream &operator<<(std::ostream &os, const Forcefield &ff) {
@@ -868,7 +1447,7 @@ namespace indigox {
   // ===========================================================================
   // == Hardcoded forcefield generations =======================================
   // ===========================================================================
-  Forcefield GenerateGROMOS54A7() {
+  static Forcefield BuildGROMOS54A7() {
     Forcefield ff(FFFamily::GROMOS, "54A7");
     // Add atom types
     PeriodicTable PT = GetPeriodicTable();
@@ -1021,4 +1600,14 @@ namespace indigox {
 
     return ff;
   }
+
+  Forcefield GenerateGROMOS54A7() {
+    // Built once and shared, then archived only as a reference
+    static const Forcefield shared = [] {
+      Forcefield ff = BuildGROMOS54A7().Share();
+      ff.m_data->builtin = true;
+      return ff;
+    }();
+    return shared;
+  }
 } // namespace indigox
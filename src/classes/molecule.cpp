@@ -19,6 +19,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <numeric>
 #include <boost/algorithm/string.hpp>
 #include <iomanip>
@@ -51,9 +52,16 @@ namespace indigox {
             INDIGOX_SERIAL_NVP("dihedrals", dihedrals),
             INDIGOX_SERIAL_NVP("forcefield", forcefield),
             INDIGOX_SERIAL_NVP("graph", molecular_graph),
-            INDIGOX_SERIAL_NVP("formula", cached_formula),
-            INDIGOX_SERIAL_NVP("calculated", calculated_data),
+            INDIGOX_SERIAL_NVP("formula", cached_formula));
+    auto calculated = UpToDateData();
+    archive(INDIGOX_SERIAL_NVP("calculated", calculated),
             INDIGOX_SERIAL_NVP("coordinates", coordinates));
+    if (INDIGOX_IS_INPUT_ARCHIVE(Archive)) {
+      ResetCalculatedData();
+      calculated_data = calculated;
+      ResetCalculatedData(Data::CondensedGraph);
+      RebuildIndices();
+    }
   }
 
   template <typename Archive>
@@ -101,44 +109,132 @@ namespace indigox {
   // == STATE CHECKING =====================================================
   // =======================================================================
 
-  int64_t Molecule::Impl::FindBond(const Atom &a, const Atom &b) const {
-    //    _sanity_check_(*this);
-    int64_t pos = 0;
-    for (const Bond &bnd : a.GetBonds()) {
-      if (bnd.GetAtoms()[0] == b || bnd.GetAtoms()[1] == b) break;
-      ++pos;
-    }
-    return pos == a.NumBonds() ? -1 : pos;
+  TermTable<Bond, 2>::Key Molecule::Impl::BondKey(const Atom &a,
+                                                  const Atom &b) {
+    int64_t x = a.GetID(), y = b.GetID();
+    return x < y ? TermTable<Bond, 2>::Key{x, y}
+                 : TermTable<Bond, 2>::Key{y, x};
   }
 
-  int64_t Molecule::Impl::FindAngle(const Atom &a, const Atom &b,
-                                    const Atom &c) const {
-    //    _sanity_check_(*this);
-    int64_t pos = 0;
-    for (const Angle &ang : b.GetAngles()) {
-      if ((ang.GetAtoms()[0] == a && ang.GetAtoms()[2] == c) ||
-          (ang.GetAtoms()[2] == a && ang.GetAtoms()[1] == c)) {
-        break;
-      }
-      ++pos;
+  TermTable<Angle, 3>::Key
+  Molecule::Impl::AngleKey(const Atom &a, const Atom &b, const Atom &c) {
+    int64_t x = a.GetID(), y = b.GetID(), z = c.GetID();
+    return x < z ? TermTable<Angle, 3>::Key{x, y, z}
+                 : TermTable<Angle, 3>::Key{z, y, x};
+  }
+
+  TermTable<Dihedral, 4>::Key
+  Molecule::Impl::DihedralKey(const Atom &a, const Atom &b, const Atom &c,
+                              const Atom &d) {
+    TermTable<Dihedral, 4>::Key fwd{a.GetID(), b.GetID(), c.GetID(),
+                                    d.GetID()};
+    TermTable<Dihedral, 4>::Key rev{fwd[3], fwd[2], fwd[1], fwd[0]};
+    return rev < fwd ? rev : fwd;
+  }
+
+  Bond Molecule::Impl::FindBond(const Atom &a, const Atom &b) const {
+    return bond_table.Find(BondKey(a, b));
+  }
+
+  Angle Molecule::Impl::FindAngle(const Atom &a, const Atom &b,
+                                  const Atom &c) const {
+    return angle_table.Find(AngleKey(a, b, c));
+  }
+
+  Dihedral Molecule::Impl::FindDihedral(const Atom &a, const Atom &b,
+                                        const Atom &c, const Atom &d) const {
+    return dihedral_table.Find(DihedralKey(a, b, c, d));
+  }
+
+  void Molecule::Impl::IndexTerm(const Bond &bnd) {
+    bond_index.Add(bnd);
+    bond_table.Insert(BondKey(bnd.GetAtoms()[0], bnd.GetAtoms()[1]), bnd);
+  }
+
+  void Molecule::Impl::IndexTerm(const Angle &ang) {
+    const Angle::AngleAtoms &atms = ang.GetAtoms();
+    angle_index.Add(ang);
+    angle_table.Insert(AngleKey(atms[0], atms[1], atms[2]), ang);
+  }
+
+  void Molecule::Impl::IndexTerm(const Dihedral &dhd) {
+    const Dihedral::DihedralAtoms &atms = dhd.GetAtoms();
+    dihedral_index.Add(dhd);
+    dihedral_table.Insert(DihedralKey(atms[0], atms[1], atms[2], atms[3]),
+                          dhd);
+  }
+
+  void Molecule::Impl::UnindexTerm(const Bond &bnd) {
+    bond_index.Remove(bnd);
+    bond_table.Erase(BondKey(bnd.GetAtoms()[0], bnd.GetAtoms()[1]));
+  }
+
+  void Molecule::Impl::UnindexTerm(const Angle &ang) {
+    const Angle::AngleAtoms &atms = ang.GetAtoms();
+    angle_index.Remove(ang);
+    angle_table.Erase(AngleKey(atms[0], atms[1], atms[2]));
+  }
+
+  void Molecule::Impl::UnindexTerm(const Dihedral &dhd) {
+    const Dihedral::DihedralAtoms &atms = dhd.GetAtoms();
+    dihedral_index.Remove(dhd);
+    dihedral_table.Erase(DihedralKey(atms[0], atms[1], atms[2], atms[3]));
+  }
+
+  void Molecule::Impl::RebuildIndices() {
+    atom_index.Rebuild(atoms);
+    bond_index.Rebuild(bonds);
+    angle_index.Rebuild(angles);
+    dihedral_index.Rebuild(dihedrals);
+
+    bond_table.Clear();
+    bond_table.Reserve(bonds.size());
+    for (const Bond &bnd : bonds)
+      bond_table.Insert(BondKey(bnd.GetAtoms()[0], bnd.GetAtoms()[1]), bnd);
+    angle_table.Clear();
+    angle_table.Reserve(angles.size());
+    for (const Angle &ang : angles) {
+      const Angle::AngleAtoms &atms = ang.GetAtoms();
+      angle_table.Insert(AngleKey(atms[0], atms[1], atms[2]), ang);
     }
-    return pos == b.NumAngles() ? -1 : pos;
-  }
-
-  int64_t Molecule::Impl::FindDihedral(const Atom &a, const Atom &b,
-                                       const Atom &c, const Atom &d) const {
-    //    _sanity_check_(*this);
-    int64_t pos = 0;
-    for (const Dihedral &dhd : a.GetDihedrals()) {
-      if ((dhd.GetAtoms()[0] == a && dhd.GetAtoms()[1] == b &&
-           dhd.GetAtoms()[2] == c && dhd.GetAtoms()[3] == d) ||
-          (dhd.GetAtoms()[3] == a && dhd.GetAtoms()[2] == b &&
-           dhd.GetAtoms()[1] == c && dhd.GetAtoms()[0] == d)) {
-        break;
-      }
-      ++pos;
+    dihedral_table.Clear();
+    dihedral_table.Reserve(dihedrals.size());
+    for (const Dihedral &dhd : dihedrals) {
+      const Dihedral::DihedralAtoms &atms = dhd.GetAtoms();
+      dihedral_table.Insert(DihedralKey(atms[0], atms[1], atms[2], atms[3]),
+                            dhd);
     }
-    return pos == a.NumDihedrals() ? -1 : pos;
+  }
+
+  void Molecule::Impl::BondingChanged(const std::vector<Atom> &changed) {
+    // Beyond this many changed atoms, recalculating in full is cheaper
+    size_t limit = atoms.size() / 4 + 16;
+    auto record = [&](Data dat, std::vector<Atom> &pending) {
+      if (!Test(dat)) return false;
+      pending.insert(pending.end(), changed.begin(), changed.end());
+      if (pending.size() <= limit) return true;
+      pending.clear();
+      return false;
+    };
+    bool angles = record(Data::AnglePerception, angle_changes);
+    bool dihedrals = record(Data::DihedralPerception, dihedral_changes);
+    bool condensed = record(Data::CondensedGraph, condensed_changes);
+    calculated_data.reset();
+    if (angles) Set(Data::AnglePerception);
+    if (dihedrals) Set(Data::DihedralPerception);
+    if (condensed) Set(Data::CondensedGraph);
+  }
+
+  std::bitset<static_cast<uint8_t>(CalculatedData::Number)>
+  Molecule::Impl::UpToDateData() const {
+    auto data = calculated_data;
+    if (!angle_changes.empty())
+      data.reset(static_cast<uint8_t>(Data::AnglePerception));
+    if (!dihedral_changes.empty())
+      data.reset(static_cast<uint8_t>(Data::DihedralPerception));
+    // The condensed graph is not serialised
+    data.reset(static_cast<uint8_t>(Data::CondensedGraph));
+    return data;
   }
 
   bool Molecule::HasAtom(const Atom &atom) const {
@@ -153,7 +249,7 @@ namespace indigox {
 
   bool Molecule::HasBond(const Atom &a, const Atom &b) const {
     _sanity_check_(*this);
-    return (HasAtom(a) && HasAtom(b)) ? (m_data->FindBond(a, b) != -1) : false;
+    return (HasAtom(a) && HasAtom(b)) ? bool(m_data->FindBond(a, b)) : false;
   }
 
   bool Molecule::HasAngle(const Angle &angle) const {
@@ -165,7 +261,7 @@ namespace indigox {
     _sanity_check_(*this);
     PerceiveAngles();
     return (HasAtom(a) && HasAtom(b) && HasAtom(c))
-               ? (m_data->FindAngle(a, b, c) != -1)
+               ? bool(m_data->FindAngle(a, b, c))
                : false;
   }
 
@@ -179,7 +275,7 @@ namespace indigox {
     _sanity_check_(*this);
     PerceiveDihedrals();
     return (HasAtom(a) && HasAtom(b) && HasAtom(c) && HasAtom(d))
-               ? (m_data->FindDihedral(a, b, c, d) != -1)
+               ? bool(m_data->FindDihedral(a, b, c, d))
                : false;
   }
 
@@ -217,7 +313,10 @@ namespace indigox {
 
   void Molecule::ReserveBonds(int64_t num) {
     _sanity_check_(*this);
-    if (num > 0) { m_data->bonds.reserve(num); }
+    if (num > 0) {
+      m_data->bonds.reserve(num);
+      m_data->bond_table.Reserve(num);
+    }
   }
 
   // =======================================================================
@@ -231,18 +330,12 @@ namespace indigox {
 
   Atom Molecule::GetAtomID(int64_t id) const {
     _sanity_check_(*this);
-    for (const Atom &atm : m_data->atoms) {
-      if (atm.GetID() == id) { return atm; }
-    }
-    return Atom();
+    return m_data->atom_index.FindID(id);
   }
 
   Atom Molecule::GetAtomTag(int64_t tag) const {
     _sanity_check_(*this);
-    for (const Atom &atm : m_data->atoms) {
-      if (atm.GetTag() == tag) { return atm; }
-    }
-    return Atom();
+    return m_data->atom_index.FindTag(tag, m_data->atoms);
   }
 
   Bond Molecule::GetBond(uint32_t pos) const {
@@ -252,24 +345,17 @@ namespace indigox {
 
   Bond Molecule::GetBond(const Atom &a, const Atom &b) const {
     _sanity_check_(*this);
-    int64_t pos = m_data->FindBond(a, b);
-    return (HasAtom(a) && pos != -1) ? a.GetBonds()[pos] : Bond();
+    return (HasAtom(a) && HasAtom(b)) ? m_data->FindBond(a, b) : Bond();
   }
 
   Bond Molecule::GetBondID(int64_t id) const {
     _sanity_check_(*this);
-    for (const Bond &bnd : m_data->bonds) {
-      if (bnd.GetID() == id) { return bnd; }
-    }
-    return Bond();
+    return m_data->bond_index.FindID(id);
   }
 
   Bond Molecule::GetBondTag(int64_t tag) const {
     _sanity_check_(*this);
-    for (const Bond &bnd : m_data->bonds) {
-      if (bnd.GetTag() == tag) { return bnd; }
-    }
-    return Bond();
+    return m_data->bond_index.FindTag(tag, m_data->bonds);
   }
 
   Angle Molecule::GetAngle(uint32_t pos) {
@@ -281,24 +367,19 @@ namespace indigox {
   Angle Molecule::GetAngle(const Atom &a, const Atom &b, const Atom &c) {
     _sanity_check_(*this);
     PerceiveAngles();
-    int64_t pos = m_data->FindAngle(a, b, c);
-    return (HasAtom(b) && pos != -1) ? b.GetAngles()[pos] : Angle();
+    return (HasAtom(a) && HasAtom(b) && HasAtom(c))
+               ? m_data->FindAngle(a, b, c)
+               : Angle();
   }
 
   Angle Molecule::GetAngleID(int64_t id) const {
     _sanity_check_(*this);
-    for (const Angle &ang : m_data->angles) {
-      if (ang.GetID() == id) { return ang; }
-    }
-    return Angle();
+    return m_data->angle_index.FindID(id);
   }
 
   Angle Molecule::GetAngleTag(int64_t tag) const {
     _sanity_check_(*this);
-    for (const Angle &ang : m_data->angles) {
-      if (ang.GetTag() == tag) { return ang; }
-    }
-    return Angle();
+    return m_data->angle_index.FindTag(tag, m_data->angles);
   }
 
   Dihedral Molecule::GetDihedral(uint32_t pos) {
@@ -311,24 +392,19 @@ namespace indigox {
                                  const Atom &d) {
     _sanity_check_(*this);
     PerceiveDihedrals();
-    int64_t pos = m_data->FindDihedral(a, b, c, d);
-    return (HasAtom(a) && pos != -1) ? a.GetDihedrals()[pos] : Dihedral();
+    return (HasAtom(a) && HasAtom(b) && HasAtom(c) && HasAtom(d))
+               ? m_data->FindDihedral(a, b, c, d)
+               : Dihedral();
   }
 
   Dihedral Molecule::GetDihedralID(int64_t id) const {
     _sanity_check_(*this);
-    for (const Dihedral &ang : m_data->dihedrals) {
-      if (ang.GetID() == id) { return ang; }
-    }
-    return Dihedral();
+    return m_data->dihedral_index.FindID(id);
   }
 
   Dihedral Molecule::GetDihedralTag(int64_t tag) const {
     _sanity_check_(*this);
-    for (const Dihedral &ang : m_data->dihedrals) {
-      if (ang.GetTag() == tag) { return ang; }
-    }
-    return Dihedral();
+    return m_data->dihedral_index.FindTag(tag, m_data->dihedrals);
   }
 
   Residue Molecule::GetResidueID(int32_t id) { return GetResidues()[id]; }
@@ -363,10 +439,17 @@ namespace indigox {
 
   const graph::CondensedMolecularGraph &Molecule::GetCondensedGraph() const {
     _sanity_check_(*this);
-    if (!m_data->Test(Data::CondensedGraph)) {
+    if (!m_data->Test(Data::CondensedGraph) ||
+        !m_data->condensed_molecular_graph) {
       m_data->condensed_molecular_graph =
           graph::Condense(m_data->molecular_graph);
       m_data->Set(Data::CondensedGraph);
+      m_data->condensed_changes.clear();
+    } else if (!m_data->condensed_changes.empty()) {
+      m_data->condensed_molecular_graph = graph::Recondense(
+          m_data->molecular_graph, m_data->condensed_molecular_graph,
+          m_data->condensed_changes);
+      m_data->condensed_changes.clear();
     }
     return m_data->condensed_molecular_graph;
   }
@@ -430,7 +513,25 @@ namespace indigox {
       all_atoms.erase(atm);
     }
     swap_order.insert(swap_order.end(), all_atoms.begin(), all_atoms.end());
+    if (swap_order.size() != m_data->atoms.size()) {
+      throw std::runtime_error("New atom order contains duplicate atoms");
+    }
+
+    // Permute coordinates so positions stay dense and match the atom order
+    size_t n = swap_order.size();
+    std::vector<double> x(n), y(n), z(n);
+    for (size_t i = 0; i < n; ++i) {
+      Coordinates pos = m_data->coordinates[swap_order[i].m_data->position];
+      x[i] = pos.x;
+      y[i] = pos.y;
+      z[i] = pos.z;
+    }
+    for (size_t i = 0; i < n; ++i) {
+      m_data->coordinates.SetCoordinates(i, x[i], y[i], z[i]);
+      swap_order[i].m_data->position = i;
+    }
     m_data->atoms = swap_order;
+    m_data->atom_index.InvalidateTags();
   }
 
   /// \todo Make unique on per residue basis
@@ -497,12 +598,13 @@ namespace indigox {
 
   Atom Molecule::NewAtom(const Element &element, double x, double y, double z) {
     _sanity_check_(*this);
-    m_data->ResetCalculatedData();
     Atom atom = Atom(*this, element, "");
     atom.m_data->unique_id = m_data->next_unique_id++;
     atom.m_data->position = m_data->coordinates.Append(x, y, z);
     m_data->atoms.emplace_back(atom);
+    m_data->atom_index.Add(atom);
     m_data->molecular_graph.AddVertex(atom);
+    m_data->BondingChanged({atom});
     return atom;
   }
 
@@ -511,23 +613,112 @@ namespace indigox {
     Bond bnd;
 
     if (HasAtom(a) && HasAtom(b)) {
-      int64_t pos = m_data->FindBond(a, b);
-      if (pos != -1) {
-        bnd = a.GetBonds()[pos];
-      } else {
-        m_data->ResetCalculatedData();
+      bnd = m_data->FindBond(a, b);
+      if (!bnd) {
         bnd = Bond(a, b, *this, BondOrder::SINGLE);
         bnd.m_data->unique_id = m_data->next_unique_id++;
         bnd.m_data->atoms[0].AddBond(bnd);
         bnd.m_data->atoms[1].AddBond(bnd);
         m_data->molecular_graph.AddEdge(bnd);
         m_data->bonds.emplace_back(bnd);
+        m_data->IndexTerm(bnd);
+        m_data->BondingChanged({a, b});
       }
     }
 
     return bnd;
   }
 
+  Molecule::MoleculeAtoms Molecule::NewAtoms(size_t count,
+                                             const int32_t *atomic_numbers,
+                                             const double *coordinates) {
+    _sanity_check_(*this);
+    MoleculeAtoms atoms;
+    if (!count) return atoms;
+    size_t total = m_data->atoms.size() + count;
+    atoms.reserve(count);
+    m_data->atoms.reserve(total);
+    m_data->coordinates.Reserve(total);
+    m_data->atom_index.ids.reserve(total);
+
+    const PeriodicTable &pt = GetPeriodicTable();
+    for (size_t i = 0; i < count; ++i) {
+      Atom atom = Atom(*this, pt.GetElement(atomic_numbers[i]), "");
+      atom.m_data->unique_id = m_data->next_unique_id++;
+      atom.m_data->position =
+          coordinates ? m_data->coordinates.Append(coordinates[3 * i],
+                                                   coordinates[3 * i + 1],
+                                                   coordinates[3 * i + 2])
+                      : m_data->coordinates.Append(0.0, 0.0, 0.0);
+      m_data->atoms.emplace_back(atom);
+      m_data->atom_index.Add(atom);
+      m_data->molecular_graph.AddVertex(atom);
+      atoms.emplace_back(atom);
+    }
+    m_data->BondingChanged(atoms);
+    return atoms;
+  }
+
+  Molecule::MoleculeAtoms
+  Molecule::NewAtoms(const std::vector<int32_t> &atomic_numbers,
+                     const std::vector<double> &coordinates) {
+    if (!coordinates.empty() &&
+        coordinates.size() != 3 * atomic_numbers.size()) {
+      throw std::runtime_error("Coordinates must have three values per atom");
+    }
+    return NewAtoms(atomic_numbers.size(), atomic_numbers.data(),
+                    coordinates.empty() ? nullptr : coordinates.data());
+  }
+
+  Molecule::MoleculeBonds Molecule::NewBonds(size_t count,
+                                             const uint32_t *index_pairs) {
+    _sanity_check_(*this);
+    MoleculeBonds bonds;
+    if (!count) return bonds;
+    for (size_t i = 0; i < 2 * count; ++i) {
+      if (index_pairs[i] >= m_data->atoms.size())
+        throw std::runtime_error("Bond atom index out of range");
+    }
+    size_t total = m_data->bonds.size() + count;
+    std::vector<Atom> changed;
+    bonds.reserve(count);
+    m_data->bonds.reserve(total);
+    m_data->bond_table.Reserve(total);
+    m_data->bond_index.ids.reserve(total);
+
+    for (size_t i = 0; i < count; ++i) {
+      const Atom &a = m_data->atoms[index_pairs[2 * i]];
+      const Atom &b = m_data->atoms[index_pairs[2 * i + 1]];
+      if (a == b) {
+        bonds.emplace_back();
+        continue;
+      }
+      Bond bnd = m_data->FindBond(a, b);
+      if (!bnd) {
+        bnd = Bond(a, b, *this, BondOrder::SINGLE);
+        bnd.m_data->unique_id = m_data->next_unique_id++;
+        bnd.m_data->atoms[0].AddBond(bnd);
+        bnd.m_data->atoms[1].AddBond(bnd);
+        m_data->molecular_graph.AddEdge(bnd);
+        m_data->bonds.emplace_back(bnd);
+        m_data->IndexTerm(bnd);
+        changed.emplace_back(a);
+        changed.emplace_back(b);
+      }
+      bonds.emplace_back(bnd);
+    }
+    if (!changed.empty()) m_data->BondingChanged(changed);
+    return bonds;
+  }
+
+  Molecule::MoleculeBonds
+  Molecule::NewBonds(const std::vector<uint32_t> &index_pairs) {
+    if (index_pairs.size() % 2) {
+      throw std::runtime_error("Bond indices must be given in pairs");
+    }
+    return NewBonds(index_pairs.size() / 2, index_pairs.data());
+  }
+
   Angle Molecule::NewAngle(const Atom &a, const Atom &b, const Atom &c) {
     // No need for logic checks as no ability for user to add angles
     _sanity_check_(*this);
@@ -537,6 +728,7 @@ namespace indigox {
     ang.m_data->atoms[1].AddAngle(ang);
     ang.m_data->atoms[2].AddAngle(ang);
     m_data->angles.emplace_back(ang);
+    m_data->IndexTerm(ang);
     return ang;
   }
 
@@ -554,10 +746,8 @@ namespace indigox {
       }
     }
 
-    int64_t pos = m_data->FindDihedral(a, b, c, d);
-    if (pos != -1) {
-      dhd = a.GetDihedrals()[pos];
-    } else {
+    dhd = m_data->FindDihedral(a, b, c, d);
+    if (!dhd) {
       dhd = Dihedral(a, b, c, d, *this);
       dhd.m_data->unique_id = m_data->next_unique_id++;
       dhd.m_data->atoms[0].AddDihedral(dhd);
@@ -565,6 +755,7 @@ namespace indigox {
       dhd.m_data->atoms[2].AddDihedral(dhd);
       dhd.m_data->atoms[3].AddDihedral(dhd);
       m_data->dihedrals.emplace_back(dhd);
+      m_data->IndexTerm(dhd);
     }
     return dhd;
   }
@@ -577,7 +768,13 @@ namespace indigox {
   bool Molecule::RemoveAtom(const Atom &atom) {
     _sanity_check_(*this);
     if (!HasAtom(atom)) return false;
-    m_data->ResetCalculatedData();
+    // The atom itself is recorded so its condensed vertex is removed
+    std::vector<Atom> changed(1, atom);
+    for (const Bond &bnd : atom.m_data->bonds) {
+      const Bond::BondAtoms &atms = bnd.GetAtoms();
+      changed.emplace_back(atms[0] == atom ? atms[1] : atms[0]);
+    }
+    m_data->BondingChanged(changed);
     // Remove all bonds this atom is part of from molecule
     auto bnd_pred = [&atom](Bond bnd) { // Predicate checks if atom in bnd
       return !(bnd.m_data->atoms[0] == atom || bnd.m_data->atoms[1] == atom);
@@ -590,6 +787,7 @@ namespace indigox {
       Bond bnd = *bnd_pos;
       bnd.m_data->atoms[0].RemoveBond(bnd);
       bnd.m_data->atoms[1].RemoveBond(bnd);
+      m_data->UnindexTerm(bnd);
       bnd.Reset();
     }
     m_data->bonds.erase(bnd_pos_erase, m_data->bonds.end());
@@ -607,6 +805,7 @@ namespace indigox {
       ang.m_data->atoms[0].RemoveAngle(ang);
       ang.m_data->atoms[1].RemoveAngle(ang);
       ang.m_data->atoms[2].RemoveAngle(ang);
+      m_data->UnindexTerm(ang);
       ang.Reset();
     }
     m_data->angles.erase(ang_pos_erase, m_data->angles.end());
@@ -625,6 +824,7 @@ namespace indigox {
       dhd.m_data->atoms[1].RemoveDihedral(dhd);
       dhd.m_data->atoms[2].RemoveDihedral(dhd);
       dhd.m_data->atoms[3].RemoveDihedral(dhd);
+      m_data->UnindexTerm(dhd);
       dhd.Reset();
     }
     m_data->dihedrals.erase(dhd_pos_erase, m_data->dihedrals.end());
@@ -644,6 +844,7 @@ namespace indigox {
     m_data->coordinates.Erase(remove_idx);
     m_data->atoms.pop_back();
 
+    m_data->atom_index.Remove(atm);
     atm.Reset();
     return true;
   }
@@ -653,21 +854,20 @@ namespace indigox {
   bool Molecule::RemoveBond(const Bond &bond) {
     _sanity_check_(*this);
     if (!HasBond(bond)) return false;
-    m_data->ResetCalculatedData();
     Atom a = bond.GetAtoms()[0];
     Atom b = bond.GetAtoms()[1];
+    m_data->BondingChanged({a, b});
     // Remove the bond from each atom
     a.RemoveBond(bond);
     b.RemoveBond(bond);
 
     // Remove all angles this bond is part of from molecule
+    auto is_bond = [&a, &b](const Atom &x, const Atom &y) {
+      return (x == a && y == b) || (x == b && y == a);
+    };
     auto ang_pred = [&](Angle ang) {
-      int64_t b1_pos =
-          m_data->FindBond(ang.m_data->atoms[1], ang.m_data->atoms[0]);
-      int64_t b2_pos =
-          m_data->FindBond(ang.m_data->atoms[1], ang.m_data->atoms[2]);
-      return (ang.GetAtoms()[1].GetBonds()[b1_pos] != bond &&
-              ang.GetAtoms()[1].GetBonds()[b2_pos] != bond);
+      const Angle::AngleAtoms &atms = ang.m_data->atoms;
+      return !(is_bond(atms[0], atms[1]) || is_bond(atms[1], atms[2]));
     };
     auto ang_pos =
         std::partition(m_data->angles.begin(), m_data->angles.end(), ang_pred);
@@ -677,19 +877,16 @@ namespace indigox {
       ang.m_data->atoms[0].RemoveAngle(ang);
       ang.m_data->atoms[1].RemoveAngle(ang);
       ang.m_data->atoms[2].RemoveAngle(ang);
+      m_data->UnindexTerm(ang);
       ang.Reset();
     }
     m_data->angles.erase(ang_pos_erase, m_data->angles.end());
 
     // Remove all dihedrals this bond is part of from molecule
     auto dhd_pred = [&](Dihedral dhd) {
-      int64_t b1_pos = m_data->FindBond(dhd.GetAtoms()[0], dhd.GetAtoms()[1]);
-      int64_t b2_pos = m_data->FindBond(dhd.GetAtoms()[1], dhd.GetAtoms()[2]);
-      int64_t b3_pos = m_data->FindBond(dhd.GetAtoms()[2], dhd.GetAtoms()[3]);
-      if (b1_pos == -1 || b2_pos == -1 || b3_pos == -1) { return true; }
-      Atom a = dhd.GetAtoms()[0];
-      return (a.GetBonds()[b1_pos] != bond && a.GetBonds()[b2_pos] != bond &&
-              a.GetBonds()[b3_pos] != bond);
+      const Dihedral::DihedralAtoms &atms = dhd.m_data->atoms;
+      return !(is_bond(atms[0], atms[1]) || is_bond(atms[1], atms[2]) ||
+               is_bond(atms[2], atms[3]));
     };
     auto dhd_pos = std::partition(m_data->dihedrals.begin(),
                                   m_data->dihedrals.end(), dhd_pred);
@@ -700,6 +897,7 @@ namespace indigox {
       dhd.m_data->atoms[1].RemoveDihedral(dhd);
       dhd.m_data->atoms[2].RemoveDihedral(dhd);
       dhd.m_data->atoms[3].RemoveDihedral(dhd);
+      m_data->UnindexTerm(dhd);
       dhd.Reset();
     }
     m_data->dihedrals.erase(dhd_pos_erase, m_data->dihedrals.end());
@@ -710,6 +908,7 @@ namespace indigox {
     m_data->molecular_graph.RemoveEdge(e);
     m_data->bonds.erase(
         std::find(m_data->bonds.begin(), m_data->bonds.end(), bond));
+    m_data->UnindexTerm(bnd);
     bnd.Reset();
     return true;
   }
@@ -725,8 +924,21 @@ namespace indigox {
 
   int64_t Molecule::PerceiveAngles() {
     _sanity_check_(*this);
-    if (m_data->Test(Data::AnglePerception)) { return 0; }
+    if (m_data->Test(Data::AnglePerception)) {
+      // Only atoms whose bonds have changed can be the centre of new angles
+      if (m_data->angle_changes.empty()) return 0;
+      std::vector<Atom> changed;
+      changed.swap(m_data->angle_changes);
+      std::sort(changed.begin(), changed.end());
+      changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+      int64_t count = 0;
+      for (const Atom &at : changed) {
+        if (HasAtom(at)) count += PerceiveAngles(at);
+      }
+      return count;
+    }
     m_data->Set(Data::AnglePerception);
+    m_data->angle_changes.clear();
 
     // Expected number of angles
     auto sum = [&](size_t current, Atom v) -> size_t {
@@ -737,36 +949,57 @@ namespace indigox {
     size_t count =
         std::accumulate(m_data->atoms.begin(), m_data->atoms.end(), 0, sum);
     m_data->angles.reserve(count);
+    m_data->angle_table.Reserve(count);
     count = 0;
 
-    std::vector<Atom> nbrs;
-    nbrs.reserve(10);
     // Adding new angles
-    for (Atom at : m_data->atoms) {
-      if (at.NumBonds() < 2) { continue; }
-      for (Bond bn : at.m_data->bonds) {
-        if (bn.GetAtoms()[0] == at) {
-          nbrs.emplace_back(bn.GetAtoms()[1]);
-        } else {
-          nbrs.emplace_back(bn.GetAtoms()[0]);
-        }
+    for (const Atom &at : m_data->atoms) count += PerceiveAngles(at);
+    return count;
+  }
+
+  int64_t Molecule::PerceiveAngles(const Atom &at) {
+    if (at.NumBonds() < 2) { return 0; }
+    std::vector<Atom> nbrs;
+    nbrs.reserve(at.NumBonds());
+    for (Bond bn : at.m_data->bonds) {
+      if (bn.GetAtoms()[0] == at) {
+        nbrs.emplace_back(bn.GetAtoms()[1]);
+      } else {
+        nbrs.emplace_back(bn.GetAtoms()[0]);
       }
+    }
 
-      for (size_t i = 0; i < nbrs.size() - 1; ++i) {
-        for (size_t j = i + 1; j < nbrs.size(); ++j) {
-          if (m_data->FindAngle(nbrs[i], at, nbrs[j]) != -1) { continue; }
-          NewAngle(nbrs[i], at, nbrs[j]);
-          ++count;
-        }
+    int64_t count = 0;
+    for (size_t i = 0; i < nbrs.size() - 1; ++i) {
+      for (size_t j = i + 1; j < nbrs.size(); ++j) {
+        if (m_data->FindAngle(nbrs[i], at, nbrs[j])) { continue; }
+        NewAngle(nbrs[i], at, nbrs[j]);
+        ++count;
       }
-      nbrs.clear();
     }
     return count;
   }
 
   int64_t Molecule::PerceiveDihedrals() {
-    if (m_data->Test(Data::DihedralPerception)) { return 0; }
+    if (m_data->Test(Data::DihedralPerception)) {
+      // New dihedrals, and changed priorities, can only be about the bonds of
+      // atoms whose bonds have changed
+      if (m_data->dihedral_changes.empty()) return 0;
+      std::vector<Bond> changed;
+      for (const Atom &at : m_data->dihedral_changes) {
+        if (!HasAtom(at)) continue;
+        changed.insert(changed.end(), at.m_data->bonds.begin(),
+                       at.m_data->bonds.end());
+      }
+      m_data->dihedral_changes.clear();
+      std::sort(changed.begin(), changed.end());
+      changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+      int64_t count = 0;
+      for (const Bond &bn : changed) count += PerceiveDihedrals(bn);
+      return count;
+    }
     m_data->Set(Data::DihedralPerception);
+    m_data->dihedral_changes.clear();
 
     // Expected number of dihedrals
     auto sum = [&](size_t current, Bond b) -> size_t {
@@ -779,77 +1012,75 @@ namespace indigox {
     size_t count =
         std::accumulate(m_data->bonds.begin(), m_data->bonds.end(), 0, sum);
     m_data->dihedrals.reserve(count);
+    m_data->dihedral_table.Reserve(count);
     count = 0;
 
+    for (const Bond &bn : m_data->bonds) count += PerceiveDihedrals(bn);
+    return count;
+  }
+
+  int64_t Molecule::PerceiveDihedrals(const Bond &central) {
+    Atom B = central.GetAtoms()[0];
+    Atom C = central.GetAtoms()[1];
+    if (B.NumBonds() < 2 || C.NumBonds() < 2) { return 0; }
+
     // Adding new dihedrals
     std::vector<Atom> B_nbrs, C_nbrs;
-    B_nbrs.reserve(10);
-    C_nbrs.reserve(10);
-    for (Bond bn : m_data->bonds) {
-      Atom B = bn.GetAtoms()[0];
-      Atom C = bn.GetAtoms()[1];
-      if (B.NumBonds() < 2 || C.NumBonds() < 2) { continue; }
-
-      for (Bond bn : B.GetBonds()) {
-        if (bn.GetAtoms()[0] == B) {
-          B_nbrs.emplace_back(bn.GetAtoms()[1]);
-        } else {
-          B_nbrs.emplace_back(bn.GetAtoms()[0]);
-        }
+    B_nbrs.reserve(B.NumBonds());
+    C_nbrs.reserve(C.NumBonds());
+    for (Bond bn : B.GetBonds()) {
+      if (bn.GetAtoms()[0] == B) {
+        B_nbrs.emplace_back(bn.GetAtoms()[1]);
+      } else {
+        B_nbrs.emplace_back(bn.GetAtoms()[0]);
       }
-      for (Bond bn : C.GetBonds()) {
-        if (bn.GetAtoms()[0] == C) {
-          C_nbrs.emplace_back(bn.GetAtoms()[1]);
-        } else {
-          C_nbrs.emplace_back(bn.GetAtoms()[0]);
-        }
+    }
+    for (Bond bn : C.GetBonds()) {
+      if (bn.GetAtoms()[0] == C) {
+        C_nbrs.emplace_back(bn.GetAtoms()[1]);
+      } else {
+        C_nbrs.emplace_back(bn.GetAtoms()[0]);
       }
+    }
 
-      for (size_t i = 0; i < B_nbrs.size(); ++i) {
-        if (B_nbrs[i] == C) { continue; }
-        for (size_t j = 0; j < C_nbrs.size(); ++j) {
-          if (C_nbrs[j] == B) { continue; }
-          if (m_data->FindDihedral(B_nbrs[i], B, C, C_nbrs[j]) != -1) continue;
-          NewDihedral(B_nbrs[i], B, C, C_nbrs[j], false);
-          ++count;
-        }
+    int64_t count = 0;
+    for (size_t i = 0; i < B_nbrs.size(); ++i) {
+      if (B_nbrs[i] == C) { continue; }
+      for (size_t j = 0; j < C_nbrs.size(); ++j) {
+        if (C_nbrs[j] == B) { continue; }
+        if (m_data->FindDihedral(B_nbrs[i], B, C, C_nbrs[j])) continue;
+        NewDihedral(B_nbrs[i], B, C, C_nbrs[j], false);
+        ++count;
       }
-      B_nbrs.clear();
-      C_nbrs.clear();
     }
 
     // Determining priorities
-    for (Bond bn : m_data->bonds) {
-      Atom B = bn.GetAtoms()[0];
-      Atom C = bn.GetAtoms()[1];
-      if (B.NumBonds() < 2 || C.NumBonds() < 2) { continue; }
-      std::vector<Dihedral> bnd_dhds;
-      for (Dihedral dhd : B.GetDihedrals()) {
-        Atom b = dhd.GetAtoms()[1];
-        Atom c = dhd.GetAtoms()[2];
-        if ((b == B && c == C) || (b == C && c == B)) {
-          bnd_dhds.emplace_back(dhd);
-        }
+    std::vector<Dihedral> bnd_dhds;
+    for (Dihedral dhd : B.GetDihedrals()) {
+      Atom b = dhd.GetAtoms()[1];
+      Atom c = dhd.GetAtoms()[2];
+      if ((b == B && c == C) || (b == C && c == B)) {
+        bnd_dhds.emplace_back(dhd);
       }
-      std::sort(bnd_dhds.begin(), bnd_dhds.end(), [](Dihedral a, Dihedral b) {
-        Atom a1 = a.GetAtoms()[0];
-        Atom a4 = a.GetAtoms()[3];
-        Atom b1 = b.GetAtoms()[0];
-        Atom b4 = b.GetAtoms()[3];
-        int32_t w_a = Square(a1.GetElement().GetAtomicNumber()) +
-                      Square(a4.GetElement().GetAtomicNumber());
-        int32_t w_b = Square(b1.GetElement().GetAtomicNumber()) +
-                      Square(b4.GetElement().GetAtomicNumber());
-        return w_a < w_b;
-      });
-      for (uint32_t i = 0; i < bnd_dhds.size(); ++i) {
-        // Only worry about the H's for now.
-        if (bnd_dhds[i].GetAtoms()[0].GetElement() != "H" &&
-            bnd_dhds[i].GetAtoms()[3].GetElement() != "H") {
-          continue;
-        }
-        bnd_dhds[i].m_data->priority = i;
+    }
+    std::sort(bnd_dhds.begin(), bnd_dhds.end(), [](Dihedral a, Dihedral b) {
+      Atom a1 = a.GetAtoms()[0];
+      Atom a4 = a.GetAtoms()[3];
+      Atom b1 = b.GetAtoms()[0];
+      Atom b4 = b.GetAtoms()[3];
+      int32_t w_a = Square(a1.GetElement().GetAtomicNumber()) +
+                    Square(a4.GetElement().GetAtomicNumber());
+      int32_t w_b = Square(b1.GetElement().GetAtomicNumber()) +
+                    Square(b4.GetElement().GetAtomicNumber());
+      return w_a < w_b;
+    });
+    for (uint32_t i = 0; i < bnd_dhds.size(); ++i) {
+      // Only worry about the H's for now.
+      if (bnd_dhds[i].GetAtoms()[0].GetElement() != "H" &&
+          bnd_dhds[i].GetAtoms()[3].GetElement() != "H") {
+        continue;
       }
+      bnd_dhds[i].m_data->priority = i;
     }
     return count;
   }
@@ -863,6 +1094,10 @@ namespace indigox {
 
     using namespace indigo_bondorder;
 
+    // indigo-bondorder holds its settings in globals, so only one molecule
+    // can be processed by it at a time.
+    static std::mutex bondorder_mutex;
+    std::unique_lock<std::mutex> bondorder_lock(bondorder_mutex);
     setElectronSettings(algorithmOption);
 
     // Build the indigo-bondorder molecule
@@ -914,6 +1149,7 @@ namespace indigox {
     }
 
     BO_mol->ApplyElectronAssignment(structure);
+    bondorder_lock.unlock();
 
     int longest_name = 5;
     for (auto it = BO_mol->BeginAtom(); it != BO_mol->EndAtom(); ++it) {
@@ -1320,6 +1556,19 @@ namespace indigox {
 
   void Molecule::ModificationMade() { m_data->ResetCalculatedData(); }
 
+  void Molecule::ModificationMade(const Atom &atom) {
+    _sanity_check_(*this);
+    if (!HasAtom(atom)) return;
+    // Neighbours are included as the priorities of dihedrals about their
+    // bonds depend on the atom
+    std::vector<Atom> changed(1, atom);
+    for (const Bond &bnd : atom.GetBonds()) {
+      const Bond::BondAtoms &atms = bnd.GetAtoms();
+      changed.emplace_back(atms[0] == atom ? atms[1] : atms[0]);
+    }
+    m_data->BondingChanged(changed);
+  }
+
   // =======================================================================
   // == STATE SETTING ======================================================
   // =======================================================================
@@ -1364,19 +1613,27 @@ namespace indigox {
   // =======================================================================
 
   void SaveMolecule(const Molecule &mol, std::string path) {
-    using Archive = cereal::PortableBinaryOutputArchive;
     std::ofstream os(path);
     if (!os.is_open()) throw std::runtime_error("Unable to open output stream");
+    std::cout << "Saving molecule in binary format to location " << path << std::endl;
+    SaveMolecule(mol, os);
+  }
+
+  void SaveMolecule(const Molecule &mol, std::ostream &os) {
+    using Archive = cereal::PortableBinaryOutputArchive;
     Archive archive(os);
     std::string stype("Molecule");
-    std::cout << "Saving molecule in binary format to location " << path << std::endl;
     archive(stype, mol);
   }
 
   Molecule LoadMolecule(std::string path) {
-    using Archive = cereal::PortableBinaryInputArchive;
     std::ifstream is(path);
     if (!is.is_open()) throw std::runtime_error("Unable to open input stream");
+    return LoadMolecule(is);
+  }
+
+  Molecule LoadMolecule(std::istream &is) {
+    using Archive = cereal::PortableBinaryInputArchive;
     std::string stype;
     Archive archive(is);
     archive(stype);
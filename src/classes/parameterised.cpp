@@ -5,9 +5,29 @@
 #include <indigox/classes/forcefield.hpp>
 #include <indigox/classes/molecule.hpp>
 #include <indigox/classes/parameterised.hpp>
+#include <indigox/utils/serialise.hpp>
+#include <indigox/utils/simd.hpp>
 
 namespace indigox {
 
+  namespace {
+    // eastl::vector_map has no cereal support, so counts are archived as a
+    // vector of pairs.
+    template <class Archive, class Counts>
+    void SerialiseTypeCounts(Archive &archive, Counts &types) {
+      std::vector<std::pair<typename Counts::key_type, size_t>> counts;
+      if (INDIGOX_IS_OUTPUT_ARCHIVE(Archive)) {
+        counts.reserve(types.size());
+        for (auto &type : types) counts.emplace_back(type.first, type.second);
+      }
+      archive(INDIGOX_SERIAL_NVP("types", counts));
+      if (INDIGOX_IS_INPUT_ARCHIVE(Archive)) {
+        types.clear();
+        for (auto &count : counts) types.emplace(count.first, count.second);
+      }
+    }
+  } // namespace
+
   // ===========================================================================
   // == ParamAtom Data Implementation ==========================================
   // ===========================================================================
@@ -19,9 +39,24 @@ namespace indigox {
     bool applied;
     double added_charge = 0.;
 
+    ParamAtomImpl() : applied(false) {}
     ParamAtomImpl(const Atom &atm) : atom(atm), applied(false) {}
+
+    template <class Archive> void serialise(Archive &archive, const uint32_t) {
+      archive(INDIGOX_SERIAL_NVP("atom", atom));
+      SerialiseTypeCounts(archive, types);
+      archive(INDIGOX_SERIAL_NVP("charges", charges),
+              INDIGOX_SERIAL_NVP("applied", applied),
+              INDIGOX_SERIAL_NVP("added_charge", added_charge));
+    }
   };
 
+  template <typename Archive>
+  void ParamAtom::serialise(Archive &archive, const uint32_t) {
+    archive(INDIGOX_SERIAL_NVP("data", m_data));
+  }
+  INDIGOX_SERIALISE(ParamAtom);
+
   // ===========================================================================
   // == ParamAtom Construction/Assignment ======================================
   // ===========================================================================
@@ -46,8 +81,8 @@ namespace indigox {
     m_data->charges.push_back(mapped.GetPartialCharge());
   }
 
-  int64_t ParamMolecule::charge_rounding = 0;
-  bool ParamAtom::ApplyParameterisation(bool self_consistent) {
+  bool ParamAtom::ApplyParameterisation(bool self_consistent,
+                                        int64_t charge_rounding) {
     if (m_data->applied) return false;
     if (m_data->charges.empty()) return false;
     if (self_consistent) {
@@ -62,9 +97,8 @@ namespace indigox {
     m_data->atom.SetType(GetMostCommonType());
     if (!self_consistent) {
       double charge = MeanCharge();
-      if (ParamMolecule::charge_rounding > 0) {
-        charge = round(charge * ParamMolecule::charge_rounding) / ParamMolecule::charge_rounding;
-      }
+      if (charge_rounding > 0)
+        charge = round(charge * charge_rounding) / charge_rounding;
       m_data->atom.SetPartialCharge(charge);
     }
     else
@@ -86,14 +120,16 @@ namespace indigox {
   int64_t ParamAtom::NumSourceAtoms() const { return m_data->charges.size(); }
   const Atom &ParamAtom::GetAtom() const { return m_data->atom; }
   double ParamAtom::MeanCharge() const {
-    return CalculateMean(m_data->charges.begin(), m_data->charges.end());
+    const MappedCharge &q = m_data->charges;
+    return simd::Sum(q.data(), q.size()) / q.size();
   }
   double ParamAtom::MeadianCharge() {
     return CalculateMedian(m_data->charges.begin(), m_data->charges.end());
   }
   double ParamAtom::StandardDeviationCharge() const {
-    return CalculateStandardDeviation(m_data->charges.begin(),
-                                      m_data->charges.end());
+    const MappedCharge &q = m_data->charges;
+    double sum_sq = simd::SumSquaredDeviations(q.data(), q.size(), MeanCharge());
+    return std::sqrt(sum_sq / q.size());
   }
   double ParamAtom::RedistributedChargeAdded() const {
     return m_data->added_charge;
@@ -139,10 +175,24 @@ namespace indigox {
     TypeCounts types;
     bool applied;
 
+    ParamBondImpl() : applied(false) {}
     ParamBondImpl(BondAtoms atms, const Bond &bnd)
         : atoms(atms), bond(bnd), applied(false) {}
+
+    template <class Archive> void serialise(Archive &archive, const uint32_t) {
+      archive(INDIGOX_SERIAL_NVP("atoms", atoms),
+              INDIGOX_SERIAL_NVP("bond", bond));
+      SerialiseTypeCounts(archive, types);
+      archive(INDIGOX_SERIAL_NVP("applied", applied));
+    }
   };
 
+  template <typename Archive>
+  void ParamBond::serialise(Archive &archive, const uint32_t) {
+    archive(INDIGOX_SERIAL_NVP("data", m_data));
+  }
+  INDIGOX_SERIALISE(ParamBond);
+
   // ===========================================================================
   // == ParamBond Construction/Assignment ======================================
   // ===========================================================================
@@ -239,10 +289,24 @@ namespace indigox {
     TypeCounts types;
     bool applied;
 
+    ParamAngleImpl() : applied(false) {}
     ParamAngleImpl(AngleAtoms atms, const Angle &ang)
         : atoms(atms), angle(ang), applied(false) {}
+
+    template <class Archive> void serialise(Archive &archive, const uint32_t) {
+      archive(INDIGOX_SERIAL_NVP("atoms", atoms),
+              INDIGOX_SERIAL_NVP("angle", angle));
+      SerialiseTypeCounts(archive, types);
+      archive(INDIGOX_SERIAL_NVP("applied", applied));
+    }
   };
 
+  template <typename Archive>
+  void ParamAngle::serialise(Archive &archive, const uint32_t) {
+    archive(INDIGOX_SERIAL_NVP("data", m_data));
+  }
+  INDIGOX_SERIALISE(ParamAngle);
+
   // ===========================================================================
   // == ParamAngle Construction/Assignment =====================================
   // ===========================================================================
@@ -340,10 +404,24 @@ namespace indigox {
     TypeCounts types;
     bool applied;
 
+    ParamDihedralImpl() : applied(false) {}
     ParamDihedralImpl(DihedralAtoms atms, const Dihedral &dhd)
         : atoms(atms), dihedral(dhd), applied(false) {}
+
+    template <class Archive> void serialise(Archive &archive, const uint32_t) {
+      archive(INDIGOX_SERIAL_NVP("atoms", atoms),
+              INDIGOX_SERIAL_NVP("dihedral", dihedral));
+      SerialiseTypeCounts(archive, types);
+      archive(INDIGOX_SERIAL_NVP("applied", applied));
+    }
   };
 
+  template <typename Archive>
+  void ParamDihedral::serialise(Archive &archive, const uint32_t) {
+    archive(INDIGOX_SERIAL_NVP("data", m_data));
+  }
+  INDIGOX_SERIALISE(ParamDihedral);
+
   // ===========================================================================
   // == ParamDihedral Construction/Assignment ==================================
   // ===========================================================================
@@ -444,6 +522,7 @@ namespace indigox {
     ParamAngles angle_indices;
     ParamDihedrals dihedral_indices;
     std::vector<ParamAtom> nonsc_atoms;
+    int64_t charge_rounding = 0;
 
     explicit ParamMoleculeImpl(const Molecule &m) : mol(m) {
       for (const Atom &atm : mol.GetAtoms()) {
@@ -482,8 +561,43 @@ namespace indigox {
                                  dihedral_indices.size());
       }
     }
+
+    ParamMoleculeImpl() = default;
+
+    // Indices are derived from the parameterised parts, so not archived
+    template <class Archive> void serialise(Archive &archive, const uint32_t) {
+      archive(INDIGOX_SERIAL_NVP("mol", mol),
+              INDIGOX_SERIAL_NVP("atoms", atoms),
+              INDIGOX_SERIAL_NVP("bonds", bonds),
+              INDIGOX_SERIAL_NVP("angles", angles),
+              INDIGOX_SERIAL_NVP("dihedrals", dihedrals),
+              INDIGOX_SERIAL_NVP("nonsc_atoms", nonsc_atoms),
+              INDIGOX_SERIAL_NVP("charge_rounding", charge_rounding));
+      if (INDIGOX_IS_INPUT_ARCHIVE(Archive)) RebuildIndices();
+    }
+
+    void RebuildIndices() {
+      atom_indices.clear();
+      bond_indices.clear();
+      angle_indices.clear();
+      dihedral_indices.clear();
+      for (ParamAtom &atm : atoms)
+        atom_indices.emplace(atm.GetAtom(), atom_indices.size());
+      for (ParamBond &bnd : bonds)
+        bond_indices.emplace(bnd.GetAtoms(), bond_indices.size());
+      for (ParamAngle &ang : angles)
+        angle_indices.emplace(ang.GetAtoms(), angle_indices.size());
+      for (ParamDihedral &dhd : dihedrals)
+        dihedral_indices.emplace(dhd.GetAtoms(), dihedral_indices.size());
+    }
   };
 
+  template <typename Archive>
+  void ParamMolecule::serialise(Archive &archive, const uint32_t) {
+    archive(INDIGOX_SERIAL_NVP("data", m_data));
+  }
+  INDIGOX_SERIALISE(ParamMolecule);
+
   // ===========================================================================
   // == ParamMolecule Construction/Assignment ==================================
   // ===========================================================================
@@ -497,7 +611,7 @@ namespace indigox {
 
   void ParamMolecule::ApplyParameteristion(bool sc) {
     for (ParamAtom atm : m_data->atoms) {
-      bool param = atm.ApplyParameterisation(sc);
+      bool param = atm.ApplyParameterisation(sc, m_data->charge_rounding);
       if (!sc && param) m_data->nonsc_atoms.emplace_back(atm);
     }
     for (ParamBond bnd : m_data->bonds) bnd.ApplyParameterisation(sc);
@@ -505,10 +619,18 @@ namespace indigox {
     for (ParamDihedral dhd : m_data->dihedrals) dhd.ApplyParameterisation(sc);
   }
 
+  void ParamMolecule::SetChargeRounding(int64_t rounding) {
+    m_data->charge_rounding = rounding;
+  }
+
   // ===========================================================================
   // == ParamMolecule Data Retrieval ===========================================
   // ===========================================================================
 
+  int64_t ParamMolecule::GetChargeRounding() const {
+    return m_data->charge_rounding;
+  }
+
   const ParamAtom &ParamMolecule::GetAtom(const Atom &atm) const {
     return m_data->atoms[m_data->atom_indices.find(atm)->second];
   }
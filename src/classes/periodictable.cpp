@@ -32,8 +32,8 @@ namespace indigox {
           vanderwaals(vdw), chi(eln), covalent(cov) {}
 
     static std::shared_ptr<ElementImpl> GetNullState() {
-      static std::shared_ptr<ElementImpl> state;
-      if (!state) state = std::make_shared<ElementImpl>();
+      static const std::shared_ptr<ElementImpl> state =
+          std::make_shared<ElementImpl>();
       return state;
     }
   };
@@ -304,11 +304,12 @@ namespace indigox {
 
   const PeriodicTable &GetPeriodicTable() {
     using pPeriodicTable = std::unique_ptr<PeriodicTable>;
-    static pPeriodicTable instance = pPeriodicTable();
-    if (!instance) {
-      instance.reset(new PeriodicTable());
-      instance->GeneratePeriodicTable();
-    }
+    // Generated in the initialiser so first use is safe from any thread
+    static const pPeriodicTable instance = [] {
+      pPeriodicTable table(new PeriodicTable());
+      table->GeneratePeriodicTable();
+      return table;
+    }();
     return *instance;
   }
 
@@ -15,6 +15,41 @@ namespace indigox::graph {
       GetPeriodicTable().GetElement("Cl"), GetPeriodicTable().GetElement("Br"),
       GetPeriodicTable().GetElement("I")};
 
+  // Largest cycle considered small for the isomorphism masks
+  const uint32_t __small_cycle = 8;
+
+  // If a path of fewer than __small_cycle edges joins a and b without using the
+  // edge between them, so that the edge is part of a small cycle. Only the
+  // neighbourhood of the edge is searched, rather than finding all cycles.
+  bool __on_small_cycle(MolecularGraph &MG, const MGVertex &a,
+                        const MGVertex &b) {
+    eastl::vector_set<MGVertex> seen;
+    seen.insert(a);
+    std::vector<MGVertex> frontier(1, a), next;
+    for (uint32_t length = 1; length < __small_cycle; ++length) {
+      for (const MGVertex &u : frontier) {
+        for (const MGVertex &w : MG.GetNeighbours(u)) {
+          if (u == a && w == b) continue;
+          if (w == b) return true;
+          if (seen.insert(w).second) next.push_back(w);
+        }
+      }
+      if (next.empty()) return false;
+      frontier.swap(next);
+      next.clear();
+    }
+    return false;
+  }
+
+  bool __on_small_cycle(MolecularGraph &MG, const MGVertex &v) {
+    // Copied as the search refills the neighbours of v
+    MolecularGraph::VertContain nbrs = MG.GetNeighbours(v);
+    for (const MGVertex &u : nbrs) {
+      if (__on_small_cycle(MG, v, u)) return true;
+    }
+    return false;
+  }
+
   struct CMGVertex::CMGVertexData {
     MGVertex source;
     CondensedMolecularGraph graph;
@@ -145,7 +180,7 @@ namespace indigox::graph {
 
     mask = atm_num | fc_mag | h | f | cl | br | i | degree | imp_h;
     if (atm.GetFormalCharge() < 0) mask.set(10);
-    if (MG.IsCyclic(v, 8)) mask.set(26);
+    if (__on_small_cycle(MG, v)) mask.set(26);
     if (atm.GetStereochemistry() == AtomStereo::R) mask.set(28);
     if (atm.GetStereochemistry() == AtomStereo::S) mask.set(29);
 
@@ -234,7 +269,8 @@ namespace indigox::graph {
     mask |= degree_small | degree_large;
     if (bnd.GetStereochemistry() == BondStereo::E) mask.set(3);
     if (bnd.GetStereochemistry() == BondStereo::Z) mask.set(4);
-    if (G.IsCyclic(e, 8)) mask.set(5);
+    if (__on_small_cycle(G, G.GetSourceVertex(e), G.GetTargetVertex(e)))
+      mask.set(5);
     //    if (e->IsCyclic(8)) _iso_mask.set(6);
     //    if (bnd.GetAromaticity())
     //      mask.set(7);
@@ -295,6 +331,30 @@ namespace indigox::graph {
     return v_locl;
   }
 
+  CMGEdge CondensedMolecularGraph::AddEdge(const MGEdge &e,
+                                           const CMGEdge &previous) {
+    MolecularGraph MG = e.GetGraph();
+    CMGVertex u = GetVertex(MG.GetSourceVertex(e));
+    CMGVertex v = GetVertex(MG.GetTargetVertex(e));
+    CMGEdge e_local;
+    e_local.m_data = std::make_shared<CMGEdge::CMGEdgeData>(e, *this);
+    e_local.m_data->mask = previous.m_data->mask;
+    m_data->condensed_edges.emplace(e, e_local);
+    graph_type::AddEdge(u, v, e_local);
+    return e_local;
+  }
+
+  CMGVertex CondensedMolecularGraph::AddVertex(const MGVertex &v,
+                                               const CMGVertex &previous) {
+    CMGVertex v_locl;
+    v_locl.m_data = std::make_shared<CMGVertex::CMGVertexData>(v, *this);
+    v_locl.m_data->condensed = previous.m_data->condensed;
+    v_locl.m_data->mask = previous.m_data->mask;
+    m_data->condensed_vertices.emplace(v, v_locl);
+    graph_type::AddVertex(v_locl);
+    return v_locl;
+  }
+
   // =======================================================================
   // == CondensedMolecularGraph CONSTRUCTION ===============================
   // =======================================================================
@@ -302,44 +362,85 @@ namespace indigox::graph {
   CondensedMolecularGraph::CondensedMolecularGraph(const MolecularGraph &g)
       : m_data(std::make_shared<Impl>(g)) {}
 
+  // If a vertex is contracted into its neighbour rather than having its own
+  // vertex in the condensed graph
+  bool __is_condensed(MolecularGraph &MG, const MGVertex &v) {
+    // Non-leaf vertices are never condensed
+    if (MG.Degree(v) > 1) return false;
+    const Atom &atm = v.GetAtom();
+    const Element &e = atm.GetElement();
+    // Leaf vertices not in __con_elem are not condensed
+    if (__con_elem.find(e) == __con_elem.end()) return false;
+    // Leaf vertices with formal charge are not condensed
+    if (atm.GetFormalCharge() != 0) return false;
+    // Leaf vertices with a non-single bond are not condensed
+    MGVertex u = MG.GetNeighbours(v).front();
+    BondOrder order = MG.GetEdge(v, u).GetBond().GetOrder();
+    if (order != BondOrder::SINGLE) return false;
+    // Leaf vertices whose parent is also a leaf are not condensed
+    return MG.Degree(u) != 1;
+  }
+
   CondensedMolecularGraph Condense(const MolecularGraph &MG) {
     using CMG = CondensedMolecularGraph;
     MolecularGraph mg = MG;
     CMG CG(MG);
 
     for (const MGVertex &v : MG.GetVertices()) {
-      // Add vertex for all non-leaf vertices
-      if (MG.Degree(v) > 1) {
-        CG.AddVertex(v);
-        continue;
-      }
-      const Atom& atm = v.GetAtom();
-      const Element& e = atm.GetElement();
-      // Add vertex if leaf vertex is not in __con_elem
-      if (__con_elem.find(e) == __con_elem.end()) {
-        CG.AddVertex(v);
-        continue;
-      }
-      // Add vertex if has formal charge
-      if (atm.GetFormalCharge() != 0) {
-        CG.AddVertex(v);
-        continue;
+      if (!__is_condensed(mg, v)) CG.AddVertex(v);
+    }
+
+    for (const MGEdge &e : MG.GetEdges()) {
+      MGVertex u, v;
+      std::tie(u, v) = MG.GetVertices(e);
+      if (CG.HasVertex(u) && CG.HasVertex(v)) CG.AddEdge(e);
+    }
+    return CG;
+  }
+
+  CondensedMolecularGraph Recondense(const MolecularGraph &MG,
+                                     const CondensedMolecularGraph &previous,
+                                     const std::vector<Atom> &changed) {
+    using CMG = CondensedMolecularGraph;
+    MolecularGraph mg = MG;
+    CMG CG(MG);
+
+    // Vertices near enough to a change that their condensing or masks may
+    // differ. Any small cycle gained or lost passes within half its length.
+    eastl::vector_set<MGVertex> region;
+    std::vector<MGVertex> frontier, next;
+    for (const Atom &atm : changed) {
+      if (!mg.HasVertex(atm)) continue;
+      const MGVertex &v = mg.GetVertex(atm);
+      if (region.insert(v).second) frontier.push_back(v);
+    }
+    for (uint32_t depth = 0; depth < __small_cycle / 2; ++depth) {
+      for (const MGVertex &u : frontier) {
+        for (const MGVertex &w : mg.GetNeighbours(u)) {
+          if (region.insert(w).second) next.push_back(w);
+        }
       }
-      // Add vertex if bond is not single
-      MGVertex u = mg.GetNeighbours(v).front();
-      BondOrder order = MG.GetEdge(v, u).GetBond().GetOrder();
-      if (order != BondOrder::SINGLE) {
+      frontier.swap(next);
+      next.clear();
+    }
+
+    for (const MGVertex &v : MG.GetVertices()) {
+      if (__is_condensed(mg, v)) continue;
+      if (region.find(v) != region.end() || !previous.HasVertex(v))
         CG.AddVertex(v);
-        continue;
-      }
-      // Add vertex if parent is also a leaf
-      if (MG.Degree(u) == 1) CG.AddVertex(v);
+      else
+        CG.AddVertex(v, previous.GetVertex(v));
     }
 
     for (const MGEdge &e : MG.GetEdges()) {
       MGVertex u, v;
       std::tie(u, v) = MG.GetVertices(e);
-      if (CG.HasVertex(u) && CG.HasVertex(v)) CG.AddEdge(e);
+      if (!CG.HasVertex(u) || !CG.HasVertex(v)) continue;
+      if (region.find(u) != region.end() || region.find(v) != region.end() ||
+          !previous.HasEdge(e))
+        CG.AddEdge(e);
+      else
+        CG.AddEdge(e, previous.GetEdge(e));
     }
     return CG;
   }
@@ -0,0 +1,83 @@
+#include <indigox/classes/athenaeum.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/io/athenaeum_builder.hpp>
+#include <indigox/io/readers.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace indigox::io {
+
+  namespace {
+    struct Source {
+      Molecule mol;
+      std::vector<Fragment> fragments;
+    };
+
+    // Read every nth file, starting from the first
+    void ReadSources(const std::vector<std::string> &paths,
+                     std::vector<Source> &sources, const Forcefield &ff,
+                     size_t first, size_t stride) {
+      for (size_t i = first; i < paths.size(); i += stride) {
+        try {
+          sources[i].mol = ReadFragmentFile(paths[i], ff, sources[i].fragments);
+        } catch (const std::exception &e) {
+          throw std::runtime_error(paths[i] + ": " + e.what());
+        }
+      }
+    }
+  } // namespace
+
+  size_t BuildAthenaeums(const std::string &directory, Athenaeum &manual,
+                         Athenaeum &automatic, uint32_t num_threads) {
+    if (!manual && !automatic) return 0;
+    Forcefield ff = manual ? manual.GetForcefield() : automatic.GetForcefield();
+    if (manual && automatic && automatic.GetForcefield() != ff)
+      throw std::runtime_error("Athenaeums have different forcefields");
+
+    namespace fs = std::filesystem;
+    std::vector<std::string> paths;
+    for (const fs::directory_entry &entry : fs::directory_iterator(directory)) {
+      if (entry.is_regular_file() && entry.path().extension() == ".frag")
+        paths.emplace_back(entry.path().string());
+    }
+    std::sort(paths.begin(), paths.end());
+
+    if (!num_threads)
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+    if (num_threads > paths.size()) num_threads = uint32_t(paths.size());
+    std::vector<Source> sources(paths.size());
+    if (num_threads <= 1) {
+      ReadSources(paths, sources, ff, 0, 1);
+    } else {
+      std::vector<std::future<void>> workers;
+      workers.reserve(num_threads);
+      for (uint32_t t = 0; t < num_threads; ++t)
+        workers.emplace_back(std::async(std::launch::async, ReadSources,
+                                        std::cref(paths), std::ref(sources),
+                                        std::cref(ff), t, num_threads));
+      // Wait for every worker before reporting the first error
+      for (std::future<void> &worker : workers) worker.wait();
+      for (std::future<void> &worker : workers) worker.get();
+    }
+
+    if (manual) {
+      for (Source &source : sources) {
+        for (Fragment &frag : source.fragments) manual.AddFragment(frag);
+      }
+    }
+    if (automatic) {
+      std::vector<Molecule> mols;
+      mols.reserve(sources.size());
+      for (Source &source : sources) mols.emplace_back(source.mol);
+      automatic.AddAllFragments(mols, num_threads);
+    }
+    return sources.size();
+  }
+
+} // namespace indigox::io
@@ -0,0 +1,400 @@
+#include <indigox/classes/athenaeum.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/graph/condensed.hpp>
+#include <indigox/io/athenaeum_snapshot.hpp>
+#include <indigox/utils/mapped_file.hpp>
+#include <indigox/utils/serialise.hpp>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifndef INDIGOX_DISABLE_SANITY_CHECKS
+#define _sanity_check_(x)                                                      \
+  if (!x)                                                                      \
+  throw std::runtime_error(                                                    \
+      "Attempting to access data from invalid snapshot instance")
+#else
+#define _sanity_check_(x)
+#endif
+
+namespace indigox::io {
+
+  namespace {
+    using AthSettings = Athenaeum::Settings;
+    const size_t num_bools = size_t(AthSettings::BoolCount);
+    const size_t num_ints =
+        size_t(AthSettings::IntCount) - size_t(AthSettings::BoolCount) - 1;
+
+    struct FileHeader {
+      char magic[8];
+      uint32_t version;
+      uint32_t byte_order;
+      uint64_t num_molecules;
+      uint64_t num_fragments;
+      uint64_t bool_settings;
+      int32_t int_settings[8];
+      // Serialised forcefield of the Athenaeum
+      uint64_t forcefield_offset;
+      uint64_t forcefield_size;
+      char padding[40];
+    };
+    static_assert(sizeof(FileHeader) == 128, "Snapshot header must be 128 B");
+    static_assert(num_ints <= 8, "Too many Athenaeum settings for snapshot");
+
+    // Molecules are followed by the table of all fragments, then the pools of
+    // vertex labels and superset words the fragments point into, then the
+    // serialised molecules. Offsets are from the start of the file.
+    struct MoleculeRecord {
+      uint64_t blob_offset;
+      uint64_t blob_size;
+      uint64_t first_fragment;
+      uint64_t num_fragments;
+    };
+    static_assert(sizeof(MoleculeRecord) == 32, "Unexpected molecule record");
+
+    struct FragmentRecord {
+      uint32_t size;
+      uint32_t num_vertices;
+      uint32_t num_edges;
+      uint32_t padding;
+      uint64_t labels_offset;
+      uint64_t supersets_offset;
+    };
+    static_assert(sizeof(FragmentRecord) == 32, "Unexpected fragment record");
+
+    const char file_magic[8] = {'I', 'X', 'A', 'T', 'H', 'S', 'N', 'P'};
+    const uint32_t file_version = 1;
+    const uint32_t byte_order_mark = 0x01020304;
+
+    size_t Padded(size_t n) { return (n + 7) & ~size_t(7); }
+    size_t SupersetWords(size_t num_fragments) {
+      return (num_fragments + 63) / 64;
+    }
+
+    // Reads serialised data in place
+    struct MemoryBuffer : std::streambuf {
+      MemoryBuffer(const char *data, size_t size) {
+        char *start = const_cast<char *>(data);
+        setg(start, start, start + size);
+      }
+    };
+
+    [[noreturn]] void Corrupt(const std::string &path) {
+      throw std::runtime_error("Corrupt Athenaeum snapshot: " + path);
+    }
+  } // namespace
+
+  // ===========================================================================
+  // == AthenaeumSnapshot implementation =======================================
+  // ===========================================================================
+
+  struct AthenaeumSnapshot::Impl {
+    utils::MappedFile file;
+    FileHeader header;
+    const MoleculeRecord *molecules;
+    const FragmentRecord *fragments;
+    Forcefield forcefield;
+
+    // Molecules loaded so far, each loaded once
+    std::unique_ptr<std::once_flag[]> once;
+    std::vector<Athenaeum::FragContain> loaded;
+    std::atomic<size_t> num_loaded;
+
+    explicit Impl(const std::string &path) : file(path), num_loaded(0) {
+      const std::string &p = file.GetPath();
+      if (file.GetSize() < sizeof(FileHeader))
+        throw std::runtime_error("Not an Athenaeum snapshot: " + p);
+      std::memcpy(&header, file.GetData(), sizeof(FileHeader));
+      if (std::memcmp(header.magic, file_magic, sizeof(file_magic)))
+        throw std::runtime_error("Not an Athenaeum snapshot: " + p);
+      if (header.version != file_version)
+        throw std::runtime_error("Unsupported Athenaeum snapshot version: " +
+                                 p);
+      if (header.byte_order != byte_order_mark)
+        throw std::runtime_error("Athenaeum snapshot has wrong byte order: " +
+                                 p);
+
+      // Every record must point within the file before any is used
+      uint64_t size = file.GetSize();
+      uint64_t n_mol = header.num_molecules, n_frag = header.num_fragments;
+      if (n_mol > size / sizeof(MoleculeRecord) ||
+          n_frag > size / sizeof(FragmentRecord) ||
+          sizeof(FileHeader) + n_mol * sizeof(MoleculeRecord) +
+                  n_frag * sizeof(FragmentRecord) >
+              size)
+        Corrupt(p);
+      molecules = reinterpret_cast<const MoleculeRecord *>(file.GetData() +
+                                                           sizeof(FileHeader));
+      fragments = reinterpret_cast<const FragmentRecord *>(molecules + n_mol);
+      auto in_file = [size](uint64_t offset, uint64_t bytes) {
+        return offset <= size && bytes <= size - offset;
+      };
+      auto aligned_in_file = [&in_file](uint64_t offset, uint64_t count) {
+        return offset % 8 == 0 && count <= UINT64_MAX / 8 &&
+               in_file(offset, count * 8);
+      };
+      uint64_t next_fragment = 0;
+      for (uint64_t m = 0; m < n_mol; ++m) {
+        const MoleculeRecord &mol = molecules[m];
+        if (mol.first_fragment != next_fragment ||
+            mol.num_fragments > n_frag - next_fragment ||
+            !in_file(mol.blob_offset, mol.blob_size))
+          Corrupt(p);
+        next_fragment += mol.num_fragments;
+        uint64_t words = SupersetWords(mol.num_fragments);
+        for (uint64_t f = mol.first_fragment; f < next_fragment; ++f) {
+          if (!aligned_in_file(fragments[f].labels_offset,
+                               fragments[f].num_vertices) ||
+              !aligned_in_file(fragments[f].supersets_offset, words))
+            Corrupt(p);
+        }
+      }
+      if (next_fragment != n_frag ||
+          !in_file(header.forcefield_offset, header.forcefield_size))
+        Corrupt(p);
+
+      // Loading the forcefield registers it, so the molecules loaded later
+      // resolve to it
+      MemoryBuffer buffer(file.GetData() + header.forcefield_offset,
+                          header.forcefield_size);
+      std::istream is(&buffer);
+      cereal::PortableBinaryInputArchive archive(is);
+      archive(forcefield);
+
+      once.reset(new std::once_flag[n_mol]);
+      loaded.resize(n_mol);
+    }
+
+    void Load(size_t mol) {
+      const MoleculeRecord &record = molecules[mol];
+      MemoryBuffer buffer(file.GetData() + record.blob_offset,
+                          record.blob_size);
+      std::istream is(&buffer);
+      cereal::PortableBinaryInputArchive archive(is);
+      Molecule source;
+      Athenaeum::FragContain frags;
+      archive(source, frags);
+      if (frags.size() != record.num_fragments) Corrupt(file.GetPath());
+      // Angles and dihedrals of source molecules are looked up while
+      // parameterising, so perceive them now to keep that read only
+      source.PerceiveAngles();
+      source.PerceiveDihedrals();
+      loaded[mol] = std::move(frags);
+      ++num_loaded;
+    }
+  };
+
+  // ===========================================================================
+  // == AthenaeumSnapshot construction =========================================
+  // ===========================================================================
+
+  AthenaeumSnapshot::AthenaeumSnapshot(const std::string &path)
+      : m_data(std::make_shared<Impl>(path)) {}
+
+  // ===========================================================================
+  // == AthenaeumSnapshot data getting =========================================
+  // ===========================================================================
+
+  size_t AthenaeumSnapshot::NumMolecules() const {
+    _sanity_check_(*this);
+    return m_data->header.num_molecules;
+  }
+
+  size_t AthenaeumSnapshot::NumFragments() const {
+    _sanity_check_(*this);
+    return m_data->header.num_fragments;
+  }
+
+  size_t AthenaeumSnapshot::NumFragments(size_t mol) const {
+    _sanity_check_(*this);
+    if (mol >= m_data->header.num_molecules)
+      throw std::out_of_range("Snapshot molecule out of range");
+    return m_data->molecules[mol].num_fragments;
+  }
+
+  AthenaeumSnapshot::FragmentView
+  AthenaeumSnapshot::GetFragmentView(size_t mol, size_t pos) const {
+    if (pos >= NumFragments(mol))
+      throw std::out_of_range("Snapshot fragment out of range");
+    const Impl &dat = *m_data;
+    const FragmentRecord &frag =
+        dat.fragments[dat.molecules[mol].first_fragment + pos];
+    const char *data = dat.file.GetData();
+    FragmentView view;
+    view.size = frag.size;
+    view.num_vertices = frag.num_vertices;
+    view.num_edges = frag.num_edges;
+    view.labels = reinterpret_cast<const uint64_t *>(data + frag.labels_offset);
+    view.supersets =
+        reinterpret_cast<const uint64_t *>(data + frag.supersets_offset);
+    return view;
+  }
+
+  const Athenaeum::FragContain &
+  AthenaeumSnapshot::GetFragments(size_t mol) const {
+    NumFragments(mol);
+    Impl &dat = *m_data;
+    std::call_once(dat.once[mol], [&dat, mol]() { dat.Load(mol); });
+    return dat.loaded[mol];
+  }
+
+  size_t AthenaeumSnapshot::NumLoaded() const {
+    _sanity_check_(*this);
+    return m_data->num_loaded;
+  }
+
+  const Forcefield &AthenaeumSnapshot::GetForcefield() const {
+    _sanity_check_(*this);
+    return m_data->forcefield;
+  }
+
+  bool AthenaeumSnapshot::GetBool(AthSettings param) const {
+    _sanity_check_(*this);
+    if (param >= AthSettings::BoolCount)
+      throw std::runtime_error("Not a boolean parameter");
+    return (m_data->header.bool_settings >> uint8_t(param)) & 1;
+  }
+
+  int32_t AthenaeumSnapshot::GetInt(AthSettings param) const {
+    _sanity_check_(*this);
+    uint8_t offset = 1 + (uint8_t)AthSettings::BoolCount;
+    if (param <= AthSettings::BoolCount || param >= AthSettings::IntCount)
+      throw std::runtime_error("Not an integer parameter");
+    return m_data->header.int_settings[(uint8_t)param - offset];
+  }
+
+  const std::string &AthenaeumSnapshot::GetPath() const {
+    _sanity_check_(*this);
+    return m_data->file.GetPath();
+  }
+
+  // ===========================================================================
+  // == Snapshot files =========================================================
+  // ===========================================================================
+
+  void SaveAthenaeumSnapshot(const Athenaeum &ath, const std::string &path) {
+    Athenaeum src = ath;
+    const Athenaeum::MoleculeFragments &mols = src.GetFragments();
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(FileHeader));
+    std::memcpy(header.magic, file_magic, sizeof(file_magic));
+    header.version = file_version;
+    header.byte_order = byte_order_mark;
+    header.num_molecules = mols.size();
+    header.num_fragments = src.NumFragments();
+    for (size_t i = 0; i < num_bools; ++i) {
+      if (src.GetBool(AthSettings(i))) header.bool_settings |= uint64_t(1) << i;
+    }
+    for (size_t i = 0; i < num_ints; ++i)
+      header.int_settings[i] = src.GetInt(AthSettings(num_bools + 1 + i));
+
+    // Pool offsets are relative to the pools until their start is known
+    std::vector<MoleculeRecord> mol_records;
+    std::vector<FragmentRecord> frag_records;
+    std::vector<uint64_t> labels, supersets;
+    mol_records.reserve(mols.size());
+    frag_records.reserve(header.num_fragments);
+    for (auto &entry : mols) {
+      const Athenaeum::FragContain &frags = entry.second;
+      MoleculeRecord mol;
+      std::memset(&mol, 0, sizeof(MoleculeRecord));
+      mol.first_fragment = frag_records.size();
+      mol.num_fragments = frags.size();
+      mol_records.push_back(mol);
+      size_t words = SupersetWords(frags.size());
+      for (const Fragment &frag : frags) {
+        const graph::CondensedMolecularGraph &g = frag.GetGraph();
+        FragmentRecord record;
+        std::memset(&record, 0, sizeof(FragmentRecord));
+        record.size = uint32_t(frag.Size());
+        record.num_vertices = uint32_t(g.NumVertices());
+        record.num_edges = uint32_t(g.NumEdges());
+        record.labels_offset = labels.size() * 8;
+        record.supersets_offset = supersets.size() * 8;
+        for (const graph::CMGVertex &v : g.GetVertices())
+          labels.push_back(v.GetIsomorphismMask().to_uint64());
+        size_t first_word = supersets.size();
+        supersets.resize(first_word + words, 0);
+        const boost::dynamic_bitset<> &bits = frag.GetSupersets();
+        for (size_t b = bits.find_first(); b != bits.npos && b < frags.size();
+             b = bits.find_next(b))
+          supersets[first_word + b / 64] |= uint64_t(1) << (b % 64);
+        frag_records.push_back(record);
+      }
+    }
+
+    uint64_t labels_start = sizeof(FileHeader) +
+                            mol_records.size() * sizeof(MoleculeRecord) +
+                            frag_records.size() * sizeof(FragmentRecord);
+    uint64_t supersets_start = labels_start + labels.size() * 8;
+    uint64_t blobs_start = supersets_start + supersets.size() * 8;
+    for (FragmentRecord &record : frag_records) {
+      record.labels_offset += labels_start;
+      record.supersets_offset += supersets_start;
+    }
+
+    // Serialised data is written after space for the tables, which are
+    // written once the offsets of the data are known
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os.is_open())
+      throw std::runtime_error("Unable to save Athenaeum snapshot to path: " +
+                               path);
+    os.write(std::string(blobs_start, '\0').data(), blobs_start);
+    uint64_t offset = blobs_start;
+    auto write_blob = [&os, &offset](auto &&... values) {
+      std::ostringstream blob;
+      {
+        cereal::PortableBinaryOutputArchive archive(blob);
+        archive(values...);
+      }
+      std::string data = blob.str();
+      data.resize(Padded(data.size()), '\0');
+      os.write(data.data(), data.size());
+      uint64_t start = offset;
+      offset += data.size();
+      return std::make_pair(start, uint64_t(data.size()));
+    };
+    std::tie(header.forcefield_offset, header.forcefield_size) =
+        write_blob(src.GetForcefield());
+    size_t m = 0;
+    for (auto &entry : mols) {
+      std::tie(mol_records[m].blob_offset, mol_records[m].blob_size) =
+          write_blob(entry.first, entry.second);
+      ++m;
+    }
+
+    os.seekp(0);
+    os.write(reinterpret_cast<const char *>(&header), sizeof(FileHeader));
+    os.write(reinterpret_cast<const char *>(mol_records.data()),
+             mol_records.size() * sizeof(MoleculeRecord));
+    os.write(reinterpret_cast<const char *>(frag_records.data()),
+             frag_records.size() * sizeof(FragmentRecord));
+    os.write(reinterpret_cast<const char *>(labels.data()), labels.size() * 8);
+    os.write(reinterpret_cast<const char *>(supersets.data()),
+             supersets.size() * 8);
+    if (!os.flush())
+      throw std::runtime_error("Unable to write Athenaeum snapshot: " + path);
+  }
+
+  bool IsAthenaeumSnapshot(const std::string &path) {
+    std::ifstream is(path, std::ios::binary);
+    char magic[sizeof(file_magic)];
+    if (!is.read(magic, sizeof(magic))) return false;
+    return std::memcmp(magic, file_magic, sizeof(file_magic)) == 0;
+  }
+
+} // namespace indigox::io
@@ -0,0 +1,605 @@
+#include <indigox/classes/columnar.hpp>
+#include <indigox/classes/columnar_impl.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/io/molecule_archive.hpp>
+#include <indigox/utils/mapped_file.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#ifndef INDIGOX_DISABLE_SANITY_CHECKS
+#define _sanity_check_(x)                                                      \
+  if (!x)                                                                      \
+  throw std::runtime_error(                                                    \
+      "Attempting to access data from invalid archive instance")
+#else
+#define _sanity_check_(x)
+#endif
+
+namespace indigox::io {
+
+  namespace {
+    struct FileHeader {
+      char magic[8];
+      uint32_t version;
+      uint32_t byte_order;
+      uint64_t num_molecules;
+      // Offset of the index, or 0 if it is to be rebuilt from the blocks
+      uint64_t index_offset;
+      char padding[32];
+    };
+    static_assert(sizeof(FileHeader) == 64, "Archive header must be 64 B");
+
+    // Header of the block of one molecule. Type counts exclude the empty
+    // type, which is always at index 0 of a pool.
+    struct BlockHeader {
+      char magic[4];
+      uint32_t name_length;
+      uint64_t block_size;
+      uint64_t forcefield_hash;
+      uint32_t num_atoms;
+      uint32_t num_bonds;
+      uint32_t num_strings;
+      uint32_t strings_size;
+      uint32_t num_atom_types;
+      uint32_t num_bond_types;
+      int32_t molecular_charge;
+      uint32_t padding;
+    };
+    static_assert(sizeof(BlockHeader) == 56, "Unexpected block header size");
+
+    const char file_magic[8] = {'I', 'X', 'M', 'O', 'L', 'A', 'R', 'C'};
+    const char block_magic[4] = {'I', 'X', 'M', 'B'};
+    const uint32_t file_version = 1;
+    const uint32_t byte_order_mark = 0x01020304;
+
+    size_t Padded(size_t n) { return (n + 7) & ~size_t(7); }
+
+    // Bytes of the columns of a block, in the order written by Encode. Wider
+    // columns come first so every column is aligned.
+    size_t ColumnsSize(const BlockHeader &h) {
+      size_t n = h.num_atoms, m = h.num_bonds;
+      return 4 * n * sizeof(double) + 5 * n * sizeof(uint32_t) +
+             3 * m * sizeof(uint32_t) + h.num_atom_types * sizeof(int32_t) +
+             2 * size_t(h.num_bond_types) * sizeof(uint32_t) +
+             (size_t(h.num_strings) + 1) * sizeof(uint32_t) + 2 * n + m +
+             h.strings_size + h.name_length;
+    }
+
+    template <class T>
+    void Put(std::string &buffer, const T *values, size_t count) {
+      buffer.append(reinterpret_cast<const char *>(values),
+                    count * sizeof(T));
+    }
+
+    // Sequential copy of columns out of a block
+    class Cursor {
+      const char *m_pos;
+
+    public:
+      explicit Cursor(const char *pos) : m_pos(pos) {}
+
+      template <class T> void Get(T *out, size_t count) {
+        if (count) std::memcpy(out, m_pos, count * sizeof(T));
+        m_pos += count * sizeof(T);
+      }
+
+      template <class T> void Get(std::vector<T> &out, size_t count) {
+        out.resize(count);
+        Get(out.data(), count);
+      }
+
+      const char *Skip(size_t bytes) {
+        const char *start = m_pos;
+        m_pos += bytes;
+        return start;
+      }
+    };
+
+    [[noreturn]] void Corrupt(const std::string &path) {
+      throw std::runtime_error("Corrupt molecule archive: " + path);
+    }
+  } // namespace
+
+  // ===========================================================================
+  // == MoleculeArchive implementation =========================================
+  // ===========================================================================
+
+  struct MoleculeArchive::Impl {
+    std::string path;
+    Forcefield forcefield;
+    uint64_t forcefield_hash;
+
+    // Guards everything appending changes. Current mapping, replaced when
+    // blocks appended since are read. Only blocks before mapped_end were
+    // complete when it was mapped.
+    std::mutex mutex;
+    std::shared_ptr<utils::MappedFile> file;
+    uint64_t mapped_end;
+
+    std::vector<uint64_t> offsets;
+    // A deque so that names given out stay valid while appending
+    std::deque<std::string> names;
+    std::unordered_map<std::string, uint64_t> name_lookup;
+
+    std::fstream output;
+    uint64_t data_end;
+    bool dirty;
+
+    Impl(const std::string &p, const Forcefield &ff)
+        : path(p), forcefield(ff), forcefield_hash(ff ? ff.GetHash() : 0),
+          data_end(sizeof(FileHeader)), dirty(false) {
+      if (!std::ifstream(path)) WriteHeader(0, 0, true);
+      file = std::make_shared<utils::MappedFile>(path);
+
+      FileHeader header;
+      if (file->GetSize() < sizeof(FileHeader))
+        throw std::runtime_error("Not a molecule archive: " + path);
+      std::memcpy(&header, file->GetData(), sizeof(FileHeader));
+      if (std::memcmp(header.magic, file_magic, sizeof(file_magic)))
+        throw std::runtime_error("Not a molecule archive: " + path);
+      if (header.version != file_version)
+        throw std::runtime_error("Unsupported molecule archive version: " +
+                                 path);
+      if (header.byte_order != byte_order_mark)
+        throw std::runtime_error("Molecule archive has wrong byte order: " +
+                                 path);
+      if (header.index_offset) ReadIndex(header);
+      else ScanBlocks();
+      mapped_end = data_end;
+    }
+
+    ~Impl() {
+      try {
+        Flush();
+      } catch (...) {
+        // Nothing can be reported from here. The index is rebuilt on the next
+        // open.
+      }
+    }
+
+    void AddEntry(uint64_t offset, std::string name) {
+      name_lookup.emplace(name, offsets.size());
+      offsets.push_back(offset);
+      names.emplace_back(std::move(name));
+    }
+
+    // Index is the block offsets, then offsets into the concatenated names
+    void ReadIndex(const FileHeader &header) {
+      uint64_t count = header.num_molecules;
+      uint64_t start = header.index_offset;
+      uint64_t size = file->GetSize();
+      if (start < sizeof(FileHeader) || start > size ||
+          (size - start) / sizeof(uint64_t) < 2 * count + 1)
+        Corrupt(path);
+      Cursor cursor(file->GetData() + start);
+      std::vector<uint64_t> block_offsets, name_offsets;
+      cursor.Get(block_offsets, count);
+      cursor.Get(name_offsets, count + 1);
+      uint64_t names_start = start + (2 * count + 1) * sizeof(uint64_t);
+      if (names_start > size || name_offsets.back() > size - names_start)
+        Corrupt(path);
+      const char *chars = cursor.Skip(0);
+
+      offsets.reserve(count);
+      name_lookup.reserve(count);
+      for (uint64_t i = 0; i < count; ++i) {
+        if (name_offsets[i] > name_offsets[i + 1] ||
+            block_offsets[i] < sizeof(FileHeader) || block_offsets[i] >= start)
+          Corrupt(path);
+        AddEntry(block_offsets[i],
+                 std::string(chars + name_offsets[i],
+                             name_offsets[i + 1] - name_offsets[i]));
+      }
+      data_end = start;
+    }
+
+    // Rebuild the index from the blocks, up to the first incomplete one
+    void ScanBlocks() {
+      const char *data = file->GetData();
+      uint64_t size = file->GetSize();
+      uint64_t pos = sizeof(FileHeader);
+      BlockHeader header;
+      while (size - pos >= sizeof(BlockHeader)) {
+        std::memcpy(&header, data + pos, sizeof(BlockHeader));
+        size_t used = sizeof(BlockHeader) + ColumnsSize(header);
+        if (std::memcmp(header.magic, block_magic, sizeof(block_magic)) ||
+            header.block_size != Padded(used) ||
+            header.block_size > size - pos)
+          break;
+        const char *name = data + pos + used - header.name_length;
+        AddEntry(pos, std::string(name, header.name_length));
+        pos += header.block_size;
+      }
+      data_end = pos;
+      dirty = !offsets.empty();
+    }
+
+    void WriteHeader(uint64_t count, uint64_t index_offset, bool create) {
+      FileHeader header;
+      std::memset(&header, 0, sizeof(FileHeader));
+      std::memcpy(header.magic, file_magic, sizeof(file_magic));
+      header.version = file_version;
+      header.byte_order = byte_order_mark;
+      header.num_molecules = count;
+      header.index_offset = index_offset;
+      if (create) {
+        std::ofstream os(path, std::ios::binary);
+        if (!os.write(reinterpret_cast<const char *>(&header), sizeof(header)))
+          throw std::runtime_error("Unable to create molecule archive: " +
+                                   path);
+        return;
+      }
+      output.seekp(0);
+      output.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      if (!output.flush())
+        throw std::runtime_error("Unable to write molecule archive: " + path);
+    }
+
+    // Open for writing. The index on disk is marked stale before any block
+    // overwrites it.
+    void OpenOutput() {
+      if (!output.is_open()) {
+        output.open(path, std::ios::in | std::ios::out | std::ios::binary);
+        if (!output.is_open())
+          throw std::runtime_error("Unable to write molecule archive: " +
+                                   path);
+      }
+      if (!dirty) {
+        WriteHeader(0, 0, false);
+        dirty = true;
+      }
+    }
+
+    void Flush() {
+      if (!dirty) return;
+      OpenOutput();
+      std::string index;
+      std::vector<uint64_t> name_offsets(1, 0);
+      name_offsets.reserve(names.size() + 1);
+      for (const std::string &name : names)
+        name_offsets.push_back(name_offsets.back() + name.size());
+      Put(index, offsets.data(), offsets.size());
+      Put(index, name_offsets.data(), name_offsets.size());
+      for (const std::string &name : names) index.append(name);
+      index.resize(Padded(index.size()), '\0');
+
+      output.seekp(data_end);
+      output.write(index.data(), index.size());
+      if (!output)
+        throw std::runtime_error("Unable to write molecule archive: " + path);
+      WriteHeader(offsets.size(), data_end, false);
+      dirty = false;
+    }
+
+    // Mapping which includes the given end of a block. Requires the lock.
+    std::shared_ptr<utils::MappedFile> Mapping(uint64_t end) {
+      if (mapped_end < end) {
+        if (output.is_open()) output.flush();
+        file = std::make_shared<utils::MappedFile>(path);
+        mapped_end = data_end;
+        if (file->GetSize() < end) Corrupt(path);
+      }
+      return file;
+    }
+
+    uint64_t Position(const std::string &name) {
+      std::lock_guard<std::mutex> lock(mutex);
+      auto found = name_lookup.find(name);
+      if (found == name_lookup.end())
+        throw std::out_of_range("No molecule named " + name + " in archive");
+      return found->second;
+    }
+
+    // Forcefield of a block with the given hash, empty if not available
+    Forcefield ForcefieldFor(uint64_t hash) {
+      if (!hash) return Forcefield();
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (forcefield && hash == forcefield_hash) return forcefield;
+      }
+      Forcefield builtin = GenerateGROMOS54A7();
+      return builtin.GetHash() == hash ? builtin : Forcefield();
+    }
+
+    static std::string Encode(ColumnarMolecule::Impl &mol, uint64_t hash) {
+      size_t n = mol.atomic_numbers.size(), m = mol.bond_atoms.size();
+      BlockHeader header;
+      std::memset(&header, 0, sizeof(BlockHeader));
+      std::memcpy(header.magic, block_magic, sizeof(block_magic));
+      header.name_length = uint32_t(mol.name.size());
+      header.forcefield_hash = hash;
+      header.num_atoms = uint32_t(n);
+      header.num_bonds = uint32_t(m);
+      header.num_strings = uint32_t(mol.strings.size());
+      header.num_atom_types = uint32_t(mol.atom_type_pool.size() - 1);
+      header.num_bond_types = uint32_t(mol.bond_type_pool.size() - 1);
+      header.molecular_charge = mol.molecular_charge;
+
+      std::vector<uint32_t> string_offsets(1, 0);
+      string_offsets.reserve(mol.strings.size() + 1);
+      for (const std::string &s : mol.strings)
+        string_offsets.push_back(string_offsets.back() + uint32_t(s.size()));
+      header.strings_size = string_offsets.back();
+      size_t used = sizeof(BlockHeader) + ColumnsSize(header);
+      header.block_size = Padded(used);
+
+      std::string block;
+      block.reserve(header.block_size);
+      Put(block, &header, 1);
+      Put(block, mol.coordinates.x_vals(), n);
+      Put(block, mol.coordinates.y_vals(), n);
+      Put(block, mol.coordinates.z_vals(), n);
+      Put(block, mol.partial_charges.data(), n);
+      Put(block, mol.residue_ids.data(), n);
+      Put(block, mol.charge_group_ids.data(), n);
+      Put(block, mol.names.data(), n);
+      Put(block, mol.residue_names.data(), n);
+      Put(block, mol.atom_types.data(), n);
+      Put(block, mol.bond_atoms.data(), m);
+      Put(block, mol.bond_types.data(), m);
+      for (size_t i = 1; i < mol.atom_type_pool.size(); ++i) {
+        int32_t id = mol.atom_type_pool[i].GetID();
+        Put(block, &id, 1);
+      }
+      for (size_t i = 1; i < mol.bond_type_pool.size(); ++i) {
+        uint32_t form = uint32_t(mol.bond_type_pool[i].GetType());
+        Put(block, &form, 1);
+      }
+      for (size_t i = 1; i < mol.bond_type_pool.size(); ++i) {
+        int32_t id = mol.bond_type_pool[i].GetID();
+        Put(block, &id, 1);
+      }
+      Put(block, string_offsets.data(), string_offsets.size());
+      Put(block, mol.atomic_numbers.data(), n);
+      Put(block, mol.formal_charges.data(), n);
+      for (BondOrder order : mol.bond_orders) block.push_back(char(order));
+      for (const std::string &s : mol.strings) block.append(s);
+      block.append(mol.name);
+      block.resize(header.block_size, '\0');
+      return block;
+    }
+
+    ColumnarMolecule Decode(const char *data, uint64_t available) {
+      BlockHeader header;
+      if (available < sizeof(BlockHeader)) Corrupt(path);
+      std::memcpy(&header, data, sizeof(BlockHeader));
+      if (std::memcmp(header.magic, block_magic, sizeof(block_magic)) ||
+          header.block_size > available ||
+          header.block_size < sizeof(BlockHeader) + ColumnsSize(header))
+        Corrupt(path);
+      size_t n = header.num_atoms, m = header.num_bonds;
+
+      Forcefield ff = ForcefieldFor(header.forcefield_hash);
+      if (!ff && (header.num_atom_types || header.num_bond_types))
+        throw std::runtime_error("Molecule archive " + path +
+                                 " needs the forcefield its types are from");
+
+      ColumnarMolecule result("");
+      ColumnarMolecule::Impl &mol = *result.m_data;
+      mol.molecular_charge = header.molecular_charge;
+      mol.forcefield = ff;
+
+      Cursor cursor(data + sizeof(BlockHeader));
+      AtomicCoordinates &coords = mol.coordinates;
+      coords.Reserve(uint32_t(n));
+      cursor.Get(coords.x_vals(), n);
+      cursor.Get(coords.y_vals(), n);
+      cursor.Get(coords.z_vals(), n);
+      // Padding of the last group of four is zero, as after Append
+      for (size_t i = n; i < coords.max_size && i % 4; ++i)
+        coords.SetCoordinates(uint32_t(i), 0.0, 0.0, 0.0);
+      coords.size = uint32_t(n);
+      cursor.Get(mol.partial_charges, n);
+      cursor.Get(mol.residue_ids, n);
+      cursor.Get(mol.charge_group_ids, n);
+      cursor.Get(mol.names, n);
+      cursor.Get(mol.residue_names, n);
+      cursor.Get(mol.atom_types, n);
+      cursor.Get(mol.bond_atoms, m);
+      cursor.Get(mol.bond_types, m);
+
+      std::vector<int32_t> atom_ids, bond_ids;
+      std::vector<uint32_t> bond_forms, string_offsets;
+      cursor.Get(atom_ids, header.num_atom_types);
+      cursor.Get(bond_forms, header.num_bond_types);
+      cursor.Get(bond_ids, header.num_bond_types);
+      cursor.Get(string_offsets, size_t(header.num_strings) + 1);
+      cursor.Get(mol.atomic_numbers, n);
+      cursor.Get(mol.formal_charges, n);
+      const char *orders = cursor.Skip(m);
+      const char *strings = cursor.Skip(header.strings_size);
+      mol.name.assign(cursor.Skip(header.name_length), header.name_length);
+
+      mol.bond_orders.resize(m);
+      for (size_t i = 0; i < m; ++i)
+        mol.bond_orders[i] = static_cast<BondOrder>(uint8_t(orders[i]));
+
+      // Pools, and the lookups used to intern further values
+      if (!header.num_strings || string_offsets[0] ||
+          string_offsets.back() != header.strings_size)
+        Corrupt(path);
+      mol.strings.clear();
+      mol.string_lookup.clear();
+      mol.strings.reserve(header.num_strings);
+      for (uint32_t i = 0; i < header.num_strings; ++i) {
+        if (string_offsets[i] > string_offsets[i + 1]) Corrupt(path);
+        mol.strings.emplace_back(strings + string_offsets[i],
+                                 string_offsets[i + 1] - string_offsets[i]);
+        mol.string_lookup.emplace(mol.strings.back(), i);
+      }
+      mol.atom_type_pool.reserve(atom_ids.size() + 1);
+      for (int32_t id : atom_ids) {
+        FFAtom type = ff.GetAtomType(id);
+        if (!type) Corrupt(path);
+        mol.atom_type_lookup.emplace(id, mol.atom_type_pool.size());
+        mol.atom_type_pool.emplace_back(type);
+      }
+      mol.bond_type_pool.reserve(bond_ids.size() + 1);
+      for (size_t i = 0; i < bond_ids.size(); ++i) {
+        FFBond type = ff.GetBondType(BondType(bond_forms[i]), bond_ids[i]);
+        if (!type) Corrupt(path);
+        int64_t key = (int64_t(bond_forms[i]) << 32) | uint32_t(bond_ids[i]);
+        mol.bond_type_lookup.emplace(key, mol.bond_type_pool.size());
+        mol.bond_type_pool.emplace_back(type);
+      }
+
+      // Every pool index and atom index must be in range
+      for (size_t i = 0; i < n; ++i) {
+        if (mol.names[i] >= header.num_strings ||
+            mol.residue_names[i] >= header.num_strings ||
+            mol.atom_types[i] > header.num_atom_types)
+          Corrupt(path);
+      }
+      mol.bond_lookup.reserve(m);
+      for (size_t i = 0; i < m; ++i) {
+        uint32_t a = mol.bond_atoms[i][0], b = mol.bond_atoms[i][1];
+        if (a >= n || b >= n || a == b ||
+            mol.bond_types[i] > header.num_bond_types)
+          Corrupt(path);
+        mol.bond_lookup.emplace_back(ColumnarMolecule::Impl::BondKey(a, b),
+                                     uint32_t(i));
+      }
+      std::sort(mol.bond_lookup.begin(), mol.bond_lookup.end());
+      mol.bond_lookup_sorted = m;
+      mol.adjacency_valid = false;
+      return result;
+    }
+  };
+
+  // ===========================================================================
+  // == MoleculeArchive construction ===========================================
+  // ===========================================================================
+
+  MoleculeArchive::MoleculeArchive(const std::string &path,
+                                   const Forcefield &ff)
+      : m_data(std::make_shared<Impl>(path, ff)) {}
+
+  // ===========================================================================
+  // == MoleculeArchive data getting ===========================================
+  // ===========================================================================
+
+  uint64_t MoleculeArchive::NumMolecules() const {
+    _sanity_check_(*this);
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    return m_data->offsets.size();
+  }
+
+  const std::string &MoleculeArchive::GetPath() const {
+    _sanity_check_(*this);
+    return m_data->path;
+  }
+
+  Forcefield MoleculeArchive::GetForcefield() const {
+    _sanity_check_(*this);
+    // Append may set it, so it is copied under the lock
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    return m_data->forcefield;
+  }
+
+  bool MoleculeArchive::HasMolecule(const std::string &name) const {
+    _sanity_check_(*this);
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    return m_data->name_lookup.count(name) != 0;
+  }
+
+  int64_t MoleculeArchive::GetIndex(const std::string &name) const {
+    _sanity_check_(*this);
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    auto found = m_data->name_lookup.find(name);
+    return found == m_data->name_lookup.end() ? -1 : int64_t(found->second);
+  }
+
+  const std::string &MoleculeArchive::GetName(uint64_t pos) const {
+    _sanity_check_(*this);
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    return m_data->names.at(pos);
+  }
+
+  ColumnarMolecule MoleculeArchive::GetColumnar(uint64_t pos) const {
+    _sanity_check_(*this);
+    Impl &dat = *m_data;
+    uint64_t start, end;
+    std::shared_ptr<utils::MappedFile> file;
+    {
+      std::lock_guard<std::mutex> lock(dat.mutex);
+      if (pos >= dat.offsets.size())
+        throw std::out_of_range("Molecule archive position out of range");
+      start = dat.offsets[pos];
+      end = pos + 1 < dat.offsets.size() ? dat.offsets[pos + 1] : dat.data_end;
+      if (end < start) Corrupt(dat.path);
+      file = dat.Mapping(end);
+    }
+    // Blocks are never rewritten, so are decoded without the lock
+    return dat.Decode(file->GetData() + start, end - start);
+  }
+
+  ColumnarMolecule MoleculeArchive::GetColumnar(const std::string &name) const {
+    _sanity_check_(*this);
+    return GetColumnar(m_data->Position(name));
+  }
+
+  Molecule MoleculeArchive::GetMolecule(uint64_t pos) const {
+    return GetColumnar(pos).ToMolecule();
+  }
+
+  Molecule MoleculeArchive::GetMolecule(const std::string &name) const {
+    return GetColumnar(name).ToMolecule();
+  }
+
+  // ===========================================================================
+  // == MoleculeArchive appending ==============================================
+  // ===========================================================================
+
+  uint64_t MoleculeArchive::Append(const ColumnarMolecule &mol) {
+    _sanity_check_(*this);
+    if (!mol) throw std::runtime_error("Unable to archive invalid molecule");
+    Impl &dat = *m_data;
+    ColumnarMolecule::Impl &cmol = *mol.m_data;
+
+    uint64_t hash = cmol.forcefield ? cmol.forcefield.GetHash() : 0;
+    std::string block = Impl::Encode(cmol, hash);
+
+    std::lock_guard<std::mutex> lock(dat.mutex);
+    if (cmol.forcefield) {
+      bool typed =
+          cmol.atom_type_pool.size() > 1 || cmol.bond_type_pool.size() > 1;
+      if (typed && !dat.forcefield) {
+        dat.forcefield = cmol.forcefield;
+        dat.forcefield_hash = hash;
+      } else if (typed && hash != dat.forcefield_hash) {
+        throw std::runtime_error("Molecule " + cmol.name +
+                                 " is typed with a forcefield other than that "
+                                 "of the archive");
+      }
+    }
+
+    dat.OpenOutput();
+    dat.output.seekp(dat.data_end);
+    dat.output.write(block.data(), block.size());
+    if (!dat.output)
+      throw std::runtime_error("Unable to write molecule archive: " +
+                               dat.path);
+    dat.AddEntry(dat.data_end, cmol.name);
+    dat.data_end += block.size();
+    return dat.offsets.size() - 1;
+  }
+
+  uint64_t MoleculeArchive::Append(const Molecule &mol) {
+    return Append(ColumnarMolecule(mol));
+  }
+
+  void MoleculeArchive::Flush() {
+    _sanity_check_(*this);
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    m_data->Flush();
+  }
+
+} // namespace indigox::io
@@ -0,0 +1,469 @@
+#include <indigox/algorithm/cherrypicker.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/classes/parameterised.hpp>
+#include <indigox/io/parameterisation_server.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef INDIGOX_DISABLE_SANITY_CHECKS
+#define _sanity_check_(x)                                                      \
+  if (!x)                                                                      \
+  throw std::runtime_error(                                                    \
+      "Attempting to access data from invalid server or client")
+#else
+#define _sanity_check_(x)
+#endif
+
+namespace indigox::io {
+
+  namespace {
+    const char frame_magic[4] = {'I', 'X', 'P', 'M'};
+    const size_t frame_header_size = 13;
+    const uint64_t max_payload = uint64_t(1) << 30;
+    // Seconds a connection may stall within a frame
+    const time_t frame_timeout = 30;
+
+    enum FrameKind : uint8_t { Request = 1, Result = 2, Error = 3 };
+
+    std::string ErrnoMessage(const std::string &what) {
+      return what + ": " + std::generic_category().message(errno);
+    }
+
+    // Closes a socket on leaving scope
+    struct Socket {
+      int fd;
+      explicit Socket(int f) : fd(f) {}
+      Socket(const Socket &) = delete;
+      Socket &operator=(const Socket &) = delete;
+      ~Socket() {
+        if (fd >= 0) close(fd);
+      }
+    };
+
+    sockaddr_un SocketAddress(const std::string &path) {
+      sockaddr_un addr;
+      std::memset(&addr, 0, sizeof(addr));
+      addr.sun_family = AF_UNIX;
+      if (path.empty() || path.size() >= sizeof(addr.sun_path))
+        throw std::runtime_error("Invalid socket path: " + path);
+      std::memcpy(addr.sun_path, path.data(), path.size());
+      return addr;
+    }
+
+    bool Connect(int fd, const std::string &path) {
+      sockaddr_un addr = SocketAddress(path);
+      return connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ==
+             0;
+    }
+
+    // Read exactly n bytes. Returns the number read, which is less than n
+    // only if the connection was closed.
+    size_t ReadAll(int fd, char *data, size_t n) {
+      size_t done = 0;
+      while (done < n) {
+        ssize_t r = recv(fd, data + done, n - done, 0);
+        if (r == 0) break;
+        if (r < 0) {
+          if (errno == EINTR) continue;
+          throw std::runtime_error(ErrnoMessage("Unable to read from socket"));
+        }
+        done += size_t(r);
+      }
+      return done;
+    }
+
+    bool WriteAll(int fd, const char *data, size_t n) {
+      while (n) {
+        ssize_t w = send(fd, data, n, MSG_NOSIGNAL);
+        if (w < 0) {
+          if (errno == EINTR) continue;
+          return false;
+        }
+        data += w;
+        n -= size_t(w);
+      }
+      return true;
+    }
+
+    // Read a frame. Returns false if the connection was closed between
+    // frames.
+    bool ReadFrame(int fd, uint8_t &kind, std::string &payload) {
+      char header[frame_header_size];
+      size_t n = ReadAll(fd, header, frame_header_size);
+      if (n == 0) return false;
+      if (n < frame_header_size || std::memcmp(header, frame_magic, 4))
+        throw std::runtime_error("Malformed frame header");
+      uint64_t length;
+      kind = uint8_t(header[4]);
+      std::memcpy(&length, header + 5, sizeof(length));
+      if (length > max_payload)
+        throw std::runtime_error("Frame payload is too large");
+      payload.resize(length);
+      if (ReadAll(fd, &payload[0], length) < length)
+        throw std::runtime_error("Connection closed within a frame");
+      return true;
+    }
+
+    bool WriteFrame(int fd, uint8_t kind, const std::string &payload) {
+      char header[frame_header_size];
+      uint64_t length = payload.size();
+      std::memcpy(header, frame_magic, 4);
+      header[4] = char(kind);
+      std::memcpy(header + 5, &length, sizeof(length));
+      return WriteAll(fd, header, frame_header_size) &&
+             WriteAll(fd, payload.data(), payload.size());
+    }
+  } // namespace
+
+  // ===========================================================================
+  // == ParameterisationServer implementation ==================================
+  // ===========================================================================
+
+  struct ParameterisationServer::Impl {
+    std::string path;
+    int listen_fd;
+    // Written to wake the thread polling the connections
+    int wake_fds[2];
+    // One per worker, sharing the Athenaeums
+    std::vector<algorithm::CherryPicker> pickers;
+    std::atomic<uint64_t> served;
+
+    // Guards stopping and the connections. Idle connections are polled for
+    // their next request, which moves them to ready until a worker takes
+    // them, and to busy while it answers.
+    std::mutex mutex;
+    std::condition_variable wake_workers;
+    bool stopping;
+    std::set<int> idle, busy;
+    std::deque<int> ready;
+
+    Impl(const algorithm::CherryPicker &picker, const std::string &p,
+         uint32_t num_threads)
+        : path(p), listen_fd(-1), wake_fds{-1, -1}, served(0),
+          stopping(false) {
+      if (!num_threads) num_threads = std::thread::hardware_concurrency();
+      if (!num_threads) num_threads = 1;
+      pickers.assign(num_threads, picker);
+
+      // Replace the socket of a server which has stopped, but never anything
+      // else
+      struct stat st;
+      if (lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode))
+          throw std::runtime_error(path + " exists and is not a socket");
+        Socket probe(socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        if (probe.fd >= 0 && Connect(probe.fd, path))
+          throw std::runtime_error("A server is already listening on " + path);
+        unlink(path.c_str());
+      }
+
+      if (pipe2(wake_fds, O_CLOEXEC | O_NONBLOCK))
+        throw std::runtime_error(ErrnoMessage("Unable to create pipe"));
+      sockaddr_un addr = SocketAddress(path);
+      listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK,
+                         0);
+      if (listen_fd < 0) {
+        std::string msg = ErrnoMessage("Unable to create socket");
+        close(wake_fds[0]);
+        close(wake_fds[1]);
+        throw std::runtime_error(msg);
+      }
+      if (bind(listen_fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) ||
+          listen(listen_fd, SOMAXCONN)) {
+        std::string msg = ErrnoMessage("Unable to listen on " + path);
+        close(listen_fd);
+        close(wake_fds[0]);
+        close(wake_fds[1]);
+        throw std::runtime_error(msg);
+      }
+    }
+
+    ~Impl() {
+      close(listen_fd);
+      close(wake_fds[0]);
+      close(wake_fds[1]);
+      unlink(path.c_str());
+    }
+
+    void Wake() {
+      char c = 0;
+      while (write(wake_fds[1], &c, 1) < 0 && errno == EINTR) {
+      }
+    }
+
+    // Answer one request. Returns false if the connection is to be closed.
+    bool Answer(int fd, algorithm::CherryPicker &picker) {
+      uint8_t kind;
+      std::string payload;
+      if (!ReadFrame(fd, kind, payload)) return false;
+      uint8_t response_kind = Result;
+      std::string response;
+      try {
+        if (kind != Request)
+          throw std::runtime_error("Expected a request frame");
+        std::istringstream is(payload);
+        Molecule mol = LoadMolecule(is);
+        picker.ParameteriseMolecule(mol);
+        std::ostringstream os;
+        SaveMolecule(mol, os);
+        response = os.str();
+      } catch (const std::exception &e) {
+        response_kind = Error;
+        response = e.what();
+      }
+      ++served;
+      return WriteFrame(fd, response_kind, response);
+    }
+
+    // Accept connections and wait for requests on the idle ones, handing
+    // each to the workers, until stopped
+    void Poll() {
+      std::vector<pollfd> polled;
+      while (true) {
+        polled.clear();
+        polled.push_back({listen_fd, POLLIN, 0});
+        polled.push_back({wake_fds[0], POLLIN, 0});
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (stopping) return;
+          for (int fd : idle) polled.push_back({fd, POLLIN, 0});
+        }
+        if (poll(polled.data(), polled.size(), -1) < 0) {
+          if (errno == EINTR) continue;
+          throw std::runtime_error(ErrnoMessage("Unable to poll connections"));
+        }
+
+        char drain[64];
+        while (read(wake_fds[0], drain, sizeof(drain)) > 0) {
+        }
+        std::vector<int> accepted;
+        if (polled[0].revents) {
+          int fd;
+          while ((fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC)) >=
+                 0) {
+            // A worker waits only this long for the rest of a request, or
+            // to send its answer, so a stalled client cannot hold it
+            timeval timeout{frame_timeout, 0};
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            accepted.push_back(fd);
+          }
+          // Likely out of file descriptors, so wait for some to close
+          if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR &&
+              errno != ECONNABORTED && accepted.empty())
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) {
+          for (int fd : accepted) close(fd);
+          return;
+        }
+        idle.insert(accepted.begin(), accepted.end());
+        for (size_t i = 2; i < polled.size(); ++i) {
+          if (!polled[i].revents) continue;
+          idle.erase(polled[i].fd);
+          ready.push_back(polled[i].fd);
+          wake_workers.notify_one();
+        }
+      }
+    }
+
+    // Answer requests as they are ready until stopped
+    void Work(algorithm::CherryPicker &picker) {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        wake_workers.wait(lock,
+                          [this]() { return stopping || !ready.empty(); });
+        if (stopping) return;
+        int fd = ready.front();
+        ready.pop_front();
+        busy.insert(fd);
+        lock.unlock();
+        bool keep = false;
+        try {
+          keep = Answer(fd, picker);
+        } catch (const std::exception &) {
+          // Malformed, stalled or broken connection, which is dropped
+        }
+        lock.lock();
+        busy.erase(fd);
+        if (keep && !stopping) {
+          idle.insert(fd);
+          Wake();
+        } else {
+          close(fd);
+        }
+      }
+    }
+  };
+
+  // ===========================================================================
+  // == ParameterisationServer construction ====================================
+  // ===========================================================================
+
+  ParameterisationServer::ParameterisationServer(
+      const algorithm::CherryPicker &picker, const std::string &socket_path,
+      uint32_t num_threads)
+      : m_data(std::make_shared<Impl>(picker, socket_path, num_threads)) {}
+
+  // ===========================================================================
+  // == ParameterisationServer serving =========================================
+  // ===========================================================================
+
+  void ParameterisationServer::Serve() {
+    _sanity_check_(*this);
+    std::vector<std::thread> workers;
+    for (algorithm::CherryPicker &picker : m_data->pickers)
+      workers.emplace_back(&Impl::Work, m_data.get(), std::ref(picker));
+    std::exception_ptr error;
+    try {
+      m_data->Poll();
+    } catch (...) {
+      error = std::current_exception();
+      Stop();
+    }
+    for (std::thread &worker : workers) worker.join();
+
+    // Close the connections left waiting
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    for (int fd : m_data->idle) close(fd);
+    for (int fd : m_data->ready) close(fd);
+    m_data->idle.clear();
+    m_data->ready.clear();
+    if (error) std::rethrow_exception(error);
+  }
+
+  void ParameterisationServer::Stop() {
+    _sanity_check_(*this);
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    m_data->stopping = true;
+    for (int fd : m_data->busy) shutdown(fd, SHUT_RDWR);
+    m_data->wake_workers.notify_all();
+    m_data->Wake();
+  }
+
+  const std::string &ParameterisationServer::GetSocketPath() const {
+    _sanity_check_(*this);
+    return m_data->path;
+  }
+
+  uint64_t ParameterisationServer::NumServed() const {
+    _sanity_check_(*this);
+    return m_data->served;
+  }
+
+  // ===========================================================================
+  // == ParameterisationClient implementation ==================================
+  // ===========================================================================
+
+  struct ParameterisationClient::Impl {
+    std::string path;
+    int fd;
+    // Requests on one connection are answered in order, so only one may be
+    // in flight at a time
+    std::mutex mutex;
+
+    explicit Impl(const std::string &p) : path(p), fd(-1) { Reconnect(); }
+    ~Impl() {
+      if (fd >= 0) close(fd);
+    }
+
+    void Reconnect() {
+      if (fd >= 0) close(fd);
+      fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+      if (fd < 0)
+        throw std::runtime_error(ErrnoMessage("Unable to create socket"));
+      if (!Connect(fd, path)) {
+        std::string msg = ErrnoMessage("Unable to connect to " + path);
+        close(fd);
+        fd = -1;
+        throw std::runtime_error(msg);
+      }
+    }
+
+    // Send a request and read its answer. Returns false if the connection
+    // is broken.
+    bool Exchange(const std::string &request, uint8_t &kind,
+                  std::string &payload) {
+      if (fd < 0 || !WriteFrame(fd, Request, request)) return false;
+      try {
+        return ReadFrame(fd, kind, payload);
+      } catch (const std::exception &) {
+        return false;
+      }
+    }
+  };
+
+  // ===========================================================================
+  // == ParameterisationClient construction ====================================
+  // ===========================================================================
+
+  ParameterisationClient::ParameterisationClient(
+      const std::string &socket_path)
+      : m_data(std::make_shared<Impl>(socket_path)) {}
+
+  // ===========================================================================
+  // == ParameterisationClient parameterising ==================================
+  // ===========================================================================
+
+  Molecule ParameterisationClient::ParameteriseMolecule(const Molecule &mol) {
+    _sanity_check_(*this);
+    std::ostringstream os;
+    SaveMolecule(mol, os);
+    std::string request = os.str();
+
+    std::lock_guard<std::mutex> lock(m_data->mutex);
+    uint8_t kind;
+    std::string payload;
+    // A server restarted since the last request has closed the connection,
+    // so reconnect once before giving up
+    if (!m_data->Exchange(request, kind, payload)) {
+      m_data->Reconnect();
+      if (!m_data->Exchange(request, kind, payload))
+        throw std::runtime_error("Lost connection to " + m_data->path);
+    }
+    if (kind == Error)
+      throw std::runtime_error("Server failed to parameterise molecule: " +
+                               payload);
+    if (kind != Result) throw std::runtime_error("Expected a result frame");
+    std::istringstream is(payload);
+    return LoadMolecule(is);
+  }
+
+  const std::string &ParameterisationClient::GetSocketPath() const {
+    _sanity_check_(*this);
+    return m_data->path;
+  }
+
+  // ===========================================================================
+  // == Remote parameterisation ================================================
+  // ===========================================================================
+
+  Molecule ParameteriseRemote(const std::string &socket_path,
+                              const Molecule &mol) {
+    return ParameterisationClient(socket_path).ParameteriseMolecule(mol);
+  }
+
+} // namespace indigox::io
@@ -0,0 +1,666 @@
+#include <indigox/classes/angle.hpp>
+#include <indigox/classes/athenaeum.hpp>
+#include <indigox/classes/atom.hpp>
+#include <indigox/classes/bond.hpp>
+#include <indigox/classes/dihedral.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/classes/periodictable.hpp>
+#include <indigox/io/readers.hpp>
+#include <indigox/utils/line_reader.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace indigox::io {
+
+  using utils::LineReader;
+
+  namespace {
+    using Tokens = std::vector<std::string_view>;
+
+    // File name without its directory or final extension
+    std::string Stem(const std::string &path) {
+      size_t slash = path.find_last_of('/');
+      std::string name = path.substr(slash == path.npos ? 0 : slash + 1);
+      size_t dot = name.find_last_of('.');
+      if (dot != std::string::npos && dot != 0 && dot + 1 != name.size())
+        name.erase(dot);
+      return name;
+    }
+
+    // Directory of a file, with its trailing slash
+    std::string Directory(const std::string &path) {
+      size_t slash = path.find_last_of('/');
+      return slash == path.npos ? std::string() : path.substr(0, slash + 1);
+    }
+
+    bool EndsWith(const std::string &s, std::string_view suffix) {
+      return s.size() >= suffix.size() &&
+             s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // Next line which is not blank once any comment and surrounding
+    // whitespace has been removed
+    bool NextLine(LineReader &file, std::string_view &line, char comment) {
+      while (file.Next(line)) {
+        line = utils::Trim(utils::StripComment(line, comment));
+        if (!line.empty()) return true;
+      }
+      return false;
+    }
+
+    void ExpectLine(LineReader &file, std::string_view &line, char comment) {
+      if (!NextLine(file, line, comment))
+        throw std::runtime_error("Unexpected end of file: " + file.GetPath());
+    }
+
+    void Need(const Tokens &tokens, size_t n, const LineReader &file) {
+      if (tokens.size() < n)
+        throw std::out_of_range("Too few fields at " + file.GetLocation());
+    }
+
+    int64_t ToInt(std::string_view s, const LineReader &file) {
+      int64_t value;
+      if (!utils::ParseInt(s, value))
+        throw std::invalid_argument("Expected an integer at " +
+                                    file.GetLocation() + ": " +
+                                    std::string(s));
+      return value;
+    }
+
+    double ToReal(std::string_view s, const LineReader &file) {
+      double value;
+      if (!utils::ParseReal(s, value))
+        throw std::invalid_argument("Expected a number at " +
+                                    file.GetLocation() + ": " +
+                                    std::string(s));
+      return value;
+    }
+
+    Atom TagAtom(const Molecule &mol, std::string_view s,
+                 const LineReader &file) {
+      int64_t tag = ToInt(s, file);
+      Atom atom = mol.GetAtomTag(tag);
+      if (!atom)
+        throw std::out_of_range("Unknown atom tag " + std::to_string(tag) +
+                                " at " + file.GetLocation());
+      return atom;
+    }
+
+    // ID of a GROMOS parameter macro, such as 12 from gb_12
+    int32_t MacroID(std::string_view s, const LineReader &file) {
+      size_t begin = s.find('_');
+      if (begin == std::string_view::npos)
+        throw std::out_of_range("Bad parameter macro at " +
+                                file.GetLocation());
+      size_t end = s.find('_', begin + 1);
+      return int32_t(ToInt(s.substr(begin + 1, end - begin - 1), file));
+    }
+
+    template <class Type>
+    const Type &CheckType(const Type &type, const LineReader &file) {
+      if (!type)
+        throw std::out_of_range("Unknown parameter type at " +
+                                file.GetLocation());
+      return type;
+    }
+
+    // Atoms and bonds of a topology, collected while their block is read and
+    // then created in bulk, so the molecule is not updated once per item.
+    class PendingTopology {
+    public:
+      void AddAtom(int64_t tag, std::string_view name, const FFAtom &type,
+                   double charge) {
+        elements.push_back(type.GetElement().GetAtomicNumber());
+        tags.push_back(tag);
+        names.push_back(name);
+        atom_types.push_back(type);
+        charges.push_back(charge);
+      }
+
+      void AddBond(const Atom &a, const Atom &b, const FFBond &type) {
+        pairs.push_back(uint32_t(a.GetIndex()));
+        pairs.push_back(uint32_t(b.GetIndex()));
+        bond_types.push_back(type);
+      }
+
+      void Flush(Molecule &mol) {
+        if (!elements.empty()) {
+          auto atoms = mol.NewAtoms(elements.size(), elements.data(), nullptr);
+          for (size_t i = 0; i < atoms.size(); ++i) {
+            atoms[i].SetTag(int32_t(tags[i]));
+            atoms[i].SetName(std::string(names[i]));
+            atoms[i].SetType(atom_types[i]);
+            atoms[i].SetPartialCharge(charges[i]);
+          }
+        }
+        if (!bond_types.empty()) {
+          auto bonds = mol.NewBonds(bond_types.size(), pairs.data());
+          for (size_t i = 0; i < bonds.size(); ++i)
+            if (bonds[i] && bond_types[i]) bonds[i].SetType(bond_types[i]);
+        }
+        elements.clear();
+        tags.clear();
+        names.clear();
+        atom_types.clear();
+        charges.clear();
+        pairs.clear();
+        bond_types.clear();
+      }
+
+    private:
+      std::vector<int32_t> elements;
+      std::vector<int64_t> tags;
+      std::vector<std::string_view> names;
+      std::vector<FFAtom> atom_types;
+      std::vector<double> charges;
+      std::vector<uint32_t> pairs;
+      std::vector<FFBond> bond_types;
+    };
+
+    void AddDihedralType(Molecule &mol, const Atom &a, const Atom &b,
+                         const Atom &c, const Atom &d, const FFDihedral &type,
+                         bool create) {
+      Dihedral dihedral = mol.GetDihedral(a, b, c, d);
+      if (!dihedral && create) dihedral = mol.NewDihedral(a, b, c, d);
+      if (!dihedral)
+        throw std::out_of_range("No dihedral found: " +
+                                std::to_string(a.GetTag()) + "-" +
+                                std::to_string(b.GetTag()) + "-" +
+                                std::to_string(c.GetTag()) + "-" +
+                                std::to_string(d.GetTag()));
+      if (type) dihedral.AddType(type);
+    }
+
+    Angle FindAngle(Molecule &mol, const Atom &a, const Atom &b,
+                    const Atom &c) {
+      Angle angle = mol.GetAngle(a, b, c);
+      if (!angle)
+        throw std::out_of_range("No angle found: " +
+                                std::to_string(a.GetTag()) + "-" +
+                                std::to_string(b.GetTag()) + "-" +
+                                std::to_string(c.GetTag()));
+      return angle;
+    }
+
+    // Read the sections of an MTBUILDBLSOLUTE block
+    void ReadMTBSolute(LineReader &file, Molecule &mol, const Forcefield &ff) {
+      std::string_view line;
+      Tokens tokens;
+      PendingTopology pending;
+      ExpectLine(file, line, '#');
+      mol.SetName(std::string(line));
+
+      // Atoms, bonds, angles, impropers, propers and LJ exceptions, each
+      // preceded by its count. Exceptions are not read.
+      for (int section = 0; section < 6; ++section) {
+        ExpectLine(file, line, '#');
+        utils::Split(line, tokens);
+        Need(tokens, 1, file);
+        int64_t count = ToInt(tokens[0], file);
+        if (section == 5) break;
+        for (int64_t i = 0; i < count; ++i) {
+          ExpectLine(file, line, '#');
+          utils::Split(line, tokens);
+          if (section == 0) {
+            Need(tokens, 5, file);
+            FFAtom type = ff.GetAtomType(int32_t(ToInt(tokens[2], file)));
+            pending.AddAtom(ToInt(tokens[0], file), tokens[1],
+                            CheckType(type, file), ToReal(tokens[4], file));
+          } else if (section == 1) {
+            Need(tokens, 3, file);
+            int32_t id = int32_t(ToInt(tokens[2], file));
+            pending.AddBond(TagAtom(mol, tokens[0], file),
+                            TagAtom(mol, tokens[1], file),
+                            CheckType(ff.GetBondType(BondType::Quartic, id),
+                                      file));
+          } else if (section == 2) {
+            Need(tokens, 4, file);
+            int32_t id = int32_t(ToInt(tokens[3], file));
+            FFAngle type = ff.GetAngleType(AngleType::CosineHarmonic, id);
+            FindAngle(mol, TagAtom(mol, tokens[0], file),
+                      TagAtom(mol, tokens[1], file),
+                      TagAtom(mol, tokens[2], file))
+                .SetType(CheckType(type, file));
+          } else {
+            Need(tokens, 5, file);
+            bool improper = section == 3;
+            DihedralType form =
+                improper ? DihedralType::Improper : DihedralType::Proper;
+            int32_t id = int32_t(ToInt(tokens[4], file));
+            FFDihedral type = ff.GetDihedralType(form, id);
+            AddDihedralType(mol, TagAtom(mol, tokens[0], file),
+                            TagAtom(mol, tokens[1], file),
+                            TagAtom(mol, tokens[2], file),
+                            TagAtom(mol, tokens[3], file),
+                            CheckType(type, file), improper);
+          }
+        }
+        // Later sections refer to the atoms and bonds by tag
+        pending.Flush(mol);
+      }
+    }
+  } // namespace
+
+  // ===========================================================================
+  // == Structure readers ======================================================
+  // ===========================================================================
+
+  Molecule ReadPDBFile(const std::string &path) {
+    LineReader file(path);
+    const PeriodicTable &pt = GetPeriodicTable();
+    std::vector<int32_t> elements;
+    std::vector<double> coordinates;
+    std::vector<std::string_view> names;
+    std::vector<int32_t> tags;
+    std::vector<uint32_t> bonds;
+    std::unordered_map<int64_t, uint32_t> tag_index;
+    std::unordered_map<std::string_view, int32_t> atomic_numbers;
+
+    std::string_view line;
+    bool got_atoms = false;
+    while (NextLine(file, line, '#')) {
+      std::string_view record = utils::Columns(line, 0, 6);
+      if ((record == "ATOM  " || record == "HETATM") && !got_atoms) {
+        int64_t tag;
+        if (utils::ParseInt(utils::Columns(line, 6, 11), tag))
+          tag_index.emplace(tag, uint32_t(tags.size()));
+        else
+          tag = 0;
+        std::string_view symbol = utils::Trim(utils::Columns(line, 76, 78));
+        auto z = atomic_numbers.find(symbol);
+        if (z == atomic_numbers.end())
+          z = atomic_numbers
+                  .emplace(symbol, pt[std::string(symbol)].GetAtomicNumber())
+                  .first;
+        elements.push_back(z->second);
+        names.push_back(utils::Trim(utils::Columns(line, 12, 16)));
+        tags.push_back(int32_t(tag));
+        double x, y, z_;
+        if (utils::ParseReal(utils::Columns(line, 30, 38), x) &&
+            utils::ParseReal(utils::Columns(line, 38, 46), y) &&
+            utils::ParseReal(utils::Columns(line, 46, 54), z_)) {
+          coordinates.insert(coordinates.end(), {x / 10, y / 10, z_ / 10});
+        } else {
+          coordinates.insert(coordinates.end(), {0., 0., 0.});
+        }
+      } else if (record == "CONECT") {
+        int64_t tag;
+        if (!utils::ParseInt(utils::Columns(line, 6, 11), tag)) continue;
+        auto a = tag_index.find(tag);
+        if (a == tag_index.end()) continue;
+        for (size_t start = 11; start < 31; start += 5) {
+          if (!utils::ParseInt(utils::Columns(line, start, start + 5), tag))
+            continue;
+          auto b = tag_index.find(tag);
+          if (b == tag_index.end() || b->second == a->second) continue;
+          bonds.push_back(a->second);
+          bonds.push_back(b->second);
+        }
+      } else if (record == "ENDMDL") {
+        got_atoms = true;
+      }
+    }
+
+    Molecule mol(Stem(path));
+    if (!elements.empty()) {
+      auto atoms =
+          mol.NewAtoms(elements.size(), elements.data(), coordinates.data());
+      for (size_t i = 0; i < atoms.size(); ++i) {
+        atoms[i].SetName(std::string(names[i]));
+        atoms[i].SetTag(tags[i]);
+      }
+    }
+    if (!bonds.empty()) mol.NewBonds(bonds.size() / 2, bonds.data());
+    return mol;
+  }
+
+  void ReadIXDFile(const std::string &path, Molecule &mol) {
+    LineReader file(path);
+    std::unordered_set<int64_t> set_implicits;
+    std::string_view line;
+    Tokens tokens;
+    std::vector<int64_t> values;
+    while (NextLine(file, line, '#')) {
+      utils::Split(line, tokens);
+      values.clear();
+      for (size_t i = 1; i < tokens.size(); ++i)
+        values.push_back(ToInt(tokens[i], file));
+      if (tokens[0] == "ATOM") {
+        Need(tokens, 4, file);
+        Atom atom = TagAtom(mol, tokens[1], file);
+        atom.SetFormalCharge(int32_t(values[1]));
+        atom.SetImplicitCount(int32_t(values[2]));
+        set_implicits.insert(values[0]);
+      } else if (tokens[0] == "BOND") {
+        Need(tokens, 4, file);
+        Atom a = mol.GetAtomTag(values[0]);
+        Atom b = mol.GetAtomTag(values[1]);
+        Bond bond = (a && b) ? mol.GetBond(a, b) : Bond();
+        if (!bond)
+          throw std::out_of_range("Unknown bond: " + std::string(tokens[1]) +
+                                  "-" + std::string(tokens[2]));
+        if (values[2] >= 1 && values[2] <= 7)
+          bond.SetOrder(Bond::Order(values[2]));
+      } else if (tokens[0] == "MOLECULE") {
+        Need(tokens, 2, file);
+        mol.SetMolecularCharge(int32_t(values[0]));
+      }
+    }
+
+    // Carbons without given implicit counts are saturated, with valences
+    // counted in half bonds
+    for (Atom atom : mol.GetAtoms()) {
+      if (atom.GetElement().GetAtomicNumber() != 6) continue;
+      if (set_implicits.count(atom.GetTag())) continue;
+      int32_t half_bonds = 0;
+      bool aromatic_bonds = false;
+      for (const Bond &bond : atom.GetBonds()) {
+        switch (bond.GetOrder()) {
+        case Bond::Order::SINGLE: half_bonds += 2; break;
+        case Bond::Order::DOUBLE: half_bonds += 4; break;
+        case Bond::Order::TRIPLE: half_bonds += 6; break;
+        case Bond::Order::QUADRUPLE: half_bonds += 8; break;
+        case Bond::Order::AROMATIC:
+          if (!aromatic_bonds) half_bonds += 2;
+          aromatic_bonds = true;
+          half_bonds += 2;
+          break;
+        case Bond::Order::ONEANDAHALF: half_bonds += 3; break;
+        case Bond::Order::TWOANDAHALF: half_bonds += 5; break;
+        default: break;
+        }
+      }
+      if (half_bonds % 2 || half_bonds > 8)
+        throw std::invalid_argument("Atom tag " +
+                                    std::to_string(atom.GetTag()) +
+                                    " has weird valence state.");
+      atom.SetImplicitCount(4 - half_bonds / 2);
+    }
+
+    int32_t total_charge = 0;
+    for (const Atom &atom : mol.GetAtoms())
+      total_charge += atom.GetFormalCharge();
+    if (total_charge != mol.GetMolecularCharge())
+      throw std::invalid_argument(
+          "Sum of atom formal charges does not match molecular charge");
+  }
+
+  // ===========================================================================
+  // == Topology readers =======================================================
+  // ===========================================================================
+
+  Molecule ReadITPFile(const std::string &path, const Forcefield &ff) {
+    LineReader file(path);
+    Molecule mol(Stem(path));
+    PendingTopology pending;
+    std::string block;
+    std::string_view line;
+    Tokens tokens;
+    while (NextLine(file, line, ';')) {
+      size_t open = line.find('[');
+      if (open != std::string_view::npos || line.find('#') != line.npos) {
+        // Later blocks refer to the atoms and bonds by tag
+        pending.Flush(mol);
+        block.clear();
+        if (open != std::string_view::npos) {
+          std::string_view name = line.substr(open + 1);
+          block = utils::Trim(name.substr(0, name.find(']')));
+        }
+        continue;
+      }
+      utils::Split(line, tokens);
+      std::string_view macro = tokens.back();
+      if (block == "atoms") {
+        Need(tokens, 7, file);
+        FFAtom type = ff.GetAtomType(std::string(tokens[1]));
+        pending.AddAtom(ToInt(tokens[0], file), tokens[4],
+                        CheckType(type, file), ToReal(tokens[6], file));
+      } else if (block == "bonds") {
+        Need(tokens, 2, file);
+        FFBond type;
+        if (macro.substr(0, 2) == "gb")
+          type = CheckType(
+              ff.GetBondType(BondType::Harmonic, MacroID(macro, file)), file);
+        pending.AddBond(TagAtom(mol, tokens[0], file),
+                        TagAtom(mol, tokens[1], file), type);
+      } else if (block == "angles") {
+        Need(tokens, 3, file);
+        Angle angle = FindAngle(mol, TagAtom(mol, tokens[0], file),
+                                TagAtom(mol, tokens[1], file),
+                                TagAtom(mol, tokens[2], file));
+        if (macro.substr(0, 2) == "ga")
+          angle.SetType(CheckType(
+              ff.GetAngleType(AngleType::Harmonic, MacroID(macro, file)),
+              file));
+      } else if (block == "dihedrals") {
+        Need(tokens, 4, file);
+        FFDihedral type;
+        if (macro.substr(0, 2) == "gi")
+          type = CheckType(ff.GetDihedralType(DihedralType::Improper,
+                                              MacroID(macro, file)),
+                           file);
+        else if (macro.substr(0, 2) == "gd")
+          type = CheckType(ff.GetDihedralType(DihedralType::Proper,
+                                              MacroID(macro, file)),
+                           file);
+        AddDihedralType(mol, TagAtom(mol, tokens[0], file),
+                        TagAtom(mol, tokens[1], file),
+                        TagAtom(mol, tokens[2], file),
+                        TagAtom(mol, tokens[3], file), type, true);
+      }
+    }
+    pending.Flush(mol);
+    return mol;
+  }
+
+  Molecule ReadMTBFile(const std::string &path, const Forcefield &ff) {
+    LineReader file(path);
+    Molecule mol(Stem(path));
+    std::string_view line;
+    bool block_start = true;
+    while (NextLine(file, line, '#')) {
+      bool is_block_name = block_start;
+      block_start = line == "END";
+      if (is_block_name && line == "MTBUILDBLSOLUTE") {
+        ReadMTBSolute(file, mol, ff);
+        block_start = false;
+      }
+    }
+    return mol;
+  }
+
+  // ===========================================================================
+  // == Fragment readers =======================================================
+  // ===========================================================================
+
+  Molecule ReadParameterisedMolecule(const std::string &coord_path,
+                                     const std::string &param_path,
+                                     const Forcefield &ff,
+                                     const std::string &detail_path) {
+    if (!EndsWith(coord_path, ".pdb"))
+      throw std::runtime_error("Unable to handle coordinate file: " +
+                               coord_path);
+    Molecule mol;
+    if (EndsWith(param_path, ".mtb"))
+      mol = ReadMTBFile(param_path, ff);
+    else if (EndsWith(param_path, ".itp") || EndsWith(param_path, ".top"))
+      mol = ReadITPFile(param_path, ff);
+    else
+      throw std::runtime_error("Unable to handle parameter file: " +
+                               param_path);
+    if (!detail_path.empty()) ReadIXDFile(detail_path, mol);
+
+    Molecule coords = ReadPDBFile(coord_path);
+    if (coords.NumAtoms() != mol.NumAtoms())
+      throw std::runtime_error("Mismatched atom counts in " + coord_path +
+                               " and " + param_path);
+    for (Atom atom : mol.GetAtoms()) {
+      Atom source = coords.GetAtomTag(atom.GetTag());
+      if (!source)
+        throw std::out_of_range("Atom tag " + std::to_string(atom.GetTag()) +
+                                " missing from " + coord_path);
+      atom.SetPosition(source.GetX(), source.GetY(), source.GetZ());
+      atom.SetElement(source.GetElement());
+    }
+    return mol;
+  }
+
+  Molecule ReadFragmentFile(const std::string &path, const Forcefield &ff,
+                            std::vector<Fragment> &fragments) {
+    LineReader file(path);
+    std::vector<std::string_view> lines;
+    std::string_view line;
+    while (NextLine(file, line, '#')) lines.push_back(line);
+
+    auto count = [&lines](std::string_view s) {
+      return std::count(lines.begin(), lines.end(), s);
+    };
+    if (lines.empty() || lines.front() != "MOLECULE" || count("MOLECULE") != 1)
+      throw std::runtime_error("Expected one MOLECULE block first in " + path);
+    if (count("FRAGMENT") != count("OVERLAP"))
+      throw std::runtime_error("Unpaired FRAGMENT and OVERLAP blocks in " +
+                               path);
+    if (lines.size() < 4 || std::find(lines.begin() + 1, lines.begin() + 4,
+                                      "END") != lines.begin() + 4)
+      throw std::runtime_error("Missing input files in " + path);
+
+    std::string dir = Directory(path);
+    Molecule mol = ReadParameterisedMolecule(
+        dir + std::string(lines[1]), dir + std::string(lines[2]), ff,
+        dir + std::string(lines[3]));
+    mol.SetName(Stem(path));
+
+    std::string_view block;
+    std::vector<Atom> frag, overlap;
+    Tokens tokens;
+    for (std::string_view data : lines) {
+      if (data == "END") {
+        if (block == "OVERLAP") {
+          fragments.emplace_back(mol, frag, overlap);
+          frag.clear();
+          overlap.clear();
+        }
+        block = std::string_view();
+      } else if (data == "MOLECULE" || data == "FRAGMENT" ||
+                 data == "OVERLAP") {
+        block = data;
+      } else if (block == "FRAGMENT" || block == "OVERLAP") {
+        std::vector<Atom> &atoms = block == "FRAGMENT" ? frag : overlap;
+        utils::Split(data, tokens);
+        for (std::string_view token : tokens) {
+          int64_t tag;
+          if (!utils::ParseInt(token, tag))
+            throw std::invalid_argument("Expected an atom tag in " + path +
+                                        ": " + std::string(token));
+          Atom atom = mol.GetAtomTag(tag);
+          if (!atom)
+            throw std::out_of_range("Unknown atom tag " + std::to_string(tag) +
+                                    " in " + path);
+          atoms.emplace_back(atom);
+        }
+      }
+    }
+    return mol;
+  }
+
+  // ===========================================================================
+  // == Forcefield readers =====================================================
+  // ===========================================================================
+
+  Forcefield ReadIFPFile(const std::string &path) {
+    LineReader file(path);
+    const PeriodicTable &pt = GetPeriodicTable();
+    Forcefield ff(Forcefield::Family::GROMOS, Stem(path));
+
+    std::string_view line, block;
+    std::vector<std::string_view> lines;
+    Tokens tokens;
+    std::vector<double> values;
+    // Parse a parameter line with exactly n values. Type IDs and
+    // multiplicities are written as reals and truncated.
+    auto parse = [&](std::string_view data, size_t n) {
+      utils::Split(data, tokens);
+      if (tokens.size() != n)
+        throw std::invalid_argument("Expected " + std::to_string(n) +
+                                    " values in " + std::string(block));
+      values.clear();
+      for (std::string_view token : tokens)
+        values.push_back(ToReal(token, file));
+    };
+    auto count = [&]() -> size_t {
+      utils::Split(lines.front(), tokens);
+      Need(tokens, 1, file);
+      return size_t(ToInt(tokens[0], file));
+    };
+
+    while (NextLine(file, line, '#')) {
+      block = line;
+      lines.clear();
+      while (NextLine(file, line, '#') && line != "END") lines.push_back(line);
+      if (lines.empty()) continue;
+
+      if (block == "BONDSTRETCHTYPECODE") {
+        ff.ReserveBondTypes(BondType::Harmonic, count());
+        ff.ReserveBondTypes(BondType::Quartic, count());
+        for (size_t i = 1; i < lines.size(); ++i) {
+          parse(lines[i], 4);
+          int32_t id = int32_t(values[0]);
+          ff.LinkBondTypes(
+              ff.NewBondType(BondType::Harmonic, id, values[2], values[3]),
+              ff.NewBondType(BondType::Quartic, id, values[1], values[3]));
+        }
+      } else if (block == "BONDANGLEBENDTYPECODE") {
+        ff.ReserveAngleTypes(AngleType::Harmonic, count());
+        ff.ReserveAngleTypes(AngleType::CosineHarmonic, count());
+        for (size_t i = 1; i < lines.size(); ++i) {
+          parse(lines[i], 4);
+          int32_t id = int32_t(values[0]);
+          ff.LinkAngleTypes(
+              ff.NewAngleType(AngleType::Harmonic, id, values[2], values[3]),
+              ff.NewAngleType(AngleType::CosineHarmonic, id, values[1],
+                              values[3]));
+        }
+      } else if (block == "IMPDIHEDRALTYPECODE") {
+        ff.ReserveDihedralTypes(DihedralType::Improper, count());
+        for (size_t i = 1; i < lines.size(); ++i) {
+          parse(lines[i], 3);
+          ff.NewDihedralType(DihedralType::Improper, int32_t(values[0]),
+                             values[1], values[2]);
+        }
+      } else if (block == "TORSDIHEDRALTYPECODE") {
+        ff.ReserveDihedralTypes(DihedralType::Proper, count());
+        for (size_t i = 1; i < lines.size(); ++i) {
+          parse(lines[i], 4);
+          ff.NewDihedralType(DihedralType::Proper, int32_t(values[0]),
+                             values[1], values[2], int32_t(values[3]));
+        }
+      } else if (block == "SINGLEATOMLJPAIR") {
+        // Each atom type spans the same number of lines
+        size_t num_types = size_t(ToInt(lines.front(), file));
+        if (!num_types) continue;
+        size_t num_lines = (lines.size() - 1) / num_types;
+        ff.ReserveAtomTypes(num_types);
+        Tokens data;
+        for (size_t i = 0; i < num_types; ++i) {
+          data.clear();
+          for (size_t j = 0; j < num_lines; ++j) {
+            utils::Split(lines[1 + j + i * num_lines], tokens);
+            data.insert(data.end(), tokens.begin(), tokens.end());
+          }
+          Need(data, 8, file);
+          std::string name(data[1]);
+          ff.NewAtomType(int32_t(ToInt(data[0], file)), name,
+                         pt[name.substr(0, 1)]);
+        }
+      }
+    }
+    return ff;
+  }
+
+} // namespace indigox::io
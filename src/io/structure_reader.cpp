@@ -0,0 +1,432 @@
+#include <indigox/classes/atom.hpp>
+#include <indigox/classes/bond.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/classes/periodictable.hpp>
+#include <indigox/io/structure_reader.hpp>
+#include <indigox/utils/line_reader.hpp>
+#include <indigox/utils/mapped_file.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <future>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifndef INDIGOX_DISABLE_SANITY_CHECKS
+#define _sanity_check_(x)                                                      \
+  if (!x)                                                                      \
+  throw std::runtime_error(                                                    \
+      "Attempting to access data from invalid structure reader")
+#else
+#define _sanity_check_(x)
+#endif
+
+namespace indigox::io {
+
+  using Format = StructureReader::Format;
+
+  namespace {
+    using Tokens = std::vector<std::string_view>;
+
+    // Lines of a record, with line endings removed
+    class RecordLines {
+    public:
+      explicit RecordLines(std::string_view record) : m_rest(record) {}
+
+      bool Next(std::string_view &line) {
+        if (m_rest.empty()) return false;
+        size_t end = m_rest.find('\n');
+        line = m_rest.substr(0, end);
+        m_rest.remove_prefix(end == m_rest.npos ? m_rest.size() : end + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return true;
+      }
+
+      std::string_view Expect() {
+        std::string_view line;
+        if (!Next(line)) throw std::runtime_error("Unexpected end of record");
+        return line;
+      }
+
+    private:
+      std::string_view m_rest;
+    };
+
+    int64_t ToInt(std::string_view s) {
+      int64_t value;
+      if (!utils::ParseInt(s, value))
+        throw std::runtime_error("Expected an integer: " + std::string(s));
+      return value;
+    }
+
+    double ToReal(std::string_view s) {
+      double value;
+      if (!utils::ParseReal(s, value))
+        throw std::runtime_error("Expected a number: " + std::string(s));
+      return value;
+    }
+
+    // Atoms and bonds of one record, created in bulk once it is parsed
+    struct Structure {
+      std::vector<int32_t> elements;
+      std::vector<double> coordinates;
+      std::vector<std::string> names;
+      std::vector<int32_t> tags;
+      std::vector<int32_t> formal_charges;
+      std::vector<double> partial_charges;
+      std::vector<uint32_t> bonds;
+      std::vector<Bond::Order> orders;
+
+      Molecule Build(std::string_view name) const {
+        Molecule mol{std::string(name)};
+        if (elements.empty()) return mol;
+        auto atoms =
+            mol.NewAtoms(elements.size(), elements.data(), coordinates.data());
+        for (size_t i = 0; i < atoms.size(); ++i) {
+          atoms[i].SetName(names[i]);
+          atoms[i].SetTag(tags[i]);
+          if (!formal_charges.empty())
+            atoms[i].SetFormalCharge(formal_charges[i]);
+          if (!partial_charges.empty())
+            atoms[i].SetPartialCharge(partial_charges[i]);
+        }
+        if (orders.empty()) return mol;
+        auto new_bonds = mol.NewBonds(orders.size(), bonds.data());
+        for (size_t i = 0; i < new_bonds.size(); ++i)
+          if (new_bonds[i]) new_bonds[i].SetOrder(orders[i]);
+        return mol;
+      }
+    };
+
+    // Atom position of a 1-based atom number
+    uint32_t AtomNumber(int64_t number, size_t num_atoms) {
+      if (number < 1 || size_t(number) > num_atoms)
+        throw std::runtime_error("Atom number out of range: " +
+                                 std::to_string(number));
+      return uint32_t(number - 1);
+    }
+
+    // V2000 charge codes of the atom block
+    int32_t ChargeCode(int64_t code) {
+      return (code > 0 && code < 8 && code != 4) ? int32_t(4 - code) : 0;
+    }
+
+    Molecule ParseSDF(std::string_view record) {
+      const PeriodicTable &pt = GetPeriodicTable();
+      RecordLines lines(record);
+      Tokens tokens;
+      std::string_view name = utils::Trim(lines.Expect());
+      lines.Expect();
+      lines.Expect();
+      std::string_view counts = lines.Expect();
+      if (utils::Columns(counts, 34, 39) == "V3000")
+        throw std::runtime_error("V3000 records are not supported");
+      int64_t num_atoms, num_bonds;
+      if (!utils::ParseInt(utils::Columns(counts, 0, 3), num_atoms) ||
+          !utils::ParseInt(utils::Columns(counts, 3, 6), num_bonds)) {
+        // Not column aligned
+        if (utils::Split(counts, tokens) < 2)
+          throw std::runtime_error("Bad counts line");
+        num_atoms = ToInt(tokens[0]);
+        num_bonds = ToInt(tokens[1]);
+      }
+      if (num_atoms < 0 || num_bonds < 0)
+        throw std::runtime_error("Bad counts line");
+
+      Structure s;
+      s.formal_charges.reserve(size_t(num_atoms));
+      for (int64_t i = 0; i < num_atoms; ++i) {
+        std::string_view line = lines.Expect();
+        double x, y, z;
+        std::string_view symbol = utils::Trim(utils::Columns(line, 31, 34));
+        int64_t code = 0;
+        if (utils::ParseReal(utils::Columns(line, 0, 10), x) &&
+            utils::ParseReal(utils::Columns(line, 10, 20), y) &&
+            utils::ParseReal(utils::Columns(line, 20, 30), z)) {
+          utils::ParseInt(utils::Columns(line, 36, 39), code);
+        } else {
+          if (utils::Split(line, tokens) < 4)
+            throw std::runtime_error("Bad atom line");
+          x = ToReal(tokens[0]);
+          y = ToReal(tokens[1]);
+          z = ToReal(tokens[2]);
+          symbol = tokens[3];
+          if (tokens.size() > 5) utils::ParseInt(tokens[5], code);
+        }
+        Element element = pt.GetElement(std::string(symbol));
+        s.elements.push_back(element.GetAtomicNumber());
+        s.coordinates.insert(s.coordinates.end(), {x / 10, y / 10, z / 10});
+        s.names.push_back(element.GetSymbol() + std::to_string(i + 1));
+        s.tags.push_back(int32_t(i + 1));
+        s.formal_charges.push_back(ChargeCode(code));
+      }
+
+      for (int64_t i = 0; i < num_bonds; ++i) {
+        std::string_view line = lines.Expect();
+        int64_t a, b, order;
+        if (!utils::ParseInt(utils::Columns(line, 0, 3), a) ||
+            !utils::ParseInt(utils::Columns(line, 3, 6), b) ||
+            !utils::ParseInt(utils::Columns(line, 6, 9), order)) {
+          if (utils::Split(line, tokens) < 3)
+            throw std::runtime_error("Bad bond line");
+          a = ToInt(tokens[0]);
+          b = ToInt(tokens[1]);
+          order = ToInt(tokens[2]);
+        }
+        s.bonds.push_back(AtomNumber(a, size_t(num_atoms)));
+        s.bonds.push_back(AtomNumber(b, size_t(num_atoms)));
+        switch (order) {
+        case 1: s.orders.push_back(Bond::Order::SINGLE); break;
+        case 2: s.orders.push_back(Bond::Order::DOUBLE); break;
+        case 3: s.orders.push_back(Bond::Order::TRIPLE); break;
+        case 4: s.orders.push_back(Bond::Order::AROMATIC); break;
+        default: s.orders.push_back(Bond::Order::UNDEFINED); break;
+        }
+      }
+
+      // Charge properties replace all charges of the atom block
+      bool charges_reset = false;
+      std::string_view line;
+      while (lines.Next(line) && line.substr(0, 6) != "M  END") {
+        if (line.substr(0, 6) != "M  CHG") continue;
+        if (!charges_reset)
+          std::fill(s.formal_charges.begin(), s.formal_charges.end(), 0);
+        charges_reset = true;
+        utils::Split(line.substr(6), tokens);
+        for (size_t i = 1; i + 1 < tokens.size(); i += 2)
+          s.formal_charges[AtomNumber(ToInt(tokens[i]), size_t(num_atoms))] =
+              int32_t(ToInt(tokens[i + 1]));
+      }
+      return s.Build(name);
+    }
+
+    Bond::Order MOL2Order(std::string_view type) {
+      if (type == "1" || type == "am") return Bond::Order::SINGLE;
+      if (type == "2") return Bond::Order::DOUBLE;
+      if (type == "3") return Bond::Order::TRIPLE;
+      if (type == "ar") return Bond::Order::AROMATIC;
+      return Bond::Order::UNDEFINED;
+    }
+
+    Molecule ParseMOL2(std::string_view record) {
+      const PeriodicTable &pt = GetPeriodicTable();
+      RecordLines lines(record);
+      Tokens tokens;
+      Structure s;
+      std::string_view name, section, line;
+      std::unordered_map<int64_t, uint32_t> atom_ids;
+      bool partial_charges = true;
+      while (lines.Next(line)) {
+        line = utils::Trim(line);
+        if (line.empty() || line[0] == '#') continue;
+        if (line.substr(0, 9) == "@<TRIPOS>") {
+          section = line.substr(9);
+          if (section == "MOLECULE") name = utils::Trim(lines.Expect());
+          continue;
+        }
+        if (section == "ATOM") {
+          if (utils::Split(line, tokens) < 6)
+            throw std::runtime_error("Bad atom line");
+          int64_t id = ToInt(tokens[0]);
+          if (!atom_ids.emplace(id, uint32_t(s.elements.size())).second)
+            throw std::runtime_error("Duplicate atom id " +
+                                     std::to_string(id));
+          std::string_view type = tokens[5];
+          std::string symbol(type.substr(0, type.find('.')));
+          s.elements.push_back(pt.GetElement(symbol).GetAtomicNumber());
+          s.coordinates.insert(s.coordinates.end(),
+                               {ToReal(tokens[2]) / 10, ToReal(tokens[3]) / 10,
+                                ToReal(tokens[4]) / 10});
+          s.names.emplace_back(tokens[1]);
+          s.tags.push_back(int32_t(id));
+          if (tokens.size() > 8)
+            s.partial_charges.push_back(ToReal(tokens[8]));
+          else
+            partial_charges = false;
+        } else if (section == "BOND") {
+          if (utils::Split(line, tokens) < 4)
+            throw std::runtime_error("Bad bond line");
+          for (size_t i = 1; i < 3; ++i) {
+            auto atom = atom_ids.find(ToInt(tokens[i]));
+            if (atom == atom_ids.end())
+              throw std::runtime_error("Unknown atom id " +
+                                       std::string(tokens[i]));
+            s.bonds.push_back(atom->second);
+          }
+          s.orders.push_back(MOL2Order(tokens[3]));
+        }
+      }
+      // Charges are only used if every atom has one
+      if (!partial_charges) s.partial_charges.clear();
+      return s.Build(name);
+    }
+
+    // Parsed record, or why it could not be parsed
+    struct Parsed {
+      Molecule mol;
+      std::string error;
+    };
+
+    std::vector<Parsed> ParseBatch(const std::vector<std::string_view> &records,
+                                   Format format, uint32_t num_threads,
+                                   uint64_t first_record) {
+      std::vector<Parsed> parsed(records.size());
+      auto parse = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          try {
+            parsed[i].mol = format == Format::SDF ? ParseSDF(records[i])
+                                                  : ParseMOL2(records[i]);
+          } catch (const std::exception &e) {
+            parsed[i].error = "Record " +
+                              std::to_string(first_record + i + 1) + ": " +
+                              e.what();
+          }
+        }
+      };
+      size_t chunk = (records.size() + num_threads - 1) / num_threads;
+      std::vector<std::future<void>> workers;
+      for (size_t begin = chunk; begin < records.size(); begin += chunk)
+        workers.push_back(std::async(std::launch::async, parse, begin,
+                                     std::min(begin + chunk, records.size())));
+      parse(0, std::min(chunk, records.size()));
+      for (auto &worker : workers) worker.get();
+      return parsed;
+    }
+  } // namespace
+
+  // ===========================================================================
+  // == StructureReader implementation =========================================
+  // ===========================================================================
+
+  struct StructureReader::Impl {
+    utils::MappedFile file;
+    Format format;
+    uint32_t num_threads;
+    uint32_t batch_size;
+    std::string_view rest;
+    uint64_t num_scanned = 0;
+    uint64_t num_read = 0;
+
+    std::vector<Parsed> current;
+    size_t position = 0;
+    std::future<std::vector<Parsed>> pending;
+
+    Impl(const std::string &path, Format f, uint32_t threads, uint32_t batch)
+        : file(path), format(f), num_threads(threads), batch_size(batch) {
+      if (!num_threads) num_threads = std::thread::hardware_concurrency();
+      if (!num_threads) num_threads = 1;
+      if (!batch_size) batch_size = 1;
+      rest = std::string_view(file.GetData(), file.GetSize());
+      // Initialised before any worker can need it
+      GetPeriodicTable();
+      Launch();
+    }
+
+    static std::string_view NextLine(std::string_view &text) {
+      size_t end = text.find('\n');
+      std::string_view line = text.substr(0, end);
+      text.remove_prefix(end == text.npos ? text.size() : end + 1);
+      return utils::Trim(line);
+    }
+
+    static bool IsMOL2Start(std::string_view line) {
+      return line.substr(0, 17) == "@<TRIPOS>MOLECULE";
+    }
+
+    // Split off the next record, or return an empty view at the end
+    std::string_view ScanRecord() {
+      std::string_view text = rest;
+      if (format == Format::SDF) {
+        // Records end with a $$$$ line
+        while (!text.empty() && NextLine(text) != "$$$$") {}
+      } else {
+        // Records run from one MOLECULE section to the next
+        bool found = false;
+        while (!text.empty() && !found) {
+          rest = text;
+          found = IsMOL2Start(NextLine(text));
+        }
+        if (!found) rest = text;
+        while (!text.empty()) {
+          std::string_view before = text;
+          if (!IsMOL2Start(NextLine(text))) continue;
+          text = before;
+          break;
+        }
+      }
+      std::string_view record = rest.substr(0, rest.size() - text.size());
+      rest = text;
+      // Trailing whitespace after the last record is not a record
+      return utils::Trim(record).empty() ? std::string_view() : record;
+    }
+
+    // Find the next batch of records and start parsing them
+    void Launch() {
+      std::vector<std::string_view> records;
+      size_t count = size_t(num_threads) * batch_size;
+      while (records.size() < count && !rest.empty()) {
+        std::string_view record = ScanRecord();
+        if (!record.empty()) records.push_back(record);
+      }
+      if (records.empty()) return;
+      uint64_t first = num_scanned;
+      num_scanned += records.size();
+      pending = std::async(std::launch::async,
+                           [records = std::move(records), first,
+                            f = format, n = num_threads]() {
+                             return ParseBatch(records, f, n, first);
+                           });
+    }
+  };
+
+  StructureReader::StructureReader(const std::string &path,
+                                   uint32_t num_threads, uint32_t batch_size) {
+    std::string ext = path.substr(std::min(path.find_last_of('.'),
+                                           path.size()));
+    for (char &c : ext) c = char(std::tolower(c));
+    Format format;
+    if (ext == ".sdf" || ext == ".sd" || ext == ".mol")
+      format = Format::SDF;
+    else if (ext == ".mol2")
+      format = Format::MOL2;
+    else
+      throw std::runtime_error("Unknown structure file extension: " + path);
+    m_data = std::make_shared<Impl>(path, format, num_threads, batch_size);
+  }
+
+  StructureReader::StructureReader(const std::string &path, Format format,
+                                   uint32_t num_threads, uint32_t batch_size)
+      : m_data(std::make_shared<Impl>(path, format, num_threads, batch_size)) {
+  }
+
+  bool StructureReader::Next(Molecule &mol) {
+    _sanity_check_(m_data);
+    Impl &impl = *m_data;
+    if (impl.position == impl.current.size()) {
+      if (!impl.pending.valid()) return false;
+      impl.current = impl.pending.get();
+      impl.position = 0;
+      // Parse the following batch while this one is consumed
+      impl.Launch();
+    }
+    Parsed &parsed = impl.current[impl.position++];
+    if (!parsed.error.empty()) throw std::runtime_error(parsed.error);
+    mol = std::move(parsed.mol);
+    ++impl.num_read;
+    return true;
+  }
+
+  uint64_t StructureReader::NumRead() const {
+    _sanity_check_(m_data);
+    return m_data->num_read;
+  }
+
+  Format StructureReader::GetFormat() const {
+    _sanity_check_(m_data);
+    return m_data->format;
+  }
+
+} // namespace indigox::io
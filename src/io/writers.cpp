@@ -0,0 +1,443 @@
+#include <indigox/classes/angle.hpp>
+#include <indigox/classes/atom.hpp>
+#include <indigox/classes/bond.hpp>
+#include <indigox/classes/dihedral.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/classes/parameterised.hpp>
+#include <indigox/classes/periodictable.hpp>
+#include <indigox/io/writers.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace indigox::io {
+
+  namespace {
+    // Correction from GROMOS improper units to GROMACS improper units
+    const double improper_correction = 1. / (0.0174532925 * 0.0174532925);
+
+    // Fixed or scientific notation with the given precision, matching
+    // Python's f and e formats
+    std::string Format(double value, std::chars_format fmt, int precision) {
+      if (std::isnan(value)) return "nan";
+      if (std::isinf(value)) return value < 0 ? "-inf" : "inf";
+      // Enough for any double in fixed notation
+      char buffer[400];
+      auto result =
+          std::to_chars(buffer, buffer + sizeof(buffer), value, fmt, precision);
+      if (result.ec != std::errc())
+        throw std::runtime_error("Unable to format number");
+      return std::string(buffer, size_t(result.ptr - buffer));
+    }
+
+    std::string Fixed(double value, int precision) {
+      return Format(value, std::chars_format::fixed, precision);
+    }
+
+    // Value rounded to five decimal places, as Python's round
+    double Round5(double value) {
+      std::string rounded = Fixed(value, 5);
+      std::from_chars(rounded.data(), rounded.data() + rounded.size(), value);
+      return value;
+    }
+
+    /*! Output collected in a large buffer and written to the file in blocks,
+     *  with Python style right aligned fields. */
+    class Output {
+      static const size_t block_size = 1 << 20;
+
+    public:
+      explicit Output(const std::string &path)
+          : m_path(path), m_file(path, std::ios::binary) {
+        if (!m_file) throw std::runtime_error("Unable to open file: " + path);
+        m_buffer.reserve(block_size + 4096);
+      }
+
+      Output &Str(std::string_view s, size_t width = 0) {
+        if (s.size() < width) m_buffer.append(width - s.size(), ' ');
+        m_buffer.append(s);
+        return *this;
+      }
+
+      Output &Int(int64_t value, size_t width = 0) {
+        char buffer[24];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return Str(std::string_view(buffer, size_t(result.ptr - buffer)),
+                   width);
+      }
+
+      Output &Fixed(double value, int precision, size_t width = 0) {
+        return Str(Format(value, std::chars_format::fixed, precision), width);
+      }
+
+      Output &Sci(double value, int precision, size_t width = 0) {
+        return Str(Format(value, std::chars_format::scientific, precision),
+                   width);
+      }
+
+      Output &Line() {
+        m_buffer.push_back('\n');
+        if (m_buffer.size() >= block_size) Flush();
+        return *this;
+      }
+
+      void Close() {
+        Flush();
+        m_file.close();
+        if (!m_file)
+          throw std::runtime_error("Unable to write file: " + m_path);
+      }
+
+    private:
+      void Flush() {
+        m_file.write(m_buffer.data(), std::streamsize(m_buffer.size()));
+        if (!m_file)
+          throw std::runtime_error("Unable to write file: " + m_path);
+        m_buffer.clear();
+      }
+
+    private:
+      std::string m_path;
+      std::ofstream m_file;
+      std::string m_buffer;
+    };
+
+    // Terms without types first, otherwise in their original order
+    template <class Container> Container UntypedFirst(const Container &terms) {
+      Container sorted(terms.begin(), terms.end());
+      std::stable_partition(sorted.begin(), sorted.end(),
+                            [](auto &term) { return !term.HasType(); });
+      return sorted;
+    }
+
+    // Comment on the spread of charges mapped to an atom
+    std::string ChargeInfo(const ParamMolecule &pmol, const Atom &atom,
+                           std::string_view separator) {
+      ParamAtom patom = pmol.GetAtom(atom);
+      std::string info = ";";
+      if (patom.GetMappedCharges().empty()) return info + " UNMAPPED";
+      double mu = patom.MeanCharge();
+      double eta = patom.MeadianCharge();
+      double sigma = patom.StandardDeviationCharge();
+      double delta = patom.RedistributedChargeAdded();
+      std::vector<std::string> parts;
+      if (Round5(mu) != Round5(eta) || Round5(sigma) != 0.0) {
+        parts.push_back("mean: " + Fixed(mu, 5));
+        parts.push_back("median: " + Fixed(eta, 5));
+        parts.push_back("stdev: " + Fixed(sigma, 5));
+      }
+      if (Round5(delta) != 0.0) parts.push_back("added: " + Fixed(delta, 5));
+      info += " ";
+      for (size_t i = 0; i < parts.size(); ++i) {
+        if (i) info += separator;
+        info += parts[i];
+      }
+      return info;
+    }
+
+    // Comment listing the other types mapped to a term
+    template <class Counts>
+    std::string OtherTerms(const Counts &counts, std::string_view prefix,
+                           int32_t id) {
+      std::string other;
+      for (auto &type_count : counts) {
+        if (type_count.first.GetID() == id) continue;
+        if (!other.empty()) other += ", ";
+        other += std::string(prefix) + std::to_string(type_count.first.GetID());
+      }
+      return other.empty() ? other : "; Other terms: " + other;
+    }
+
+    // If each consecutive pair of atoms of a dihedral is bonded
+    bool IsBonded(Molecule &mol, const Dihedral &dhd) {
+      auto &atoms = dhd.GetAtoms();
+      return mol.HasBond(atoms[0], atoms[1]) &&
+             mol.HasBond(atoms[1], atoms[2]) && mol.HasBond(atoms[2], atoms[3]);
+    }
+
+    // Dihedrals to write. For each bond, its parameterised dihedrals, or
+    // one unparameterised dihedral about it if there are none. Then any
+    // parameterised dihedrals not about a bond.
+    std::vector<Dihedral> DihedralsToWrite(Molecule &mol) {
+      std::vector<Dihedral> dihedrals;
+      std::set<Dihedral> done;
+      for (const Bond &bond : mol.GetBonds()) {
+        auto &atoms = bond.GetAtoms();
+        std::vector<Dihedral> about;
+        for (const Dihedral &dhd : atoms[0].GetDihedrals()) {
+          auto &dhd_atoms = dhd.GetAtoms();
+          if ((dhd_atoms[1] == atoms[0] && dhd_atoms[2] == atoms[1]) ||
+              (dhd_atoms[2] == atoms[0] && dhd_atoms[1] == atoms[1]))
+            about.push_back(dhd);
+        }
+        if (about.empty()) continue;
+        size_t num_typed = 0;
+        for (const Dihedral &dhd : about) {
+          if (!dhd.HasType()) continue;
+          dihedrals.push_back(dhd);
+          done.insert(dhd);
+          ++num_typed;
+        }
+        if (!num_typed) {
+          dihedrals.push_back(about.front());
+          done.insert(about.front());
+        }
+      }
+      for (const Dihedral &dhd : mol.GetDihedrals()) {
+        if (dhd.HasType() && done.insert(dhd).second) dihedrals.push_back(dhd);
+      }
+      return UntypedFirst(dihedrals);
+    }
+  } // namespace
+
+  // ===========================================================================
+  // == Structure writers ======================================================
+  // ===========================================================================
+
+  void WritePDBFile(const std::string &path, Molecule &mol) {
+    Output out(path);
+    out.Str("TITLE  Structure for molecule ").Str(mol.GetName()).Line();
+    for (Atom atom : mol.GetAtoms()) {
+      std::string symbol = atom.GetElement().GetSymbol();
+      for (char &c : symbol) c = char(std::toupper(c));
+      out.Str("HETATM").Int(atom.GetIndex() + 1, 5).Str(" ");
+      out.Str(atom.GetName(), 4).Str(" ");
+      out.Str(atom.GetResidueName(), 4).Str(" ");
+      out.Int(atom.GetResidueID(), 4).Str("    ");
+      out.Fixed(atom.GetX() * 10, 3, 8);
+      out.Fixed(atom.GetY() * 10, 3, 8);
+      out.Fixed(atom.GetZ() * 10, 3, 8);
+      out.Fixed(1.00, 2, 6).Fixed(0.00, 2, 6).Str("          ");
+      out.Str(symbol, 2).Line();
+    }
+
+    std::vector<std::vector<int64_t>> bonded(mol.GetAtoms().size());
+    for (const Bond &bond : mol.GetBonds()) {
+      auto &atoms = bond.GetAtoms();
+      bonded[atoms[0].GetIndex()].push_back(atoms[1].GetIndex() + 1);
+      bonded[atoms[1].GetIndex()].push_back(atoms[0].GetIndex() + 1);
+    }
+    for (size_t i = 0; i < bonded.size(); ++i) {
+      if (bonded[i].empty()) continue;
+      std::sort(bonded[i].begin(), bonded[i].end());
+      out.Str("CONECT").Int(int64_t(i) + 1, 5);
+      for (int64_t j : bonded[i]) out.Int(j, 5);
+      out.Line();
+    }
+    out.Close();
+  }
+
+  // ===========================================================================
+  // == Topology writers =======================================================
+  // ===========================================================================
+
+  void WriteITPFile(const std::string &path, Molecule &mol,
+                    const ParamMolecule &pmol) {
+    double h_mass = GetPeriodicTable()["H"].GetAtomicMass();
+    Output out(path);
+    out.Str("; File generated by the indigox package").Line();
+    out.Str("; No guarantees are provided for the usefulness of this file");
+    out.Line().Str("    ").Line();
+    out.Str("[ moleculetype ]").Line();
+    out.Str("; Name  nrexcl").Line();
+    out.Str("TEST   3").Line();
+    out.Str("    ").Line();
+    out.Str("[ atoms ]").Line();
+
+    for (Atom atom : mol.GetAtoms()) {
+      double mass = atom.GetElement().GetAtomicMass() +
+                    atom.GetImplicitCount() * h_mass;
+      out.Int(atom.GetIndex() + 1, 5).Str(" ");
+      out.Str(atom.HasType() ? atom.GetType().GetName() : "%%%", 6).Str(" ");
+      out.Int(atom.GetResidueID(), 5).Str(" ");
+      out.Str(atom.GetResidueName(), 8).Str(" ");
+      out.Str(atom.GetName(), 7).Str(" ");
+      out.Int(atom.GetChargeGroupID() + 1, 5).Str(" ");
+      out.Fixed(atom.GetPartialCharge(), 5, 11).Str(" ");
+      out.Fixed(mass, 4, 9).Str("  ");
+      if (pmol) out.Str(ChargeInfo(pmol, atom, ","));
+      out.Line();
+    }
+
+    out.Line().Str("[ bonds ]").Line();
+    for (const Bond &bond : UntypedFirst(mol.GetBonds())) {
+      auto &atoms = bond.GetAtoms();
+      out.Int(atoms[0].GetIndex() + 1, 5).Str(" ");
+      out.Int(atoms[1].GetIndex() + 1, 5).Str(" ");
+      out.Int(2, 5).Str("    gb_");
+      if (!bond.HasType()) {
+        out.Str("UNMAPPED   ").Line();
+        continue;
+      }
+      int32_t id = bond.GetType().GetID();
+      out.Int(id).Str("   ");
+      if (pmol)
+        out.Str(
+            OtherTerms(pmol.GetBond(bond).GetMappedTypeCounts(), "gb_", id));
+      out.Line();
+    }
+
+    out.Line().Str("[ pairs ]").Line();
+    for (const Dihedral &dhd : mol.GetDihedrals()) {
+      if (!IsBonded(mol, dhd)) continue;
+      auto &atoms = dhd.GetAtoms();
+      auto aromatic = [&](size_t i) {
+        return mol.GetBond(atoms[i], atoms[i + 1]).GetOrder() ==
+               Bond::Order::AROMATIC;
+      };
+      if (aromatic(0) && aromatic(1) && aromatic(2)) continue;
+      int64_t a = atoms[0].GetIndex() + 1, b = atoms[3].GetIndex() + 1;
+      if (a > b) std::swap(a, b);
+      out.Int(a, 5).Str(" ").Int(b, 5).Str("  1").Line();
+    }
+
+    out.Line().Str("[ angles ]").Line();
+    for (const Angle &angle : UntypedFirst(mol.GetAngles())) {
+      auto &atoms = angle.GetAtoms();
+      for (const Atom &atom : atoms) out.Int(atom.GetIndex() + 1, 5).Str(" ");
+      out.Int(2, 5).Str("    ga_");
+      if (!angle.HasType()) {
+        out.Str("UNMAPPED   ").Line();
+        continue;
+      }
+      int32_t id = angle.GetType().GetID();
+      out.Int(id).Str("   ");
+      if (pmol)
+        out.Str(
+            OtherTerms(pmol.GetAngle(angle).GetMappedTypeCounts(), "ga_", id));
+      out.Line();
+    }
+
+    out.Line().Str("[ dihedrals ]").Line();
+    for (const Dihedral &dhd : DihedralsToWrite(mol)) {
+      auto &atoms = dhd.GetAtoms();
+      if (!dhd.HasType()) {
+        for (const Atom &atom : atoms) out.Int(atom.GetIndex() + 1, 5).Str(" ");
+        out.Str("", 5).Str("    UNMAPPED    ").Line();
+        continue;
+      }
+      for (const FFDihedral &type : dhd.GetTypes()) {
+        bool proper = type.GetType() == DihedralType::Proper;
+        for (const Atom &atom : atoms) out.Int(atom.GetIndex() + 1, 5).Str(" ");
+        out.Int(proper ? 1 : 2, 5).Str(proper ? "    gd_" : "    gi_");
+        out.Int(type.GetID()).Str("    ").Line();
+      }
+    }
+    out.Close();
+  }
+
+  void WriteRTPFile(const std::string &path, Molecule &mol,
+                    const ParamMolecule &pmol) {
+    if (mol.GetAtoms().empty())
+      throw std::out_of_range("Cannot write a molecule without atoms");
+    Output out(path);
+    out.Str("; File generated by the indigox package").Line();
+    out.Str("; No guarantees are provided for the usefulness of this file");
+    out.Line().Line();
+    Atom first = mol.GetAtoms().front();
+    out.Str("[ ").Str(first.GetResidueName()).Str(" ]");
+    out.Line().Str("  [ atoms ]").Line();
+
+    for (Atom atom : mol.GetAtoms()) {
+      out.Str(atom.GetName(), 5).Str(" ");
+      out.Str(atom.HasType() ? atom.GetType().GetName() : "%%%", 6).Str(" ");
+      out.Fixed(atom.GetPartialCharge(), 5, 11).Str(" ");
+      out.Int(atom.GetChargeGroupID() + 1, 5).Str(" ");
+      if (pmol) out.Str(ChargeInfo(pmol, atom, ", "));
+      out.Line();
+    }
+
+    out.Str("  [ bonds ]").Line();
+    for (const Bond &bond : UntypedFirst(mol.GetBonds())) {
+      auto &atoms = bond.GetAtoms();
+      out.Str(atoms[0].GetName(), 5).Str(" ");
+      out.Str(atoms[1].GetName(), 5).Str("   ");
+      if (!bond.HasType()) {
+        out.Str("UNMAPPED   ").Line();
+        continue;
+      }
+      FFBond type = bond.GetType();
+      if (type.GetType() != BondType::Quartic) type = type.GetLinkedType();
+      out.Fixed(type.GetIdealLength(), 4).Str("  ");
+      out.Sci(type.GetForceConstant(), 4).Str("   ");
+      if (pmol)
+        out.Str(OtherTerms(pmol.GetBond(bond).GetMappedTypeCounts(), "gb_",
+                           bond.GetType().GetID()));
+      out.Line();
+    }
+
+    out.Str("  [ exclusions ]").Line();
+    for (const Dihedral &dhd : mol.GetDihedrals()) {
+      if (!IsBonded(mol, dhd)) continue;
+      auto &atoms = dhd.GetAtoms();
+      if (mol.GetBond(atoms[1], atoms[2]).GetOrder() != Bond::Order::AROMATIC)
+        continue;
+      out.Str(atoms[3].GetName(), 5).Str(" ").Str(atoms[0].GetName(), 5);
+      out.Line();
+    }
+
+    out.Str("  [ angles ]").Line();
+    for (const Angle &angle : UntypedFirst(mol.GetAngles())) {
+      auto &atoms = angle.GetAtoms();
+      out.Str(atoms[0].GetName(), 5).Str(" ");
+      out.Str(atoms[1].GetName(), 5).Str(" ");
+      out.Str(atoms[2].GetName(), 5).Str("  ");
+      if (!angle.HasType()) {
+        out.Str("UNMAPPED   ").Line();
+        continue;
+      }
+      FFAngle type = angle.GetType();
+      if (type.GetType() != AngleType::CosineHarmonic)
+        type = type.GetLinkedType();
+      out.Fixed(type.GetIdealAngle(), 2).Str("  ");
+      out.Fixed(type.GetForceConstant(), 2).Str("   ");
+      if (pmol)
+        out.Str(OtherTerms(pmol.GetAngle(angle).GetMappedTypeCounts(), "ga_",
+                           angle.GetType().GetID()));
+      out.Line();
+    }
+
+    auto names = [&out](const Dihedral &dhd) -> Output & {
+      auto &atoms = dhd.GetAtoms();
+      out.Str(atoms[0].GetName(), 5).Str(" ");
+      out.Str(atoms[1].GetName(), 5).Str(" ");
+      out.Str(atoms[2].GetName(), 5).Str(" ");
+      return out.Str(atoms[3].GetName(), 5).Str("  ");
+    };
+
+    out.Str("  [ impropers ]").Line();
+    for (const Dihedral &dhd : mol.GetDihedrals()) {
+      if (!dhd.HasType()) continue;
+      for (const FFDihedral &type : dhd.GetTypes()) {
+        if (type.GetType() != DihedralType::Improper) continue;
+        names(dhd).Fixed(type.GetIdealAngle(), 5).Str("   ");
+        out.Fixed(type.GetForceConstant() * improper_correction, 5);
+        out.Str("  ").Line();
+      }
+    }
+
+    out.Str("  [ dihedrals ]").Line();
+    for (const Dihedral &dhd : DihedralsToWrite(mol)) {
+      if (!dhd.HasType()) {
+        names(dhd).Str("UNMAPPED  ").Line();
+        continue;
+      }
+      for (const FFDihedral &type : dhd.GetTypes()) {
+        if (type.GetType() != DihedralType::Proper) continue;
+        names(dhd).Fixed(type.GetPhaseShift(), 4).Str("  ");
+        out.Fixed(type.GetForceConstant(), 4).Str("  ");
+        out.Int(type.GetMultiplicity()).Str("  ").Line();
+      }
+    }
+    out.Close();
+  }
+
+} // namespace indigox::io
@@ -3,7 +3,9 @@
 #include <indigox/classes/molecule.hpp>
 #include <indigox/graph/condensed.hpp>
 #include <indigox/graph/molecular.hpp>
+#include <indigox/io/athenaeum_snapshot.hpp>
 #include <indigox/python/interface.hpp>
+#include <indigox/python/pickle.hpp>
 
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
@@ -68,6 +70,7 @@ void GeneratePyAthenaeum(py::module &m) {
   athenaeum.def(py::init<const Forcefield &>())
       .def(py::init<const Forcefield &, int32_t>())
       .def(py::init<const Forcefield &, int32_t, int32_t>())
+      .def(PickleSupport<Athenaeum>())
       .def("GetBool", &Athenaeum::GetBool)
       .def("SetBool", &Athenaeum::SetBool)
       .def("UnsetBool", &Athenaeum::UnsetBool)
@@ -87,7 +90,13 @@ void GeneratePyAthenaeum(py::module &m) {
       .def("HasFragments", &Athenaeum::HasFragments)
       .def("GetForcefield", &Athenaeum::GetForcefield)
       .def("AddFragment", &Athenaeum::AddFragment)
-      .def("AddAllFragments", &Athenaeum::AddAllFragments)
+      .def("AddAllFragments",
+           py::overload_cast<const Molecule &>(&Athenaeum::AddAllFragments),
+           ReleaseGIL())
+      .def("AddAllFragments",
+           py::overload_cast<const std::vector<Molecule> &, uint32_t>(
+               &Athenaeum::AddAllFragments),
+           py::arg("mols"), py::arg("num_threads") = 0, ReleaseGIL())
       .def(py::self == py::self)
       .def(py::self != py::self)
       .def(py::self < py::self)
@@ -96,11 +105,34 @@ void GeneratePyAthenaeum(py::module &m) {
       .def(py::self >= py::self)
       .def("__bool__", &Athenaeum::operator bool);
 
+  // ===========================================================================
+  // == AthenaeumSnapshot class bindings =======================================
+  // ===========================================================================
+  using Snapshot = io::AthenaeumSnapshot;
+  py::class_<Snapshot>(m, "AthenaeumSnapshot")
+      .def(py::init<const std::string &>(), py::arg("path"), ReleaseGIL())
+      .def("NumMolecules", &Snapshot::NumMolecules)
+      .def("NumFragments",
+           py::overload_cast<>(&Snapshot::NumFragments, py::const_))
+      .def("NumFragments",
+           py::overload_cast<size_t>(&Snapshot::NumFragments, py::const_))
+      .def("GetFragments", &Snapshot::GetFragments, Ref, ReleaseGIL())
+      .def("NumLoaded", &Snapshot::NumLoaded)
+      .def("GetForcefield", &Snapshot::GetForcefield)
+      .def("GetBool", &Snapshot::GetBool)
+      .def("GetInt", &Snapshot::GetInt)
+      .def("GetPath", &Snapshot::GetPath)
+      .def(py::self == py::self)
+      .def(py::self != py::self)
+      .def("__bool__", &Snapshot::operator bool);
+
   // ===========================================================================
   // == Module level function bindings =========================================
   // ===========================================================================
-  m.def("SaveAthenaeum", &SaveAthenaeum);
-  m.def("LoadAthenaeum", &LoadAthenaeum);
+  m.def("SaveAthenaeum", &SaveAthenaeum, ReleaseGIL());
+  m.def("LoadAthenaeum", &LoadAthenaeum, ReleaseGIL());
+  m.def("SaveAthenaeumSnapshot", &io::SaveAthenaeumSnapshot, ReleaseGIL());
+  m.def("IsAthenaeumSnapshot", &io::IsAthenaeumSnapshot);
 
   // Container bindings
   py::bind_vector<std::vector<Fragment>>(m, "VecFragment");
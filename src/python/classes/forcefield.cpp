@@ -180,6 +180,11 @@ void GeneratePyForcefield(py::module &m) {
                                    &Forcefield::NumDihedralTypes, py::const_))
       .def("GetFamily", &Forcefield::GetFamily)
       .def("GetName", &Forcefield::GetName)
+      .def("GetHash", &Forcefield::GetHash)
+      .def("IsShared", &Forcefield::IsShared)
+      .def("Share", &Forcefield::Share)
+      .def("Save", &Forcefield::Save)
+      .def_static("Open", &Forcefield::Open)
       .def("__bool__", &Forcefield::operator bool)
       .def(py::self == py::self)
       .def(py::self != py::self)
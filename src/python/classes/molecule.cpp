@@ -1,6 +1,8 @@
 #include <indigox/classes/angle.hpp>
 #include <indigox/classes/atom.hpp>
 #include <indigox/classes/bond.hpp>
+#include <indigox/classes/columnar.hpp>
+#include <indigox/classes/conformers.hpp>
 #include <indigox/classes/dihedral.hpp>
 #include <indigox/classes/forcefield.hpp>
 #include <indigox/classes/molecule.hpp>
@@ -8,9 +10,11 @@
 #include <indigox/graph/condensed.hpp>
 #include <indigox/graph/molecular.hpp>
 #include <indigox/python/interface.hpp>
+#include <indigox/python/pickle.hpp>
 
 #include <indigo-bondorder/indigo-bondorder.hpp>
 
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 
@@ -125,7 +129,155 @@ namespace special {
     
     return mol;
   }
-}
+
+  using IntArray =
+      py::array_t<int32_t, py::array::c_style | py::array::forcecast>;
+  using IndexArray =
+      py::array_t<uint32_t, py::array::c_style | py::array::forcecast>;
+  using RealArray =
+      py::array_t<double, py::array::c_style | py::array::forcecast>;
+  using TagArray =
+      py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+
+  // Arrays of the right type and layout are used in place, without copying
+  indigox::Molecule::MoleculeAtoms NewAtoms(indigox::Molecule &mol,
+                                            IntArray elements,
+                                            py::object coordinates,
+                                            py::object names, py::object tags) {
+    if (elements.ndim() != 1)
+      throw std::runtime_error("Elements must be a one dimensional array");
+    size_t count = elements.shape(0);
+    const double *xyz = nullptr;
+    RealArray coords;
+    if (!coordinates.is_none()) {
+      coords = coordinates.cast<RealArray>();
+      if (size_t(coords.size()) != 3 * count)
+        throw std::runtime_error("Coordinates must have shape (n, 3)");
+      xyz = coords.data();
+    }
+    std::vector<py::str> atom_names;
+    if (!names.is_none()) {
+      for (py::handle n : names) atom_names.emplace_back(py::str(n));
+      if (atom_names.size() != count)
+        throw std::runtime_error("Names must have one entry per atom");
+    }
+    TagArray atom_tags;
+    if (!tags.is_none()) {
+      atom_tags = tags.cast<TagArray>();
+      if (size_t(atom_tags.size()) != count)
+        throw std::runtime_error("Tags must have one entry per atom");
+    }
+
+    auto atoms = mol.NewAtoms(count, elements.data(), xyz);
+    for (size_t i = 0; i < atom_names.size(); ++i)
+      atoms[i].SetName(atom_names[i]);
+    for (size_t i = 0; i < size_t(atom_tags.size()); ++i)
+      atoms[i].SetTag(atom_tags.data()[i]);
+    return atoms;
+  }
+
+  indigox::Molecule::MoleculeBonds NewBonds(indigox::Molecule &mol,
+                                            IndexArray index_pairs) {
+    if (index_pairs.size() % 2)
+      throw std::runtime_error("Index pairs must have shape (n, 2)");
+    return mol.NewBonds(index_pairs.size() / 2, index_pairs.data());
+  }
+
+  // Array base holding the owner of the memory an array views, so the
+  // memory outlives any reallocation by the object it belongs to
+  py::capsule StorageBase(std::shared_ptr<const void> storage) {
+    return py::capsule(new std::shared_ptr<const void>(std::move(storage)),
+                       [](void *owner) {
+                         delete static_cast<std::shared_ptr<const void> *>(
+                             owner);
+                       });
+  }
+
+  // View of coordinates as an (n, 3) array. Each axis is stored contiguously,
+  // so rows are strided by the capacity of the coordinate storage. Adding
+  // atoms may reallocate the storage, after which an existing view remains
+  // valid but no longer reflects the molecule.
+  py::array CoordinateView(indigox::AtomicCoordinates &coords) {
+    if (!coords.data) return RealArray({size_t(0), size_t(3)});
+    return py::array(py::dtype::of<double>(),
+                     {size_t(coords.size), size_t(3)},
+                     {sizeof(double), coords.max_size * sizeof(double)},
+                     coords.data, StorageBase(coords.Storage()));
+  }
+
+  // Columns may be reallocated by adding atoms or bonds, so are copied
+  template <class T>
+  py::array_t<T> ColumnCopy(const std::vector<T> &column) {
+    return py::array_t<T>(column.size(), column.data());
+  }
+
+  py::array MoleculeCoordinates(indigox::Molecule &mol) {
+    return CoordinateView(mol.GetAtomicCoordinates());
+  }
+
+  // Read only (n, 3) view of a frame of a conformer set. Remains valid, with
+  // the frame as it was, after more frames are added.
+  py::array FrameView(const indigox::ConformerSet &set, uint32_t index) {
+    indigox::CoordinateFrame frame = set.GetFrame(index);
+    if (!frame.size) return RealArray({size_t(0), size_t(3)});
+    py::array view(py::dtype::of<double>(), {size_t(frame.size), size_t(3)},
+                   {sizeof(double), set.GetStride() * sizeof(double)},
+                   frame.x, StorageBase(set.GetFrameStorage()));
+    view.attr("flags").attr("writeable") = false;
+    return view;
+  }
+
+  // Copy an (n, 3) array into a frame
+  template <class Func>
+  auto WithArrayFrame(RealArray coords, Func func) {
+    if (coords.ndim() != 2 || coords.shape(1) != 3)
+      throw std::runtime_error("Coordinates must have shape (n, 3)");
+    size_t n = coords.shape(0);
+    std::vector<double> axes(3 * n);
+    for (size_t i = 0; i < n; ++i)
+      for (size_t d = 0; d < 3; ++d)
+        axes[d * n + i] = coords.data()[3 * i + d];
+    return func(indigox::CoordinateFrame{axes.data(), axes.data() + n,
+                                         axes.data() + 2 * n, uint32_t(n)});
+  }
+
+  // Per atom data is held on each atom so is gathered into a new array
+  template <class T, class Func>
+  py::array_t<T> GatherAtoms(const indigox::Molecule &mol, Func get) {
+    const auto &atoms = mol.GetAtoms();
+    py::array_t<T> out(atoms.size());
+    T *dat = out.mutable_data();
+    for (size_t i = 0; i < atoms.size(); ++i) dat[i] = get(atoms[i]);
+    return out;
+  }
+
+  py::array_t<double> PartialCharges(const indigox::Molecule &mol) {
+    return GatherAtoms<double>(
+        mol, [](const indigox::Atom &a) { return a.GetPartialCharge(); });
+  }
+
+  py::array_t<int32_t> FormalCharges(const indigox::Molecule &mol) {
+    return GatherAtoms<int32_t>(
+        mol, [](const indigox::Atom &a) { return a.GetFormalCharge(); });
+  }
+
+  py::array_t<int32_t> AtomTypeIDs(const indigox::Molecule &mol) {
+    return GatherAtoms<int32_t>(mol, [](const indigox::Atom &a) {
+      return a.HasType() ? a.GetType().GetID() : -1;
+    });
+  }
+
+  void SetPartialCharges(indigox::Molecule &mol, RealArray charges) {
+    const auto &atoms = mol.GetAtoms();
+    if (size_t(charges.size()) != atoms.size())
+      throw std::runtime_error("Charges must have one entry per atom");
+    const double *q = charges.data();
+    for (size_t i = 0; i < atoms.size(); ++i) {
+      indigox::Atom atm = atoms[i];
+      atm.SetPartialCharge(q[i]);
+    }
+  }
+} // namespace special
 
 void GeneratePyMolecule(pybind11::module &m) {
   using namespace indigox;
@@ -335,6 +487,7 @@ void GeneratePyMolecule(pybind11::module &m) {
   // ===========================================================================
   py::class_<Molecule>(m, "Molecule")
       .def(py::init<std::string>())
+      .def(PickleSupport<Molecule>())
       .def("HasAtom", &Molecule::HasAtom)
       .def("HasBond",
            py::overload_cast<const Bond &>(&Molecule::HasBond, py::const_))
@@ -389,6 +542,10 @@ void GeneratePyMolecule(pybind11::module &m) {
            py::overload_cast<const Element &, double, double, double>(
                &Molecule::NewAtom))
       .def("NewBond", &Molecule::NewBond)
+      .def("NewAtoms", &special::NewAtoms, py::arg("elements"),
+           py::arg("coordinates") = py::none(), py::arg("names") = py::none(),
+           py::arg("tags") = py::none())
+      .def("NewBonds", &special::NewBonds, py::arg("index_pairs"))
       .def("NewDihedral",
            py::overload_cast<const Atom &, const Atom &, const Atom &,
                              const Atom &>(&Molecule::NewDihedral))
@@ -396,9 +553,10 @@ void GeneratePyMolecule(pybind11::module &m) {
       .def("RemoveBond", py::overload_cast<const Bond &>(&Molecule::RemoveBond))
       .def("RemoveBond",
            py::overload_cast<const Atom &, const Atom &>(&Molecule::RemoveBond))
-      .def("PerceiveAngles", &Molecule::PerceiveAngles)
-      .def("PerceiveDihedrals", &Molecule::PerceiveDihedrals)
-      .def("PerceiveElectrons", &Molecule::PerceiveElectrons)
+      .def("PerceiveAngles", py::overload_cast<>(&Molecule::PerceiveAngles))
+      .def("PerceiveDihedrals",
+           py::overload_cast<>(&Molecule::PerceiveDihedrals))
+      .def("PerceiveElectrons", &Molecule::PerceiveElectrons, ReleaseGIL())
       .def("PerceiveResidues", &Molecule::PerceiveResidues)
       .def("OptimiseChargeGroups", &Molecule::OptimiseChargeGroups)
       .def("ReorderAtoms", &Molecule::ReorderAtoms)
@@ -413,16 +571,188 @@ void GeneratePyMolecule(pybind11::module &m) {
       .def("GetResidueID", &Molecule::GetResidueID, Ref)
       .def("GetResidues", &Molecule::GetResidues, Ref)
       .def("GetForcefield", &Molecule::GetForcefield)
+      .def("GetCoordinatesArray", &special::MoleculeCoordinates)
+      .def("GetPartialChargesArray", &special::PartialCharges)
+      .def("GetFormalChargesArray", &special::FormalCharges)
+      .def("GetAtomTypeIDsArray", &special::AtomTypeIDs)
+      .def("SetPartialCharges", &special::SetPartialCharges)
       .def("SetForcefield", &Molecule::SetForcefield)
       .def("ResetForcefield", &Molecule::ResetForcefield)
       .def("HasForcefield", &Molecule::HasForcefield)
-      .def("ModificationMade", &Molecule::ModificationMade);
+      .def("ModificationMade",
+           py::overload_cast<>(&Molecule::ModificationMade))
+      .def("ModificationMade",
+           py::overload_cast<const Atom &>(&Molecule::ModificationMade));
+
+  // ===========================================================================
+  // == Columnar molecule bindings =============================================
+  // ===========================================================================
+  // Handles refer to their molecule by raw pointer, so keep it alive
+  py::keep_alive<0, 1> KeepParent;
+
+  py::class_<ColumnarAtom>(m, "ColumnarAtom")
+      .def("GetIndex", &ColumnarAtom::GetIndex)
+      .def("NumBonds", &ColumnarAtom::NumBonds)
+      .def("HasType", &ColumnarAtom::HasType)
+      .def("GetElement", &ColumnarAtom::GetElement)
+      .def("GetFormalCharge", &ColumnarAtom::GetFormalCharge)
+      .def("GetPartialCharge", &ColumnarAtom::GetPartialCharge)
+      .def("GetResidueID", &ColumnarAtom::GetResidueID)
+      .def("GetResidueName", &ColumnarAtom::GetResidueName)
+      .def("GetChargeGroupID", &ColumnarAtom::GetChargeGroupID)
+      .def("GetName", &ColumnarAtom::GetName)
+      .def("GetX", &ColumnarAtom::GetX)
+      .def("GetY", &ColumnarAtom::GetY)
+      .def("GetZ", &ColumnarAtom::GetZ)
+      .def("GetPosition", &ColumnarAtom::GetPosition)
+      .def("GetType", &ColumnarAtom::GetType)
+      .def("GetNeighbours", &ColumnarAtom::GetNeighbours)
+      .def("GetBonds", &ColumnarAtom::GetBonds)
+      .def("SetElement", &ColumnarAtom::SetElement)
+      .def("SetFormalCharge", &ColumnarAtom::SetFormalCharge)
+      .def("SetPartialCharge", &ColumnarAtom::SetPartialCharge)
+      .def("SetResidueID", &ColumnarAtom::SetResidueID)
+      .def("SetResidueName", &ColumnarAtom::SetResidueName)
+      .def("SetChargeGroupID", &ColumnarAtom::SetChargeGroupID)
+      .def("SetName", &ColumnarAtom::SetName)
+      .def("SetPosition", &ColumnarAtom::SetPosition)
+      .def("SetType", &ColumnarAtom::SetType)
+      .def(py::self == py::self)
+      .def(py::self != py::self)
+      .def(py::self < py::self)
+      .def("__bool__", &ColumnarAtom::operator bool);
+
+  py::class_<ColumnarBond>(m, "ColumnarBond")
+      .def("GetIndex", &ColumnarBond::GetIndex)
+      .def("GetAtoms", &ColumnarBond::GetAtoms)
+      .def("GetOrder", &ColumnarBond::GetOrder)
+      .def("HasType", &ColumnarBond::HasType)
+      .def("GetType", &ColumnarBond::GetType)
+      .def("Length", &ColumnarBond::Length)
+      .def("SetOrder", &ColumnarBond::SetOrder)
+      .def("SetType", &ColumnarBond::SetType)
+      .def(py::self == py::self)
+      .def(py::self != py::self)
+      .def(py::self < py::self)
+      .def("__bool__", &ColumnarBond::operator bool);
+
+  py::class_<ColumnarMolecule>(m, "ColumnarMolecule")
+      .def(py::init<std::string>())
+      .def(py::init<const Molecule &>())
+      .def("ToMolecule", &ColumnarMolecule::ToMolecule)
+      .def("GetName", &ColumnarMolecule::GetName)
+      .def("SetName", &ColumnarMolecule::SetName)
+      .def("GetMolecularCharge", &ColumnarMolecule::GetMolecularCharge)
+      .def("SetMolecularCharge", &ColumnarMolecule::SetMolecularCharge)
+      .def("GetForcefield", &ColumnarMolecule::GetForcefield)
+      .def("SetForcefield", &ColumnarMolecule::SetForcefield)
+      .def("NumAtoms", &ColumnarMolecule::NumAtoms)
+      .def("NumBonds", &ColumnarMolecule::NumBonds)
+      .def("ReserveAtoms", &ColumnarMolecule::ReserveAtoms)
+      .def("ReserveBonds", &ColumnarMolecule::ReserveBonds)
+      .def("NewAtom", &ColumnarMolecule::NewAtom, KeepParent)
+      .def("NewBond", &ColumnarMolecule::NewBond, KeepParent)
+      .def("GetAtom", &ColumnarMolecule::GetAtom, KeepParent)
+      .def("GetBond",
+           py::overload_cast<uint32_t>(&ColumnarMolecule::GetBond, py::const_),
+           KeepParent)
+      .def("GetBond",
+           py::overload_cast<const ColumnarAtom &, const ColumnarAtom &>(
+               &ColumnarMolecule::GetBond, py::const_),
+           KeepParent)
+      .def("GetStringPool", &ColumnarMolecule::GetStringPool)
+      .def("GetAtomTypePool", &ColumnarMolecule::GetAtomTypePool)
+      .def("GetBondTypePool", &ColumnarMolecule::GetBondTypePool)
+      .def("MemoryUsage", &ColumnarMolecule::MemoryUsage)
+      .def("GetCoordinatesArray",
+           [](ColumnarMolecule &mol) {
+             return special::CoordinateView(mol.GetAtomicCoordinates());
+           })
+      .def("GetAtomicNumbersArray",
+           [](const ColumnarMolecule &mol) {
+             return special::ColumnCopy(mol.GetAtomicNumbers());
+           },
+           "Copy of the atomic numbers column.")
+      .def("GetFormalChargesArray",
+           [](const ColumnarMolecule &mol) {
+             return special::ColumnCopy(mol.GetFormalCharges());
+           },
+           "Copy of the formal charges column.")
+      .def("GetPartialChargesArray",
+           [](const ColumnarMolecule &mol) {
+             return special::ColumnCopy(mol.GetPartialCharges());
+           },
+           "Copy of the partial charges column.")
+      .def("GetResidueIDsArray",
+           [](const ColumnarMolecule &mol) {
+             return special::ColumnCopy(mol.GetResidueIDs());
+           },
+           "Copy of the residue IDs column.")
+      .def("GetChargeGroupIDsArray",
+           [](const ColumnarMolecule &mol) {
+             return special::ColumnCopy(mol.GetChargeGroupIDs());
+           },
+           "Copy of the charge group IDs column.")
+      .def("GetNameIndicesArray",
+           [](const ColumnarMolecule &mol) {
+             return special::ColumnCopy(mol.GetNameIndices());
+           },
+           "Copy of the string pool indices of the atom names.")
+      .def("GetAtomTypeIndicesArray",
+           [](const ColumnarMolecule &mol) {
+             return special::ColumnCopy(mol.GetAtomTypeIndices());
+           },
+           "Copy of the atom type pool indices of the atoms.")
+      .def("GetBondTypeIndicesArray",
+           [](const ColumnarMolecule &mol) {
+             return special::ColumnCopy(mol.GetBondTypeIndices());
+           },
+           "Copy of the bond type pool indices of the bonds.")
+      .def("GetBondAtomsArray",
+           [](const ColumnarMolecule &mol) {
+             const auto &bonds = mol.GetBondAtoms();
+             return py::array_t<uint32_t>(
+                 {bonds.size(), size_t(2)},
+                 reinterpret_cast<const uint32_t *>(bonds.data()));
+           },
+           "Copy of the atom indices of each bond, as an (n, 2) array.")
+      .def("__bool__", &ColumnarMolecule::operator bool);
+
+  py::class_<ConformerSet>(m, "ConformerSet")
+      .def(py::init<uint32_t>(), py::arg("num_atoms"))
+      .def_static("Open", &ConformerSet::Open, py::arg("path"), ReleaseGIL())
+      .def("Save", &ConformerSet::Save, py::arg("path"), ReleaseGIL())
+      .def("NumAtoms", &ConformerSet::NumAtoms)
+      .def("NumFrames", &ConformerSet::NumFrames)
+      .def("IsMapped", &ConformerSet::IsMapped)
+      .def("Reserve", &ConformerSet::Reserve)
+      .def("AddFrame",
+           py::overload_cast<Molecule &>(&ConformerSet::AddFrame))
+      .def("AddFrame",
+           [](ConformerSet &set, special::RealArray coords) {
+             return special::WithArrayFrame(
+                 coords, [&](const CoordinateFrame &frame) {
+                   return set.AddFrame(frame);
+                 });
+           })
+      .def("SetFrame",
+           [](ConformerSet &set, uint32_t index, special::RealArray coords) {
+             special::WithArrayFrame(coords,
+                                     [&](const CoordinateFrame &frame) {
+                                       set.SetFrame(index, frame);
+                                     });
+           })
+      .def("GetFrame", &special::FrameView)
+      .def("ApplyFrame", &ConformerSet::ApplyFrame)
+      .def("__len__", &ConformerSet::NumFrames)
+      .def("__bool__", &ConformerSet::operator bool);
 
   // ===========================================================================
   // == Module function bindings ===============================================
   // ===========================================================================
-  m.def("SaveMolecule", &SaveMolecule);
-  m.def("LoadMolecule", &LoadMolecule);
+  m.def("SaveMolecule",
+        py::overload_cast<const Molecule &, std::string>(&SaveMolecule));
+  m.def("LoadMolecule", py::overload_cast<std::string>(&LoadMolecule));
   m.def("ProtonatedLysine", &special::ProtonatedLysine);
   m.def("Methionine", &special::Methionine);
   
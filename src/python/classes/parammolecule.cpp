@@ -6,6 +6,9 @@
 #include <indigox/classes/molecule.hpp>
 #include <indigox/classes/parameterised.hpp>
 #include <indigox/python/interface.hpp>
+#include <indigox/python/pickle.hpp>
+
+#include <pybind11/numpy.h>
 
 namespace py = pybind11;
 
@@ -15,6 +18,113 @@ namespace py = pybind11;
 // PYBIND11_MAKE_OPAQUE(indigox::ParamDihedral::TypeGroup);
 // PYBIND11_MAKE_OPAQUE(indigox::ParamDihedral::TypeCounts);
 
+namespace {
+  using namespace indigox;
+
+  // Gather the results of a parameterisation into one array per quantity so
+  // they can be analysed with vectorised NumPy code.
+  template <class Term, class Func>
+  py::array_t<int64_t> TermAtoms(const std::vector<Term> &terms, size_t n,
+                                 Func get_atoms) {
+    py::array_t<int64_t> out({terms.size(), n});
+    int64_t *dat = out.mutable_data();
+    for (size_t i = 0; i < terms.size(); ++i) {
+      const auto &atms = get_atoms(terms[i]);
+      for (size_t j = 0; j < n; ++j) dat[i * n + j] = atms[j].GetIndex();
+    }
+    return out;
+  }
+
+  template <class T, class Term, class Func>
+  py::array_t<T> TermValues(const std::vector<Term> &terms, Func get) {
+    py::array_t<T> out(terms.size());
+    T *dat = out.mutable_data();
+    for (size_t i = 0; i < terms.size(); ++i) dat[i] = get(terms[i]);
+    return out;
+  }
+
+  // GetMostCommonType is only defined for terms with mapped types, so each
+  // type_id checks the counts first and reports -1 for unmapped terms
+  py::dict AtomStatistics(const ParamMolecule &mol) {
+    const auto &atoms = mol.GetAtoms();
+    py::dict stats;
+    stats["index"] = TermValues<int64_t>(
+        atoms, [](const ParamAtom &a) { return a.GetAtom().GetIndex(); });
+    stats["mean_charge"] = TermValues<double>(
+        atoms, [](const ParamAtom &a) { return a.MeanCharge(); });
+    stats["sd_charge"] = TermValues<double>(
+        atoms, [](const ParamAtom &a) { return a.StandardDeviationCharge(); });
+    stats["redistributed_charge"] = TermValues<double>(
+        atoms, [](const ParamAtom &a) { return a.RedistributedChargeAdded(); });
+    stats["num_sources"] = TermValues<int64_t>(
+        atoms, [](const ParamAtom &a) { return a.NumSourceAtoms(); });
+    stats["type_id"] = TermValues<int32_t>(atoms, [](const ParamAtom &a) {
+      if (a.GetMappedTypeCounts().empty()) return -1;
+      const FFAtom &t = a.GetMostCommonType();
+      return t ? t.GetID() : -1;
+    });
+    return stats;
+  }
+
+  py::dict BondStatistics(const ParamMolecule &mol) {
+    const auto &bonds = mol.GetBonds();
+    py::dict stats;
+    stats["atoms"] = TermAtoms(bonds, 2, [](const ParamBond &b) {
+      return b.GetBond().GetAtoms();
+    });
+    stats["num_sources"] = TermValues<int64_t>(
+        bonds, [](const ParamBond &b) { return b.NumSourceBonds(); });
+    stats["type_id"] = TermValues<int32_t>(bonds, [](const ParamBond &b) {
+      if (b.GetMappedTypeCounts().empty()) return -1;
+      const FFBond &t = b.GetMostCommonType();
+      return t ? t.GetID() : -1;
+    });
+    return stats;
+  }
+
+  py::dict AngleStatistics(const ParamMolecule &mol) {
+    const auto &angles = mol.GetAngles();
+    py::dict stats;
+    stats["atoms"] = TermAtoms(angles, 3, [](const ParamAngle &a) {
+      return a.GetAngle().GetAtoms();
+    });
+    stats["num_sources"] = TermValues<int64_t>(
+        angles, [](const ParamAngle &a) { return a.NumSourceAngles(); });
+    stats["type_id"] = TermValues<int32_t>(angles, [](const ParamAngle &a) {
+      if (a.GetMappedTypeCounts().empty()) return -1;
+      const FFAngle &t = a.GetMostCommonType();
+      return t ? t.GetID() : -1;
+    });
+    return stats;
+  }
+
+  // Dihedrals may be assigned several types, the first is reported
+  py::dict DihedralStatistics(const ParamMolecule &mol) {
+    const auto &dihedrals = mol.GetDihedrals();
+    py::dict stats;
+    stats["atoms"] = TermAtoms(dihedrals, 4, [](const ParamDihedral &d) {
+      return d.GetDihedral().GetAtoms();
+    });
+    stats["num_sources"] =
+        TermValues<int64_t>(dihedrals, [](const ParamDihedral &d) {
+          return d.NumSourceDihedral();
+        });
+    stats["num_types"] = TermValues<int64_t>(
+        dihedrals,
+        [](const ParamDihedral &d) -> int64_t {
+          if (d.GetMappedTypeCounts().empty()) return 0;
+          return d.GetMostCommonType().size();
+        });
+    stats["type_id"] =
+        TermValues<int32_t>(dihedrals, [](const ParamDihedral &d) {
+          if (d.GetMappedTypeCounts().empty()) return -1;
+          const auto &types = d.GetMostCommonType();
+          return types.empty() ? -1 : types.front().GetID();
+        });
+    return stats;
+  }
+} // namespace
+
 void GeneratePyParameterisedMolecule(pybind11::module &m) {
   using namespace indigox;
   py::return_value_policy Ref = py::return_value_policy::reference;
@@ -25,7 +135,8 @@ void GeneratePyParameterisedMolecule(pybind11::module &m) {
   py::class_<ParamAtom>(m, "ParamAtom")
       .def(py::init<>())
       .def("MappedWith", &ParamAtom::MappedWith)
-      .def("ApplyParameterisation", &ParamAtom::ApplyParameterisation)
+      .def("ApplyParameterisation", &ParamAtom::ApplyParameterisation,
+           py::arg("self_consistent"), py::arg("charge_rounding") = 0)
       .def("NumSourceAtoms", &ParamAtom::NumSourceAtoms)
       .def("GetAtom", &ParamAtom::GetAtom)
       .def("MeanCharge", &ParamAtom::MeanCharge)
@@ -119,7 +230,10 @@ void GeneratePyParameterisedMolecule(pybind11::module &m) {
   py::class_<ParamMolecule>(m, "ParamMolecule")
       .def(py::init<>())
       .def(py::init<Molecule &>())
+      .def(PickleSupport<ParamMolecule>())
       .def("ApplyParameterisation", &ParamMolecule::ApplyParameteristion)
+      .def("GetChargeRounding", &ParamMolecule::GetChargeRounding)
+      .def("SetChargeRounding", &ParamMolecule::SetChargeRounding)
       .def("GetAtom", &ParamMolecule::GetAtom)
       .def("GetBond",
            py::overload_cast<const Bond &>(&ParamMolecule::GetBond, py::const_))
@@ -138,7 +252,11 @@ void GeneratePyParameterisedMolecule(pybind11::module &m) {
       .def("GetAtoms", &ParamMolecule::GetAtoms, Ref)
       .def("GetBonds", &ParamMolecule::GetBonds, Ref)
       .def("GetAngles", &ParamMolecule::GetAngles, Ref)
-      .def("GetDihedrals", &ParamMolecule::GetDihedrals, Ref);
+      .def("GetDihedrals", &ParamMolecule::GetDihedrals, Ref)
+      .def("GetAtomStatistics", &AtomStatistics)
+      .def("GetBondStatistics", &BondStatistics)
+      .def("GetAngleStatistics", &AngleStatistics)
+      .def("GetDihedralStatistics", &DihedralStatistics);
 
   // container bindings
   py::bind_vector<std::vector<ParamAtom>>(m, "VecParamAtom");
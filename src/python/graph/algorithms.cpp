@@ -1,4 +1,6 @@
 #include <indigox/algorithm/cherrypicker.hpp>
+#include <indigox/algorithm/geometry.hpp>
+#include <indigox/algorithm/graph/canonical.hpp>
 #include <indigox/algorithm/graph/connectivity.hpp>
 #include <indigox/algorithm/graph/cycles.hpp>
 #include <indigox/algorithm/graph/isomorphism.hpp>
@@ -6,13 +8,18 @@
 #include <indigox/algorithm/perception.hpp>
 #include <indigox/classes/athenaeum.hpp>
 #include <indigox/classes/atom.hpp>
+#include <indigox/classes/conformers.hpp>
 #include <indigox/classes/forcefield.hpp>
 #include <indigox/classes/molecule.hpp>
 #include <indigox/classes/parameterised.hpp>
 #include <indigox/graph/condensed.hpp>
 #include <indigox/graph/molecular.hpp>
+#include <indigox/io/athenaeum_snapshot.hpp>
 #include <indigox/python/interface.hpp>
 
+#include <pybind11/numpy.h>
+
+#include <sstream>
 #include <vector>
 
 namespace py = pybind11;
@@ -95,7 +102,7 @@ void GeneratePyGraphAlgorithms(pybind11::module &m) {
         py::arg("maximum_size") = std::numeric_limits<size_t>::max());
 
   m.def("OptimalChargeGroups", &OptimalChargeGroups, py::arg("molecule"),
-        py::arg("size_limit") = 5);
+        py::arg("size_limit") = 5, ReleaseGIL());
 
   m.def("CycleBasis", [](MG &g, VVMGV &b) { return CycleBasis(g, b); });
   m.def("CycleBasis", [](MG &g, VVMGE &b) { return CycleBasis(g, b); });
@@ -104,6 +111,24 @@ void GeneratePyGraphAlgorithms(pybind11::module &m) {
   m.def("AllCycles", [](MG &g, VVMGE &c) { return AllCycles(g, c); });
   m.def("AllCycles", [](CMG &g, VVCMGE &c) { return AllCycles(g, c); });
 
+  auto hash_string = [](const GraphHash &h) {
+    std::stringstream ss;
+    ss << h;
+    return ss.str();
+  };
+  m.def("CanonicalForm", [hash_string](MG &g) {
+    MGCanonicalForm form = CanonicalForm(g);
+    return std::make_pair(form.ordering, hash_string(form.hash));
+  });
+  m.def("CanonicalForm", [hash_string](CMG &g) {
+    CMGCanonicalForm form = CanonicalForm(g);
+    return std::make_pair(form.ordering, hash_string(form.hash));
+  });
+  m.def("CanonicalHash",
+        [hash_string](MG &g) { return hash_string(CanonicalHash(g)); });
+  m.def("CanonicalHash",
+        [hash_string](CMG &g) { return hash_string(CanonicalHash(g)); });
+
   enum class IsomorphismCallbackTypes { Print };
 
   py::enum_<IsomorphismCallbackTypes>(m, "IsomorphismCallbackType")
@@ -119,27 +144,37 @@ void GeneratePyGraphAlgorithms(pybind11::module &m) {
   //  m.def("SubgraphIsomorphisms", py::overload_cast<MG&, MG&,
   //  MGCallback&>(&SubgraphIsomorphisms));
   m.def("LargestCommonSubgraph",
-        [](CMG & small, CMG & large, size_t smallest) {
+        [](CMG & small, CMG & large, size_t smallest, uint64_t nodes, double time) {
           eastl::vector_map<graph::CMGVertex, eastl::vector<std::pair<graph::CMGVertex, graph::CMGVertex>>> largest;
-          LargestCommonSubgraph(small, large, smallest, largest);
+          int status = LargestCommonSubgraph(small, large, smallest, largest,
+                                             nodes, time);
           
           std::map<CMGV, std::vector<std::pair<CMGV, CMGV>>> return_val;
           for (auto& item : largest) {
             return_val[item.first] = std::vector<std::pair<CMGV, CMGV>>(item.second.begin(), item.second.end());
           }
-          return return_val;
-        });
+          // Status is 1 if the budget ran out, so the results may not be
+          // maximal
+          return std::make_pair(status, return_val);
+        },
+        py::arg("source"), py::arg("target"), py::arg("smallest_size"),
+        py::arg("node_limit") = 0, py::arg("time_limit") = 0.0, ReleaseGIL());
   m.def("LargestCommonSubgraph",
-        [](MG & small, MG & large, size_t smallest) {
+        [](MG & small, MG & large, size_t smallest, uint64_t nodes, double time) {
           eastl::vector_map<MGV, eastl::vector<std::pair<MGV, MGV>>> largest;
-          LargestCommonSubgraph(small, large, smallest, largest);
+          int status = LargestCommonSubgraph(small, large, smallest, largest,
+                                             nodes, time);
           
           std::map<MGV, std::vector<std::pair<MGV, MGV>>> return_val;
           for (auto& item : largest) {
             return_val[item.first] = std::vector<std::pair<MGV, MGV>>(item.second.begin(), item.second.end());
           }
-          return return_val;
-        });
+          // Status is 1 if the budget ran out, so the results may not be
+          // maximal
+          return std::make_pair(status, return_val);
+        },
+        py::arg("source"), py::arg("target"), py::arg("smallest_size"),
+        py::arg("node_limit") = 0, py::arg("time_limit") = 0.0, ReleaseGIL());
 
   using CPSet = CherryPicker::Settings;
 
@@ -165,19 +200,28 @@ void GeneratePyGraphAlgorithms(pybind11::module &m) {
       .value("ParameteriseFromAllPermutations",
              CPSet::ParameteriseFromAllPermutations)
       .value("UseRISubgraphMatching", CPSet::UseRISubgraphMatching)
+      .value("UseSymmetryReduction", CPSet::UseSymmetryReduction)
       .value("CalculateElectrons", CPSet::CalculateElectrons)
       .value("NoInput", CPSet::NoInput)
       // Integer settings
       .value("MinimumFragmentSize", CPSet::MinimumFragmentSize)
       .value("MaximumFragmentSize", CPSet::MaximumFragmentSize)
       .value("ChargeRounding", CPSet::ChargeRounding)
-      .value("ElectronMethod", CPSet::ElectronMethod);
+      .value("ElectronMethod", CPSet::ElectronMethod)
+      .value("SymmetryGroupLimit", CPSet::SymmetryGroupLimit);
 
   cherrypicker.def(py::init<Forcefield &>())
-      .def("AddAthenaeum", &CherryPicker::AddAthenaeum)
-      .def("RemoveAthenaeum", &CherryPicker::RemoveAthenaeum)
+      .def("AddAthenaeum",
+           py::overload_cast<Athenaeum &>(&CherryPicker::AddAthenaeum))
+      .def("AddAthenaeum", py::overload_cast<io::AthenaeumSnapshot &>(
+                               &CherryPicker::AddAthenaeum))
+      .def("RemoveAthenaeum",
+           py::overload_cast<Athenaeum &>(&CherryPicker::RemoveAthenaeum))
+      .def("RemoveAthenaeum", py::overload_cast<io::AthenaeumSnapshot &>(
+                                  &CherryPicker::RemoveAthenaeum))
       .def("NumAthenaeums", &CherryPicker::NumAthenaeums)
-      .def("ParameteriseMolecule", &CherryPicker::ParameteriseMolecule)
+      .def("ParameteriseMolecule", &CherryPicker::ParameteriseMolecule,
+           ReleaseGIL())
       .def("GetForcefield", &CherryPicker::GetForcefield)
       .def("GetBool", &CherryPicker::GetBool)
       .def("SetBool", &CherryPicker::SetBool)
@@ -196,7 +240,10 @@ void GeneratePyGraphAlgorithms(pybind11::module &m) {
     // Integer settings
     // Real settings
   .value("MinimumDistance", PerSet::MinimumDistance)
-  .value("RadiusTolerance", PerSet::RadiusTolerance);
+  .value("RadiusTolerance", PerSet::RadiusTolerance)
+  .value("PeriodicBoxX", PerSet::PeriodicBoxX)
+  .value("PeriodicBoxY", PerSet::PeriodicBoxY)
+  .value("PeriodicBoxZ", PerSet::PeriodicBoxZ);
   
   perceptatron.def(py::init<>())
   .def("GetBool", &Perceptatron::GetBool)
@@ -205,5 +252,51 @@ void GeneratePyGraphAlgorithms(pybind11::module &m) {
   .def("SetInt", &Perceptatron::SetInt)
   .def("GetReal", &Perceptatron::GetReal)
   .def("SetReal", &Perceptatron::SetReal)
-  .def("PerceiveBonds", &Perceptatron::PerceiveBonds);
+  .def("PerceiveBonds",
+       py::overload_cast<Molecule &>(&Perceptatron::PerceiveBonds))
+  .def("PerceiveBonds", [](Perceptatron &p, Molecule &mol,
+                           const ConformerSet &set, uint32_t frame) {
+    return p.PerceiveBonds(mol, set.GetFrame(frame));
+  }, py::arg("molecule"), py::arg("conformers"), py::arg("frame"));
+
+  auto as_array = [](const std::vector<double> &v) {
+    return py::array_t<double>(v.size(), v.data());
+  };
+  py::class_<TermGeometry>(m, "TermGeometry")
+      .def_property_readonly("values", [as_array](const TermGeometry &g) {
+        return as_array(g.values);
+      })
+      .def_property_readonly("ideals", [as_array](const TermGeometry &g) {
+        return as_array(g.ideals);
+      })
+      .def_property_readonly("energies", [as_array](const TermGeometry &g) {
+        return as_array(g.energies);
+      });
+
+  m.def("MeasureBonds", py::overload_cast<Molecule &>(&MeasureBonds),
+        py::arg("molecule"), ReleaseGIL());
+  m.def("MeasureAngles", py::overload_cast<Molecule &>(&MeasureAngles),
+        py::arg("molecule"), ReleaseGIL());
+  m.def("MeasureDihedrals", py::overload_cast<Molecule &>(&MeasureDihedrals),
+        py::arg("molecule"), ReleaseGIL());
+
+  // Measure one frame of a set of conformers
+  auto frame_measure = [&m](const char *name, auto measure) {
+    m.def(name,
+          [measure](Molecule &mol, const ConformerSet &set, uint32_t frame) {
+            return measure(mol, set.GetFrame(frame));
+          },
+          py::arg("molecule"), py::arg("conformers"), py::arg("frame"),
+          ReleaseGIL());
+  };
+  frame_measure("MeasureBonds", [](Molecule &mol, const CoordinateFrame &f) {
+    return MeasureBonds(mol, f);
+  });
+  frame_measure("MeasureAngles", [](Molecule &mol, const CoordinateFrame &f) {
+    return MeasureAngles(mol, f);
+  });
+  frame_measure("MeasureDihedrals",
+                [](Molecule &mol, const CoordinateFrame &f) {
+                  return MeasureDihedrals(mol, f);
+                });
 }
@@ -10,6 +10,10 @@ PYBIND11_MODULE(pyindigox, m) {
   GeneratePyForcefield(m);
   GeneratePyAthenaeum(m);
   GeneratePyParameterisedMolecule(m);
+  GeneratePyReaders(m);
+  GeneratePyWriters(m);
+  GeneratePyArchive(m);
+  GeneratePyServer(m);
   // Graph namespace
   pybind11::module m_graph = m.def_submodule("graph");
   GeneratePyGraphs(m_graph);
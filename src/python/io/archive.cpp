@@ -0,0 +1,58 @@
+#include <indigox/classes/columnar.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/io/molecule_archive.hpp>
+#include <indigox/python/interface.hpp>
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+void GeneratePyArchive(py::module &m) {
+  using namespace indigox;
+  using namespace indigox::io;
+  // ===========================================================================
+  // == MoleculeArchive class bindings =========================================
+  // ===========================================================================
+  using Archive = MoleculeArchive;
+  py::class_<Archive>(m, "MoleculeArchive")
+      .def(py::init<const std::string &, const Forcefield &>(),
+           py::arg("path"), py::arg("ff") = Forcefield())
+      .def("NumMolecules", &Archive::NumMolecules)
+      .def("GetPath", &Archive::GetPath)
+      .def("GetForcefield", &Archive::GetForcefield)
+      .def("HasMolecule", &Archive::HasMolecule)
+      .def("GetIndex", &Archive::GetIndex)
+      .def("GetName", &Archive::GetName)
+      .def("GetColumnar",
+           py::overload_cast<uint64_t>(&Archive::GetColumnar, py::const_),
+           ReleaseGIL())
+      .def("GetColumnar",
+           py::overload_cast<const std::string &>(&Archive::GetColumnar,
+                                                  py::const_),
+           ReleaseGIL())
+      .def("GetMolecule",
+           py::overload_cast<uint64_t>(&Archive::GetMolecule, py::const_),
+           ReleaseGIL())
+      .def("GetMolecule",
+           py::overload_cast<const std::string &>(&Archive::GetMolecule,
+                                                  py::const_),
+           ReleaseGIL())
+      .def("Append",
+           py::overload_cast<const ColumnarMolecule &>(&Archive::Append),
+           ReleaseGIL())
+      .def("Append", py::overload_cast<const Molecule &>(&Archive::Append),
+           ReleaseGIL())
+      .def("Flush", &Archive::Flush, ReleaseGIL())
+      .def("__len__", &Archive::NumMolecules)
+      .def("__contains__", &Archive::HasMolecule)
+      .def("__getitem__",
+           [](const Archive &self, int64_t pos) {
+             if (pos < 0) pos += int64_t(self.NumMolecules());
+             if (pos < 0) throw py::index_error();
+             py::gil_scoped_release release;
+             return self.GetMolecule(uint64_t(pos));
+           })
+      .def("__getitem__", py::overload_cast<const std::string &>(
+                              &Archive::GetMolecule, py::const_));
+}
@@ -0,0 +1,75 @@
+#include <indigox/classes/athenaeum.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/io/athenaeum_builder.hpp>
+#include <indigox/io/readers.hpp>
+#include <indigox/io/structure_reader.hpp>
+#include <indigox/python/interface.hpp>
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+void GeneratePyReaders(py::module &m) {
+  using namespace indigox::io;
+  // ===========================================================================
+  // == Native file reader bindings ============================================
+  // ===========================================================================
+  m.def("ReadPDBFile", &ReadPDBFile, py::arg("path"), ReleaseGIL());
+  m.def("ReadIXDFile", &ReadIXDFile, py::arg("path"), py::arg("mol"),
+        ReleaseGIL());
+  m.def("ReadITPFile", &ReadITPFile, py::arg("path"), py::arg("ff"),
+        ReleaseGIL());
+  m.def("ReadMTBFile", &ReadMTBFile, py::arg("path"), py::arg("ff"),
+        ReleaseGIL());
+  m.def("ReadIFPFile", &ReadIFPFile, py::arg("path"), ReleaseGIL());
+  m.def("ReadParameterisedMolecule", &ReadParameterisedMolecule,
+        py::arg("coord_path"), py::arg("param_path"), py::arg("ff"),
+        py::arg("detail_path") = "", ReleaseGIL());
+  m.def(
+      "ReadFragmentFile",
+      [](const std::string &path, const indigox::Forcefield &ff) {
+        std::vector<indigox::Fragment> fragments;
+        indigox::Molecule mol;
+        {
+          py::gil_scoped_release release;
+          mol = ReadFragmentFile(path, ff, fragments);
+        }
+        return std::make_pair(mol, fragments);
+      },
+      py::arg("path"), py::arg("ff"));
+  m.def("BuildAthenaeums", &BuildAthenaeums, py::arg("directory"),
+        py::arg("manual"), py::arg("automatic"), py::arg("num_threads") = 0,
+        ReleaseGIL());
+
+  // ===========================================================================
+  // == StructureReader class bindings =========================================
+  // ===========================================================================
+  using Format = StructureReader::Format;
+  py::class_<StructureReader> reader(m, "StructureReader");
+  py::enum_<Format>(reader, "Format")
+      .value("SDF", Format::SDF)
+      .value("MOL2", Format::MOL2);
+  reader
+      .def(py::init<const std::string &, uint32_t, uint32_t>(),
+           py::arg("path"), py::arg("num_threads") = 0,
+           py::arg("batch_size") = 64)
+      .def(py::init<const std::string &, Format, uint32_t, uint32_t>(),
+           py::arg("path"), py::arg("format"), py::arg("num_threads") = 0,
+           py::arg("batch_size") = 64)
+      .def("NumRead", &StructureReader::NumRead)
+      .def("GetFormat", &StructureReader::GetFormat)
+      .def("__iter__",
+           [](StructureReader &self) -> StructureReader & { return self; },
+           py::return_value_policy::reference_internal)
+      .def("__next__", [](StructureReader &self) {
+        indigox::Molecule mol;
+        bool read;
+        {
+          py::gil_scoped_release release;
+          read = self.Next(mol);
+        }
+        if (!read) throw py::stop_iteration();
+        return mol;
+      });
+}
@@ -0,0 +1,40 @@
+#include <indigox/algorithm/cherrypicker.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/io/parameterisation_server.hpp>
+#include <indigox/python/interface.hpp>
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+void GeneratePyServer(py::module &m) {
+  using namespace indigox;
+  using namespace indigox::io;
+  // ===========================================================================
+  // == ParameterisationServer class bindings ==================================
+  // ===========================================================================
+  using Server = ParameterisationServer;
+  py::class_<Server>(m, "ParameterisationServer")
+      .def(py::init<const algorithm::CherryPicker &, const std::string &,
+                    uint32_t>(),
+           py::arg("picker"), py::arg("socket_path"),
+           py::arg("num_threads") = 0)
+      .def("Serve", &Server::Serve, ReleaseGIL())
+      .def("Stop", &Server::Stop)
+      .def("GetSocketPath", &Server::GetSocketPath)
+      .def("NumServed", &Server::NumServed);
+
+  // ===========================================================================
+  // == ParameterisationClient class bindings ==================================
+  // ===========================================================================
+  using Client = ParameterisationClient;
+  py::class_<Client>(m, "ParameterisationClient")
+      .def(py::init<const std::string &>(), py::arg("socket_path"),
+           ReleaseGIL())
+      .def("ParameteriseMolecule", &Client::ParameteriseMolecule,
+           ReleaseGIL())
+      .def("GetSocketPath", &Client::GetSocketPath);
+
+  m.def("ParameteriseRemote", &ParameteriseRemote, py::arg("socket_path"),
+        py::arg("mol"), ReleaseGIL());
+}
@@ -0,0 +1,22 @@
+#include <indigox/classes/molecule.hpp>
+#include <indigox/classes/parameterised.hpp>
+#include <indigox/io/writers.hpp>
+#include <indigox/python/interface.hpp>
+
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+void GeneratePyWriters(py::module &m) {
+  using namespace indigox;
+  using namespace indigox::io;
+  // ===========================================================================
+  // == Native file writer bindings ============================================
+  // ===========================================================================
+  m.def("WritePDBFile", &WritePDBFile, py::arg("path"), py::arg("mol"),
+        ReleaseGIL());
+  m.def("WriteITPFile", &WriteITPFile, py::arg("path"), py::arg("mol"),
+        py::arg("pmol") = ParamMolecule(), ReleaseGIL());
+  m.def("WriteRTPFile", &WriteRTPFile, py::arg("path"), py::arg("mol"),
+        py::arg("pmol") = ParamMolecule(), ReleaseGIL());
+}
@@ -0,0 +1,80 @@
+#include <indigox/utils/line_reader.hpp>
+
+#include <charconv>
+#include <cstdlib>
+
+namespace indigox::utils {
+
+  namespace {
+    bool IsSpace(char c) {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' ||
+             c == '\r';
+    }
+  } // namespace
+
+  LineReader::LineReader(const std::string &path) : m_file(path) {
+    m_pos = m_file.GetData();
+    m_end = m_pos + m_file.GetSize();
+  }
+
+  std::string LineReader::GetLocation() const {
+    return GetPath() + ":" + std::to_string(m_line);
+  }
+
+  std::string_view Trim(std::string_view s) {
+    size_t begin = 0, end = s.size();
+    while (begin < end && IsSpace(s[begin])) ++begin;
+    while (end > begin && IsSpace(s[end - 1])) --end;
+    return s.substr(begin, end - begin);
+  }
+
+  std::string_view StripComment(std::string_view s, char comment) {
+    size_t pos = s.find(comment);
+    return pos == std::string_view::npos ? s : s.substr(0, pos);
+  }
+
+  size_t Split(std::string_view line, std::vector<std::string_view> &tokens) {
+    tokens.clear();
+    size_t i = 0, n = line.size();
+    while (true) {
+      while (i < n && IsSpace(line[i])) ++i;
+      if (i == n) break;
+      size_t begin = i;
+      while (i < n && !IsSpace(line[i])) ++i;
+      tokens.push_back(line.substr(begin, i - begin));
+    }
+    return tokens.size();
+  }
+
+  bool ParseInt(std::string_view s, int64_t &value) {
+    s = Trim(s);
+    // from_chars accepts a leading minus but not a plus
+    if (s.size() > 1 && s[0] == '+' && s[1] != '-') s.remove_prefix(1);
+    if (s.empty()) return false;
+    auto result = std::from_chars(s.data(), s.data() + s.size(), value);
+    return result.ec == std::errc() && result.ptr == s.data() + s.size();
+  }
+
+  bool ParseReal(std::string_view s, double &value) {
+    s = Trim(s);
+    if (s.empty()) return false;
+    // strtod needs a terminated string. Fields are short, so copy onto the
+    // stack rather than allocate.
+    char buffer[64];
+    std::string long_field;
+    const char *begin = buffer;
+    if (s.size() < sizeof(buffer)) {
+      s.copy(buffer, s.size());
+      buffer[s.size()] = '\0';
+    } else {
+      long_field.assign(s);
+      begin = long_field.c_str();
+    }
+    // Hexadecimal is accepted by strtod but is not a valid number here
+    if (s.find_first_of("xX") != std::string_view::npos) return false;
+    char *end = nullptr;
+    value = std::strtod(begin, &end);
+    return end == begin + s.size();
+  }
+
+} // namespace indigox::utils
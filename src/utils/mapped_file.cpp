@@ -0,0 +1,78 @@
+#include <indigox/utils/mapped_file.hpp>
+
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define INDIGOX_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace indigox::utils {
+
+  MappedFile::MappedFile(const std::string &path) : m_path(path) {
+#ifdef INDIGOX_HAVE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Unable to open file: " + path);
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+      ::close(fd);
+      throw std::runtime_error("Unable to read file: " + path);
+    }
+    m_size = size_t(info.st_size);
+    if (m_size) {
+      void *mem = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mem == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Unable to map file: " + path);
+      }
+      m_data = static_cast<const char *>(mem);
+      m_mapped = true;
+    }
+    // The mapping holds its own reference to the file
+    ::close(fd);
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) throw std::runtime_error("Unable to open file: " + path);
+    m_size = size_t(file.tellg());
+    // Buffer of doubles so the contents are aligned for them
+    m_buffer.resize((m_size + sizeof(double) - 1) / sizeof(double));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char *>(m_buffer.data()), m_size))
+      throw std::runtime_error("Unable to read file: " + path);
+    if (m_size) m_data = reinterpret_cast<const char *>(m_buffer.data());
+#endif
+  }
+
+  MappedFile::MappedFile(MappedFile &&other) noexcept {
+    *this = std::move(other);
+  }
+
+  MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (&other == this) return *this;
+    Release();
+    m_path = std::move(other.m_path);
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    m_mapped = std::exchange(other.m_mapped, false);
+    m_buffer = std::move(other.m_buffer);
+    return *this;
+  }
+
+  MappedFile::~MappedFile() { Release(); }
+
+  void MappedFile::Release() {
+#ifdef INDIGOX_HAVE_MMAP
+    if (m_mapped) ::munmap(const_cast<char *>(m_data), m_size);
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_mapped = false;
+    m_buffer.clear();
+  }
+
+} // namespace indigox::utils
@@ -0,0 +1,119 @@
+#include <indigox/utils/common.hpp>
+#include <indigox/utils/simd.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace indigox::simd {
+
+  namespace {
+    Level CPULevel() {
+#if defined(INDIGOX_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx512f")) return Level::AVX512;
+      if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+      if (__builtin_cpu_supports("sse4.2")) return Level::SSE42;
+#endif
+      return Level::Scalar;
+    }
+
+    Level EnvironmentLevel() {
+      const char *env = std::getenv("INDIGOX_SIMD");
+      if (!env) return Level::AVX512;
+      std::string name = utils::ToLower(env);
+      if (name == "scalar") return Level::Scalar;
+      if (name == "sse4.2" || name == "sse42") return Level::SSE42;
+      if (name == "avx2") return Level::AVX2;
+      return Level::AVX512;
+    }
+
+    const Kernels &KernelsFor(Level level) {
+      switch (level) {
+#ifdef INDIGOX_SIMD_X86
+      case Level::AVX512: return AVX512Kernels();
+      case Level::AVX2: return AVX2Kernels();
+      case Level::SSE42: return SSE42Kernels();
+#endif
+      default: return ScalarKernels();
+      }
+    }
+
+    std::atomic<const Kernels *> active_kernels(nullptr);
+
+    const Kernels &Active() {
+      const Kernels *k = active_kernels.load(std::memory_order_acquire);
+      if (!k) {
+        k = &KernelsFor(DetectedLevel());
+        active_kernels.store(k, std::memory_order_release);
+      }
+      return *k;
+    }
+  } // namespace
+
+  Level DetectedLevel() {
+    static const Level level = std::min(CPULevel(), EnvironmentLevel());
+    return level;
+  }
+
+  Level ActiveLevel() { return Active().level; }
+
+  void SetLevel(Level level) {
+    if (level > DetectedLevel())
+      throw std::runtime_error("SIMD level " + LevelName(level) +
+                               " not supported on this machine");
+    active_kernels.store(&KernelsFor(level), std::memory_order_release);
+  }
+
+  std::string LevelName(Level level) {
+    switch (level) {
+    case Level::Scalar: return "scalar";
+    case Level::SSE42: return "sse4.2";
+    case Level::AVX2: return "avx2";
+    case Level::AVX512: return "avx512";
+    }
+    return "unknown";
+  }
+
+  void DistanceCheck(const double *x, const double *y, const double *z,
+                     const double *r, size_t n, const double *pos,
+                     double radius, const double *box, double *dist_sq,
+                     double *cutoff_sq) {
+    Active().distance_check(x, y, z, r, n, pos, radius, box, dist_sq,
+                            cutoff_sq);
+  }
+
+  void Lengths(Points a, Points b, size_t n, double *out) {
+    Active().lengths(a, b, n, out);
+  }
+
+  void AngleComponents(Points a, Points b, Points c, size_t n, double *dot,
+                       double *cross) {
+    Active().angle_components(a, b, c, n, dot, cross);
+  }
+
+  void TorsionComponents(Points a, Points b, Points c, Points d, size_t n,
+                         double *x, double *y) {
+    Active().torsion_components(a, b, c, d, n, x, y);
+  }
+
+  void HarmonicEnergies(const double *value, const double *ideal,
+                        const double *k, size_t n, double *out) {
+    Active().harmonic_energies(value, ideal, k, n, out);
+  }
+
+  void QuarticEnergies(const double *value, const double *ideal,
+                       const double *k, size_t n, double *out) {
+    Active().quartic_energies(value, ideal, k, n, out);
+  }
+
+  double Sum(const double *values, size_t n) {
+    return Active().sum(values, n);
+  }
+
+  double SumSquaredDeviations(const double *values, size_t n, double mean) {
+    return Active().sum_squared_deviations(values, n, mean);
+  }
+
+} // namespace indigox::simd
@@ -0,0 +1,37 @@
+// Compiled with -mavx2
+#include <indigox/utils/simd_kernels.hpp>
+
+#include <immintrin.h>
+
+namespace indigox::simd {
+  namespace {
+    struct AVX2Batch {
+      using reg = __m256d;
+      static constexpr size_t width = 4;
+      static reg load(const double *p) { return _mm256_loadu_pd(p); }
+      static void store(double *p, reg v) { _mm256_storeu_pd(p, v); }
+      static reg set1(double v) { return _mm256_set1_pd(v); }
+      static reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+      static reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+      static reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+      static reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+      static reg sqrt(reg a) { return _mm256_sqrt_pd(a); }
+      static reg round(reg a) {
+        return _mm256_round_pd(a,
+                               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+      }
+      static double hsum(reg a) {
+        __m128d lo = _mm256_castpd256_pd128(a);
+        __m128d hi = _mm256_extractf128_pd(a, 1);
+        lo = _mm_add_pd(lo, hi);
+        return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+      }
+    };
+  } // namespace
+
+  const Kernels &AVX2Kernels() {
+    static const Kernels kernels = MakeKernels<AVX2Batch>(Level::AVX2);
+    return kernels;
+  }
+
+} // namespace indigox::simd
@@ -0,0 +1,39 @@
+// Compiled with -mavx512f
+#include <indigox/utils/simd_kernels.hpp>
+
+#include <immintrin.h>
+
+namespace indigox::simd {
+  namespace {
+    struct AVX512Batch {
+      using reg = __m512d;
+      static constexpr size_t width = 8;
+      static reg load(const double *p) { return _mm512_loadu_pd(p); }
+      static void store(double *p, reg v) { _mm512_storeu_pd(p, v); }
+      static reg set1(double v) { return _mm512_set1_pd(v); }
+      static reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+      static reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+      static reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+      static reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+      static reg sqrt(reg a) { return _mm512_sqrt_pd(a); }
+      // Masked forms avoid the undefined source operand of the unmasked
+      // intrinsics, which GCC warns about.
+      static reg round(reg a) {
+        return _mm512_mask_roundscale_pd(
+            a, 0xFF, a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+      }
+      static double hsum(reg a) {
+        double v[8];
+        _mm512_storeu_pd(v, a);
+        return ((v[0] + v[1]) + (v[2] + v[3])) +
+               ((v[4] + v[5]) + (v[6] + v[7]));
+      }
+    };
+  } // namespace
+
+  const Kernels &AVX512Kernels() {
+    static const Kernels kernels = MakeKernels<AVX512Batch>(Level::AVX512);
+    return kernels;
+  }
+
+} // namespace indigox::simd
@@ -0,0 +1,10 @@
+#include <indigox/utils/simd_kernels.hpp>
+
+namespace indigox::simd {
+
+  const Kernels &ScalarKernels() {
+    static const Kernels kernels = MakeKernels<ScalarBatch>(Level::Scalar);
+    return kernels;
+  }
+
+} // namespace indigox::simd
@@ -0,0 +1,33 @@
+// Compiled with -msse4.2
+#include <indigox/utils/simd_kernels.hpp>
+
+#include <immintrin.h>
+
+namespace indigox::simd {
+  namespace {
+    struct SSE42Batch {
+      using reg = __m128d;
+      static constexpr size_t width = 2;
+      static reg load(const double *p) { return _mm_loadu_pd(p); }
+      static void store(double *p, reg v) { _mm_storeu_pd(p, v); }
+      static reg set1(double v) { return _mm_set1_pd(v); }
+      static reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+      static reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+      static reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+      static reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+      static reg sqrt(reg a) { return _mm_sqrt_pd(a); }
+      static reg round(reg a) {
+        return _mm_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+      }
+      static double hsum(reg a) {
+        return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a)));
+      }
+    };
+  } // namespace
+
+  const Kernels &SSE42Kernels() {
+    static const Kernels kernels = MakeKernels<SSE42Batch>(Level::SSE42);
+    return kernels;
+  }
+
+} // namespace indigox::simd
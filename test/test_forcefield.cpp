@@ -0,0 +1,54 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+// The bundled doctest sizes its signal stack with SIGSTKSZ, which is no
+// longer a constant in newer glibc
+#define DOCTEST_CONFIG_NO_POSIX_SIGNALS
+#include <doctest.h>
+
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/periodictable.hpp>
+
+#include <cstdio>
+#include <string>
+
+namespace {
+  indigox::Forcefield SmallForcefield() {
+    using namespace indigox;
+    Forcefield ff(FFFamily::GROMOS, "registry-test");
+    ff.NewAtomType(1, "CX", GetPeriodicTable()["C"]);
+    ff.NewAtomType(2, "HX", GetPeriodicTable()["H"]);
+    return ff;
+  }
+} // namespace
+
+TEST_CASE("Shared forcefields are released once unused") {
+  using namespace indigox;
+  Forcefield ff = SmallForcefield().Share();
+  FFAtom type = ff.GetAtomType(1);
+  REQUIRE(ff.IsShared());
+  CHECK(type.GetForcefield() == ff);
+
+  // Types refer to their forcefield weakly, so do not keep it alive
+  ff = Forcefield();
+  CHECK_FALSE(type.GetForcefield());
+
+  // The registry entry has expired, so an equal forcefield is registered
+  // itself rather than resolving to the released one
+  Forcefield again = SmallForcefield();
+  CHECK(again.Share().IsShared());
+  CHECK(again.IsShared());
+}
+
+TEST_CASE("Opened forcefields release the loaded copy") {
+  using namespace indigox;
+  std::string path = "test_forcefield_registry.ff";
+  SmallForcefield().Save(path);
+  FFAtom type;
+  {
+    Forcefield opened = Forcefield::Open(path);
+    REQUIRE(opened.IsShared());
+    type = opened.GetAtomType(2);
+    CHECK(type.GetForcefield() == opened);
+  }
+  std::remove(path.c_str());
+  CHECK_FALSE(type.GetForcefield());
+}
@@ -0,0 +1,125 @@
+//
+// Builds the manual and automatic Athenaeums from a directory of fragment
+// files, as LoadAndSaveAthenaeums in the CherryPicker Python example does,
+// without needing a Python interpreter and using every core.
+//
+// Usage: build_athenaeums SOURCE_DIR FORCEFIELD [options]
+//   FORCEFIELD is GROMOS54A7, a GROMOS .ifp file or a compact forcefield file
+//   --manual PATH       output of the manual Athenaeum (ManualAthenaeum.ath)
+//   --automatic PATH    output of the automatic Athenaeum
+//                       (AutomaticAthenaeum.ath)
+//   --overlap N         overlap length of automatic fragments (1)
+//   --size-limit N      largest molecule to fragment automatically (60)
+//   --threads N         number of worker threads, 0 for one per core (0)
+//   --snapshot          also save a snapshot of each Athenaeum, for mapping
+//                       by indigox-cli and indigox-server, at its output
+//                       path with .snap appended
+//   --no-manual, --no-automatic  skip building one of the Athenaeums
+//
+
+#include <indigox/classes/athenaeum.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/io/athenaeum_builder.hpp>
+#include <indigox/io/athenaeum_snapshot.hpp>
+#include <indigox/io/readers.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+  void Usage() {
+    std::cerr << "Usage: build_athenaeums SOURCE_DIR FORCEFIELD [--manual PATH]"
+                 " [--automatic PATH]\n"
+                 "         [--overlap N] [--size-limit N] [--threads N]"
+                 " [--no-manual] [--no-automatic]\n"
+                 "         [--snapshot]\n";
+  }
+
+  indigox::Forcefield GetForcefield(const std::string &name) {
+    if (name == "GROMOS54A7" || name == "54A7")
+      return indigox::GenerateGROMOS54A7();
+    if (name.size() > 4 && name.compare(name.size() - 4, 4, ".ifp") == 0)
+      return indigox::io::ReadIFPFile(name).Share();
+    return indigox::Forcefield::Open(name);
+  }
+} // namespace
+
+int main(int argc, char **argv) {
+  using namespace indigox;
+  using settings = Athenaeum::Settings;
+
+  if (argc < 3) {
+    Usage();
+    return EXIT_FAILURE;
+  }
+  std::string source_dir = argv[1];
+  std::string ff_name = argv[2];
+  std::string manual_path = "ManualAthenaeum.ath";
+  std::string automatic_path = "AutomaticAthenaeum.ath";
+  int32_t overlap = 1, size_limit = 60;
+  uint32_t num_threads = 0;
+  bool build_manual = true, build_automatic = true, snapshot = false;
+
+  try {
+    for (int i = 3; i < argc; ++i) {
+      std::string arg = argv[i];
+      auto value = [&]() -> std::string {
+        if (++i == argc) throw std::invalid_argument("Missing value of " + arg);
+        return argv[i];
+      };
+      if (arg == "--manual") manual_path = value();
+      else if (arg == "--automatic") automatic_path = value();
+      else if (arg == "--overlap") overlap = std::stoi(value());
+      else if (arg == "--size-limit") size_limit = std::stoi(value());
+      else if (arg == "--threads") num_threads = std::stoul(value());
+      else if (arg == "--no-manual") build_manual = false;
+      else if (arg == "--no-automatic") build_automatic = false;
+      else if (arg == "--snapshot") snapshot = true;
+      else throw std::invalid_argument("Unknown option " + arg);
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    Usage();
+    return EXIT_FAILURE;
+  }
+
+  try {
+    auto start = std::chrono::steady_clock::now();
+    Forcefield ff = GetForcefield(ff_name);
+
+    // Settings as used for the CherryPicker paper
+    Athenaeum manual, automatic;
+    if (build_manual) {
+      manual = Athenaeum(ff);
+      manual.SetBool(settings::SelfConsistent);
+    }
+    if (build_automatic) {
+      automatic = Athenaeum(ff, overlap);
+      automatic.SetInt(settings::MoleculeSizeLimit, size_limit);
+    }
+
+    size_t count =
+        io::BuildAthenaeums(source_dir, manual, automatic, num_threads);
+    std::cout << "Read " << count << " molecules from " << source_dir << "\n";
+    auto save = [snapshot](Athenaeum &ath, const std::string &path) {
+      SaveAthenaeum(ath, path);
+      std::cout << "Saved " << ath.NumFragments() << " fragments to " << path
+                << "\n";
+      if (!snapshot) return;
+      io::SaveAthenaeumSnapshot(ath, path + ".snap");
+      std::cout << "Saved snapshot to " << path << ".snap\n";
+    };
+    if (manual) save(manual, manual_path);
+    if (automatic) save(automatic, automatic_path);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << "Built in " << elapsed.count() << " s\n";
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
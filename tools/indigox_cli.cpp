@@ -0,0 +1,335 @@
+//
+// Parameterises many molecules with CherryPicker in one run. The Athenaeums
+// are loaded, or snapshots of them mapped, once and shared by worker
+// threads, each of which parameterises one molecule at a time and writes its
+// ITP and RTP files. Alternatively the
+// molecules are sent to an indigox-server, so that many processes share the
+// Athenaeums it has loaded.
+//
+// Usage: indigox-cli -a ATHENAEUM [-a ATHENAEUM ...] [options] INPUT...
+//        indigox-cli --server SOCKET [options] INPUT...
+//   INPUT is a PDB file, with formal charges and bond orders from an IXD file
+//   of the same name if there is one, an SDF or MOL2 file of any number of
+//   molecules, or a binary molecule saved by SaveMolecule
+//   -a, --athenaeum PATH  Athenaeum or Athenaeum snapshot to parameterise
+//                         from, in order of use
+//   --server SOCKET       parameterise with the indigox-server on SOCKET,
+//                         using its Athenaeums and settings
+//   -o, --output DIR      directory of the ITP and RTP files (.)
+//   --min-fragment N      smallest fragment to match (4)
+//   --max-fragment N      largest fragment to match, -1 for no limit (-1)
+//   --electrons           perceive formal charges and bond orders first
+//   --all-permutations    parameterise from every permutation of a match
+//   --threads N           number of worker threads, 0 for one per core (0)
+//   --no-itp, --no-rtp    skip writing one of the output files
+//
+
+#include <indigox/algorithm/cherrypicker.hpp>
+#include <indigox/classes/athenaeum.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/classes/molecule.hpp>
+#include <indigox/classes/parameterised.hpp>
+#include <indigox/io/athenaeum_snapshot.hpp>
+#include <indigox/io/parameterisation_server.hpp>
+#include <indigox/io/readers.hpp>
+#include <indigox/io/structure_reader.hpp>
+#include <indigox/io/writers.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+  void Usage() {
+    std::cerr << "Usage: indigox-cli -a ATHENAEUM [-a ATHENAEUM ...]"
+                 " [-o DIR] [--min-fragment N]\n"
+                 "         [--max-fragment N] [--electrons]"
+                 " [--all-permutations] [--threads N]\n"
+                 "         [--no-itp] [--no-rtp] INPUT...\n"
+                 "       indigox-cli --server SOCKET [-o DIR] [--threads N]"
+                 " [--no-itp] [--no-rtp]\n"
+                 "         INPUT...\n";
+  }
+
+  bool IsStructureFile(const std::string &ext) {
+    return ext == ".sdf" || ext == ".sd" || ext == ".mol" || ext == ".mol2";
+  }
+
+  // Hands out molecules from the inputs in order, one at a time, to the
+  // worker threads. Each molecule is given a unique name for its output
+  // files.
+  class InputQueue {
+  public:
+    explicit InputQueue(const std::vector<std::string> &paths)
+        : _paths(paths), _next(0), _record(0) {}
+
+    // Get the next molecule and its output name. Returns false when the
+    // inputs are exhausted. A molecule which cannot be read throws, with
+    // its name set so that it can be reported.
+    bool Next(indigox::Molecule &mol, std::string &name) {
+      std::lock_guard<std::mutex> lock(_mutex);
+      while (true) {
+        if (_reader) {
+          ++_record;
+          name = _stem + "_" + std::to_string(_record);
+          try {
+            if (_reader.Next(mol)) {
+              name = Unique(mol.GetName().empty() ? name : mol.GetName());
+              return true;
+            }
+          } catch (const std::exception &) {
+            name = Unique(name);
+            throw;
+          }
+          _reader = indigox::io::StructureReader();
+          continue;
+        }
+        if (_next == _paths.size()) return false;
+
+        std::string path = _paths[_next++];
+        fs::path p(path);
+        std::string ext = p.extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        name = Unique(p.stem().string());
+        if (IsStructureFile(ext)) {
+          _stem = p.stem().string();
+          _record = 0;
+          // The workers already occupy every core
+          _reader = indigox::io::StructureReader(path, 1);
+          continue;
+        }
+        if (ext == ".pdb") {
+          mol = indigox::io::ReadPDBFile(path);
+          fs::path ixd = p.replace_extension(".ixd");
+          if (fs::exists(ixd)) indigox::io::ReadIXDFile(ixd.string(), mol);
+        } else {
+          mol = indigox::LoadMolecule(path);
+        }
+        return true;
+      }
+    }
+
+  private:
+    std::string Unique(std::string name) {
+      for (char &c : name) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' &&
+            c != '_' && c != '.')
+          c = '_';
+      }
+      std::string unique = name;
+      for (int i = 2; !_used.insert(unique).second; ++i)
+        unique = name + "_" + std::to_string(i);
+      return unique;
+    }
+
+    std::mutex _mutex;
+    std::vector<std::string> _paths;
+    size_t _next;
+    indigox::io::StructureReader _reader;
+    std::string _stem;
+    uint64_t _record;
+    std::set<std::string> _used;
+  };
+} // namespace
+
+int main(int argc, char **argv) {
+  using namespace indigox;
+  using settings = algorithm::CherryPicker::Settings;
+
+  std::vector<std::string> athenaeum_paths, inputs;
+  std::string output_dir = ".", server_path;
+  int32_t min_fragment = 4, max_fragment = -1;
+  bool electrons = false, all_permutations = false, picker_options = false;
+  bool write_itp = true, write_rtp = true;
+  uint32_t num_threads = 0;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      auto value = [&]() -> std::string {
+        if (++i == argc) throw std::invalid_argument("Missing value of " + arg);
+        return argv[i];
+      };
+      if (arg == "-a" || arg == "--athenaeum")
+        athenaeum_paths.push_back(value());
+      else if (arg == "--server") server_path = value();
+      else if (arg == "-o" || arg == "--output") output_dir = value();
+      else if (arg == "--min-fragment") min_fragment = std::stoi(value());
+      else if (arg == "--max-fragment") max_fragment = std::stoi(value());
+      else if (arg == "--electrons") electrons = true;
+      else if (arg == "--all-permutations") all_permutations = true;
+      else if (arg == "--threads") num_threads = std::stoul(value());
+      else if (arg == "--no-itp") write_itp = false;
+      else if (arg == "--no-rtp") write_rtp = false;
+      else if (arg.size() > 1 && arg[0] == '-')
+        throw std::invalid_argument("Unknown option " + arg);
+      else inputs.push_back(arg);
+      if (arg == "--min-fragment" || arg == "--max-fragment" ||
+          arg == "--electrons" || arg == "--all-permutations")
+        picker_options = true;
+    }
+    if (server_path.empty() && athenaeum_paths.empty())
+      throw std::invalid_argument("No Athenaeums or server given");
+    if (!server_path.empty() && !athenaeum_paths.empty())
+      throw std::invalid_argument("Athenaeums are loaded by the server");
+    if (!server_path.empty() && picker_options)
+      throw std::invalid_argument("CherryPicker settings are the server's");
+    if (inputs.empty()) throw std::invalid_argument("No inputs given");
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    Usage();
+    return EXIT_FAILURE;
+  }
+
+  if (!num_threads) num_threads = std::thread::hardware_concurrency();
+  if (!num_threads) num_threads = 1;
+
+  auto start = std::chrono::steady_clock::now();
+  auto elapsed = [](std::chrono::steady_clock::time_point since) {
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - since;
+    return d.count();
+  };
+
+  // Load the Athenaeums once, into a CherryPicker each worker copies, or
+  // connect each worker to the server
+  std::vector<Athenaeum> athenaeums;
+  std::vector<io::AthenaeumSnapshot> snapshots;
+  std::vector<algorithm::CherryPicker> pickers;
+  std::vector<io::ParameterisationClient> clients;
+  try {
+    fs::create_directories(output_dir);
+    if (!server_path.empty()) {
+      for (uint32_t i = 0; i < num_threads; ++i)
+        clients.emplace_back(server_path);
+      std::cout << "Connected to " << server_path << "\n";
+    }
+    // Snapshots are mapped rather than loaded, and their molecules loaded
+    // only when matched
+    Forcefield ff;
+    for (std::string &path : athenaeum_paths) {
+      if (io::IsAthenaeumSnapshot(path)) {
+        snapshots.emplace_back(path);
+        athenaeums.emplace_back();
+        if (!ff) ff = snapshots.back().GetForcefield();
+        std::cout << "Mapped " << snapshots.back().NumFragments()
+                  << " fragments from " << path << "\n";
+      } else {
+        athenaeums.push_back(LoadAthenaeum(path));
+        snapshots.emplace_back();
+        if (!ff) ff = athenaeums.back().GetForcefield();
+        std::cout << "Loaded " << athenaeums.back().NumFragments()
+                  << " fragments from " << path << "\n";
+      }
+    }
+    if (!athenaeum_paths.empty()) {
+      algorithm::CherryPicker picker(ff);
+      for (size_t i = 0; i < athenaeum_paths.size(); ++i) {
+        bool added = snapshots[i] ? picker.AddAthenaeum(snapshots[i])
+                                  : picker.AddAthenaeum(athenaeums[i]);
+        if (!added)
+          throw std::runtime_error(athenaeum_paths[i] +
+                                   " has a different forcefield to " +
+                                   athenaeum_paths.front());
+      }
+      picker.SetInt(settings::MinimumFragmentSize, min_fragment);
+      picker.SetInt(settings::MaximumFragmentSize, max_fragment);
+      if (electrons) picker.SetBool(settings::CalculateElectrons);
+      if (all_permutations)
+        picker.SetBool(settings::ParameteriseFromAllPermutations);
+      pickers.assign(num_threads, picker);
+      std::cout << "Loaded Athenaeums in " << elapsed(start) << " s\n";
+    }
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  InputQueue queue(inputs);
+  std::mutex report_mutex;
+  std::atomic<uint64_t> done(0), failed(0);
+  std::vector<std::pair<std::string, double>> timings;
+
+  auto report = [&](const std::string &line) {
+    std::lock_guard<std::mutex> lock(report_mutex);
+    std::cout << line << std::endl;
+  };
+
+  auto work = [&](uint32_t worker) {
+    while (true) {
+      Molecule mol;
+      std::string name;
+      try {
+        if (!queue.Next(mol, name)) return;
+      } catch (const std::exception &e) {
+        ++failed;
+        report(name + ": not read: " + e.what());
+        continue;
+      }
+
+      auto mol_start = std::chrono::steady_clock::now();
+      std::ostringstream line;
+      line << std::fixed << std::setprecision(3);
+      try {
+        // The server applies the parameters to a copy of the molecule, and
+        // its ParamMolecule is not sent back
+        ParamMolecule pmol;
+        if (clients.empty())
+          pmol = pickers[worker].ParameteriseMolecule(mol);
+        else
+          mol = clients[worker].ParameteriseMolecule(mol);
+        double seconds = elapsed(mol_start);
+        std::string base = (fs::path(output_dir) / name).string();
+        if (write_itp) io::WriteITPFile(base + ".itp", mol, pmol);
+        if (write_rtp) io::WriteRTPFile(base + ".rtp", mol, pmol);
+        ++done;
+        line << name << ": " << mol.NumAtoms() << " atoms parameterised in "
+             << seconds << " s";
+        std::lock_guard<std::mutex> lock(report_mutex);
+        timings.emplace_back(name, seconds);
+      } catch (const std::exception &e) {
+        ++failed;
+        line << name << ": failed after " << elapsed(mol_start)
+             << " s: " << e.what();
+      }
+      report(line.str());
+    }
+  };
+
+  auto run_start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (uint32_t i = 1; i < num_threads; ++i)
+    workers.emplace_back(work, i);
+  work(0);
+  for (std::thread &worker : workers) worker.join();
+  double run_seconds = elapsed(run_start);
+
+  // Timings sorted by name are easier to compare between runs
+  std::sort(timings.begin(), timings.end());
+  std::cout << "\nMolecule timings (s):\n"
+            << std::fixed << std::setprecision(3);
+  double total = 0.;
+  for (auto &timing : timings) {
+    std::cout << "  " << std::left << std::setw(32) << timing.first << " "
+              << std::right << std::setw(10) << timing.second << "\n";
+    total += timing.second;
+  }
+  std::cout << "Parameterised " << done << " molecules";
+  if (failed) std::cout << ", " << failed << " failed";
+  std::cout << ", in " << run_seconds << " s on " << num_threads
+            << " threads (" << total << " s of parameterisation)\n";
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+//
+// Keeps Athenaeums loaded and parameterises molecules sent to it over a Unix
+// socket, so that jobs parameterising a few molecules need not load the
+// Athenaeums themselves, and worker processes on a node share one copy of
+// them. Molecules are sent with io::ParameterisationClient, the indigox-cli
+// --server option, or indigox.ParameterisationClient from Python. Stops on
+// SIGINT or SIGTERM.
+//
+// Usage: indigox-server -a ATHENAEUM [-a ATHENAEUM ...] [options] SOCKET
+//   -a, --athenaeum PATH  Athenaeum or Athenaeum snapshot to parameterise
+//                         from, in order of use
+//   --min-fragment N      smallest fragment to match (4)
+//   --max-fragment N      largest fragment to match, -1 for no limit (-1)
+//   --electrons           perceive formal charges and bond orders first
+//   --all-permutations    parameterise from every permutation of a match
+//   --threads N           number of worker threads, 0 for one per core (0)
+//
+
+#include <indigox/algorithm/cherrypicker.hpp>
+#include <indigox/classes/athenaeum.hpp>
+#include <indigox/classes/forcefield.hpp>
+#include <indigox/io/athenaeum_snapshot.hpp>
+#include <indigox/io/parameterisation_server.hpp>
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+
+namespace {
+  void Usage() {
+    std::cerr << "Usage: indigox-server -a ATHENAEUM [-a ATHENAEUM ...]"
+                 " [--min-fragment N]\n"
+                 "         [--max-fragment N] [--electrons]"
+                 " [--all-permutations] [--threads N]\n"
+                 "         SOCKET\n";
+  }
+} // namespace
+
+int main(int argc, char **argv) {
+  using namespace indigox;
+  using settings = algorithm::CherryPicker::Settings;
+
+  std::vector<std::string> athenaeum_paths;
+  std::string socket_path;
+  int32_t min_fragment = 4, max_fragment = -1;
+  bool electrons = false, all_permutations = false;
+  uint32_t num_threads = 0;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      auto value = [&]() -> std::string {
+        if (++i == argc) throw std::invalid_argument("Missing value of " + arg);
+        return argv[i];
+      };
+      if (arg == "-a" || arg == "--athenaeum")
+        athenaeum_paths.push_back(value());
+      else if (arg == "--min-fragment") min_fragment = std::stoi(value());
+      else if (arg == "--max-fragment") max_fragment = std::stoi(value());
+      else if (arg == "--electrons") electrons = true;
+      else if (arg == "--all-permutations") all_permutations = true;
+      else if (arg == "--threads") num_threads = std::stoul(value());
+      else if (arg.size() > 1 && arg[0] == '-')
+        throw std::invalid_argument("Unknown option " + arg);
+      else if (socket_path.empty()) socket_path = arg;
+      else throw std::invalid_argument("Unexpected argument " + arg);
+    }
+    if (athenaeum_paths.empty())
+      throw std::invalid_argument("No Athenaeums given");
+    if (socket_path.empty()) throw std::invalid_argument("No socket given");
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << "\n";
+    Usage();
+    return EXIT_FAILURE;
+  }
+
+  // Signals are taken by a thread of their own rather than a handler, as
+  // stopping the server is not async signal safe. They are blocked before
+  // any other thread starts so that every thread inherits the mask.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  io::ParameterisationServer server;
+  try {
+    auto start = std::chrono::steady_clock::now();
+    // Snapshots are mapped rather than loaded, and their molecules loaded
+    // only when matched
+    std::vector<Athenaeum> athenaeums;
+    std::vector<io::AthenaeumSnapshot> snapshots;
+    Forcefield ff;
+    for (std::string &path : athenaeum_paths) {
+      if (io::IsAthenaeumSnapshot(path)) {
+        snapshots.emplace_back(path);
+        athenaeums.emplace_back();
+        if (!ff) ff = snapshots.back().GetForcefield();
+        std::cout << "Mapped " << snapshots.back().NumFragments()
+                  << " fragments from " << path << "\n";
+      } else {
+        athenaeums.push_back(LoadAthenaeum(path));
+        snapshots.emplace_back();
+        if (!ff) ff = athenaeums.back().GetForcefield();
+        std::cout << "Loaded " << athenaeums.back().NumFragments()
+                  << " fragments from " << path << "\n";
+      }
+    }
+    algorithm::CherryPicker picker(ff);
+    for (size_t i = 0; i < athenaeum_paths.size(); ++i) {
+      bool added = snapshots[i] ? picker.AddAthenaeum(snapshots[i])
+                                : picker.AddAthenaeum(athenaeums[i]);
+      if (!added)
+        throw std::runtime_error(athenaeum_paths[i] +
+                                 " has a different forcefield to " +
+                                 athenaeum_paths.front());
+    }
+    picker.SetInt(settings::MinimumFragmentSize, min_fragment);
+    picker.SetInt(settings::MaximumFragmentSize, max_fragment);
+    if (electrons) picker.SetBool(settings::CalculateElectrons);
+    if (all_permutations)
+      picker.SetBool(settings::ParameteriseFromAllPermutations);
+
+    server = io::ParameterisationServer(picker, socket_path, num_threads);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::cout << "Loaded Athenaeums in " << elapsed.count() << " s\n"
+              << "Listening on " << socket_path << std::endl;
+  } catch (const std::exception &e) {
+    std::cerr << "Error: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  std::thread waiter([&signals, server]() mutable {
+    int signal = 0;
+    sigwait(&signals, &signal);
+    server.Stop();
+  });
+  server.Serve();
+
+  // Serve only returns once stopped, so the waiter has finished
+  waiter.join();
+  std::cout << "Answered " << server.NumServed() << " requests" << std::endl;
+  return EXIT_SUCCESS;
+}